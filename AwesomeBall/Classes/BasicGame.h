@@ -26,10 +26,37 @@
 #import "GameType.h"
 #import "ode.h"
 #import <OpenGLES/ES1/gl.h>
+#import <pthread.h>
 
 
 @class GLView, GLBall, SoundEffect, BallTypes, GLWalls;
 
+// What the physics thread needs for one frame's worth of steps. Sampled on the main thread at the frame
+// boundary, so the trajectory only depends on these and not on when the thread gets to run.
+typedef struct {
+	int numSteps;
+	UIAccelerationValue accLP[3]; // Accelerometer with low-pass filter (gravity)
+	UIAccelerationValue accHP[3]; // Accelerometer with high-pass filter (shaking)
+	dVector3 torque; // Torque from swipes since the last frame
+} PhysicsFrameInput;
+
+// Ball state for drawing one frame: the states before and after the last physics step and how far to blend
+typedef struct {
+	dVector3 prevPos;
+	dQuaternion prevQuat;
+	dVector3 pos;
+	dQuaternion quat;
+	dReal alpha;
+} BallSnapshot;
+
+// A collision the physics thread found, for playing its sound on the main thread
+typedef struct {
+	float speed;
+	float angle;
+} CollisionSound;
+
+#define MAX_COLLISION_SOUNDS 8
+
 @interface BasicGame : NSObject <GameType, UIAccelerometerDelegate> {
 
 	GLView * glView;	
@@ -40,6 +67,8 @@
 	dWorldID m_world;
 	dSpaceID m_space;
 	dJointGroupID m_contactGroup;
+	dContactBatchID m_contactBatch; // Contacts found by the last collision pass
+	dMaterialTableID m_materials; // Surface parameters for the contacts
 	
 	// Ball
 	BallTypes * ballTypes;
@@ -54,6 +83,26 @@
 	GLWalls * m_walls;
 	dGeomID m_wallGeoms[6];
 	
+	// Fixed timestep
+	CFTimeInterval m_lastFrameTime; // Wall-clock time of the last physicsTimeStep (0 before the first one)
+	CFTimeInterval m_timeAccumulator; // Wall-clock time that hasn't been simulated yet
+	
+	// Physics thread
+	// The ODE objects belong to the physics thread while it is running a frame. The main thread only
+	// touches them after waitForPhysics.
+	pthread_t m_physicsThread;
+	pthread_mutex_t m_physicsMutex;
+	pthread_cond_t m_physicsCondition;
+	BOOL m_physicsFrameRunning; // Set by the main thread to hand a frame over, cleared by the physics thread
+	BOOL m_physicsFramePending; // A frame was handed over that hasn't been picked up by the main thread yet
+	BOOL m_physicsThreadShouldExit;
+	PhysicsFrameInput m_frameInput; // Input of the frame being simulated
+	dVector3 m_pendingTorque; // Torque from swipes for the next frame
+	BallSnapshot m_ballSnapshots[2]; // Drawn from the front one while the physics thread fills the other
+	int m_frontSnapshot;
+	CollisionSound m_collisionSounds[MAX_COLLISION_SOUNDS]; // Found by the physics thread in the last frame
+	int m_numCollisionSounds;
+	
 	// Camera
 	BOOL cameraFollowsBall;
 	GLfloat m_cameraX;
@@ -62,6 +111,7 @@
 	GLfloat m_cameraX_offset;
 	GLfloat m_cameraY_offset;
 	GLfloat m_cameraZ_zoom;
+	GLfloat m_viewportHeight; // In pixels, for picking the ball's level of detail
 
 	
 	
@@ -99,7 +149,6 @@
 
 
 - (id) initWithGLView: (GLView *) view;
-- (void) callBack: (void *) data id1: (dGeomID) o1 id2: (dGeomID) o2;
 - (void) setBallTypeIndex: (unsigned) index reloadCustomImage: (BOOL) loadCustomBallImage;
 - (void) setBallTypeIndex: (unsigned) index;
 - (void) setBallSize:(float)radius andBounce:(float)bounce andMass:(float)mass;
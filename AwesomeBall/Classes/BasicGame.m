@@ -26,8 +26,10 @@
 #import "GLView.h"
 #import "ode.h"
 #import "UserDefaults.h"
+#import <QuartzCore/QuartzCore.h>
 #import "GLBall.h"
 #import "glUtil.h"
+#import "ball_mesh.h"
 #import "SoundEffect.h"
 #import "GLWalls.h"
 #import "TextureLoader.h"
@@ -50,6 +52,13 @@
 
 #define GLOBAL_CFM .2
 
+// The physics runs in fixed steps of PHYSICS_STEP_SIZE (simulated time) for every PHYSICS_STEP_INTERVAL of
+// wall-clock time, independent of the frame rate. The step size was tuned for one step per frame at 60 fps.
+#define PHYSICS_STEP_SIZE .15
+#define PHYSICS_STEP_INTERVAL (1.0 / 60.0)
+// Most steps to take in one frame. Time beyond that is dropped (the game slows down instead of stalling)
+#define MAX_PHYSICS_STEPS_PER_FRAME 4
+
 #define DEGREES_TO_RADIANS(__ANGLE__) ((__ANGLE__) / 180.0 * M_PI)
 #define RADIANS_TO_DEGREES(__ANGLE__) ((__ANGLE__) / M_PI * 180.0)
 
@@ -93,16 +102,30 @@ typedef enum kWalIDEnum {
 	kWalIDCeiling
 } kWallID;
 
-// This is an array of contacts that are created when objects collide
-static dContact contact_array[MAX_CONTACTS];
-
-static BasicGame * singleton;
+// Enum for the materials of the geoms, which pick the surface parameters of their contacts
+typedef enum kMaterialIDEnum {
+	kMaterialIDWall,
+	kMaterialIDBall,
+	kNumMaterials
+} kMaterialID;
 
 // A class extension to declare private methods and variables
 @interface BasicGame ()
 
 - (void) resetZoomDistance;
 - (void) applyTorque;
+- (void) startPhysicsThread;
+- (void) stopPhysicsThread;
+- (void) physicsThreadLoop;
+- (void) waitForPhysics;
+- (void) simulateFrame;
+- (void) stepPhysics;
+- (void) updateContactSurface;
+- (void) handleCollisions;
+- (void) handleCollisionForGID: (dGeomID) o1 andGID: (dGeomID) o2;
+- (void) handleCollisionWithSpeed:(float)speed andAngle:(float)angle;
+- (void) resetBallInterpolation;
+- (void) getInterpolatedBallPos: (dVector3) pos andRot: (dMatrix3) rot;
 
 @end
 
@@ -143,6 +166,18 @@ static BasicGame * singleton;
 	
 	dWorldSetGravity(m_world, 0, 0, 0);
 	
+	m_lastFrameTime = 0;
+	m_timeAccumulator = 0;
+	pthread_mutex_init(&m_physicsMutex, NULL);
+	pthread_cond_init(&m_physicsCondition, NULL);
+	m_physicsFrameRunning = NO;
+	m_physicsFramePending = NO;
+	m_physicsThreadShouldExit = NO;
+	m_pendingTorque[0] = m_pendingTorque[1] = m_pendingTorque[2] = 0;
+	m_numCollisionSounds = 0;
+	m_frontSnapshot = 0;
+	[self resetBallInterpolation];
+	
 	m_accX = m_accY = m_accZ = 0;
 	m_accX_lp = m_accY_lp = m_accZ_lp = 0;
 	m_accX_hp = m_accY_hp = m_accZ_hp = 0;
@@ -155,18 +190,26 @@ static BasicGame * singleton;
 	m_cameraY_offset = 0;
 	m_cameraZ_zoom = 0;
 	
-	m_contactGroup = dJointGroupCreate(MAX_CONTACTS);
+	// The contacts are made and thrown away every step, so they go in a recycled contact group
+	m_contactGroup = dContactGroupCreate(m_world);
+	m_contactBatch = dContactBatchCreate(MAX_CONTACTS);
+	// The surfaces are looked up once per pair of colliding geoms from their materials
+	m_materials = dMaterialTableCreate(kNumMaterials);
+	dWorldSetMaterialTable(m_world, m_materials);
 	
 	// The ODE space we are working with
 	m_space = dSimpleSpaceCreate(NULL);
+	// Don't bother colliding the walls with each other (or anything with a sleeping ball)
+	dSpaceSetIgnoreIdlePairs(m_space, 1);
 	
 	// Create a sphere in the ODE space
 	m_ballGeom = dCreateSphere(m_space, m_ballRadius);
 	dGeomSetBody(m_ballGeom, m_ballID);
+	dGeomSetMaterial(m_ballGeom, kMaterialIDBall);
 	
 	// Create the box in the ODE space
 	// Create the planes that bound the box
-	// These are what the ball will actually collide with
+	// These are what the ball will actually collide with (new geoms have material 0, kMaterialIDWall)
 	m_wallGeoms[kWalIDNorth] = dCreatePlane(m_space, 0, -1, 0, -TOP_LIMIT); // top wall
 	m_wallGeoms[kWalIDSouth] = dCreatePlane(m_space, 0, 1, 0, BOTTOM_LIMIT); // bottom wall
 	m_wallGeoms[kWalIDEast] = dCreatePlane(m_space, -1, 0, 0, -RIGHT_LIMIT); // right wall
@@ -186,8 +229,8 @@ static BasicGame * singleton;
 	acc.updateInterval = 1.0/20.0;
 	acc.delegate = self;
 	
+	[self startPhysicsThread];
 	
-	singleton = self;
 	return self;
 }
 
@@ -248,15 +291,14 @@ static BasicGame * singleton;
 		gluPerspective(45, rect.size.width / rect.size.height, .1, MAX_DEPTH);
 		glViewport(0, 0, rect.size.width, rect.size.height);
 	}
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	m_viewportHeight = viewport[3];
 
 	
 	glMatrixMode(GL_MODELVIEW);
 }
 
-static void nearCallback(void * data, dGeomID o1, dGeomID o2) {
-	[singleton callBack: data id1: o1 id2: o2];
-}
-
 - (void) applyAerodynamicDragForce {
 
 	//////////////
@@ -306,18 +348,99 @@ static void nearCallback(void * data, dGeomID o1, dGeomID o2) {
 }
 
 - (void) physicsTimeStep {
+	// This is the frame boundary. Pick up the frame the physics thread was working on, then hand it the next one
+	// and let it run while this frame is drawn from the snapshot it just finished.
+	[self waitForPhysics];
+	if (m_physicsFramePending) {
+		m_frontSnapshot = 1 - m_frontSnapshot;
+		m_physicsFramePending = NO;
+		// Sounds and the bounce count stay on the main thread
+		for (int i = 0; i < m_numCollisionSounds; i++)
+			[self handleCollisionWithSpeed:m_collisionSounds[i].speed andAngle:m_collisionSounds[i].angle];
+		m_numCollisionSounds = 0;
+	}
+	
+	// Take as many fixed-size steps as the wall-clock time since the last frame calls for, so the game runs
+	// at the same speed whatever the frame rate is. The time left over is used to interpolate the ball when drawing.
+	CFTimeInterval now = CACurrentMediaTime();
+	if (m_lastFrameTime == 0)
+		m_lastFrameTime = now - PHYSICS_STEP_INTERVAL;
+	m_timeAccumulator += now - m_lastFrameTime;
+	m_lastFrameTime = now;
+	
+	// Keep the physics cost of a slow frame (or of coming back from the settings view) bounded
+	if (m_timeAccumulator > MAX_PHYSICS_STEPS_PER_FRAME * PHYSICS_STEP_INTERVAL)
+		m_timeAccumulator = MAX_PHYSICS_STEPS_PER_FRAME * PHYSICS_STEP_INTERVAL;
+	
+	int numSteps = 0;
+	while (m_timeAccumulator >= PHYSICS_STEP_INTERVAL) {
+		numSteps++;
+		m_timeAccumulator -= PHYSICS_STEP_INTERVAL;
+	}
+	
+	BallSnapshot * front = &m_ballSnapshots[m_frontSnapshot];
+	BallSnapshot * back = &m_ballSnapshots[1 - m_frontSnapshot];
+	back->alpha = m_timeAccumulator / PHYSICS_STEP_INTERVAL;
+	m_physicsFramePending = YES;
+	if (numSteps == 0) {
+		// Nothing to simulate, only the interpolation moves on
+		memcpy(back->prevPos, front->prevPos, sizeof(back->prevPos));
+		memcpy(back->prevQuat, front->prevQuat, sizeof(back->prevQuat));
+		memcpy(back->pos, front->pos, sizeof(back->pos));
+		memcpy(back->quat, front->quat, sizeof(back->quat));
+		return;
+	}
+	
+	// Sample the inputs for the whole frame
+	m_frameInput.numSteps = numSteps;
+	m_frameInput.accLP[0] = m_accX_lp; m_frameInput.accLP[1] = m_accY_lp; m_frameInput.accLP[2] = m_accZ_lp;
+	m_frameInput.accHP[0] = m_accX_hp; m_frameInput.accHP[1] = m_accY_hp; m_frameInput.accHP[2] = m_accZ_hp;
+	for (int i = 0; i < 3; i++) {
+		m_frameInput.torque[i] = m_pendingTorque[i];
+		m_pendingTorque[i] = 0;
+	}
+	
+	pthread_mutex_lock(&m_physicsMutex);
+	m_physicsFrameRunning = YES;
+	pthread_cond_broadcast(&m_physicsCondition);
+	pthread_mutex_unlock(&m_physicsMutex);
+}
+
+- (void) simulateFrame {
+	// Runs on the physics thread. Only touches the ODE objects, m_frameInput, and the back buffers.
+	BallSnapshot * back = &m_ballSnapshots[1 - m_frontSnapshot];
+	// The body states are copied straight into the snapshot
+	dBodyStateBuffers prevState = {0};
+	prevState.pos = back->prevPos;
+	prevState.quat = back->prevQuat;
+	dBodyStateBuffers state = {0};
+	state.pos = back->pos;
+	state.quat = back->quat;
+	
+	dBodyAddTorque(m_ballID, m_frameInput.torque[0], m_frameInput.torque[1], m_frameInput.torque[2]);
+	for (int i = 0; i < m_frameInput.numSteps; i++) {
+		// Remember where the ball was for the interpolation
+		dWorldGetBodyStates(m_world, &m_ballID, 1, &prevState);
+		[self stepPhysics];
+	}
+	dWorldGetBodyStates(m_world, &m_ballID, 1, &state);
+}
+
+- (void) stepPhysics {
 	// Force = mass*acceleration so account for the ball mass when applying gravity
+	const UIAccelerationValue * lp = m_frameInput.accLP;
+	const UIAccelerationValue * hp = m_frameInput.accHP;
 	
 	//////////////
 	// Gravity
-	dBodyAddForce(m_ballID, m_accX_lp*m_ballMass, m_accY_lp*m_ballMass, m_accZ_lp*m_ballMass);
+	dBodyAddForce(m_ballID, lp[0]*m_ballMass, lp[1]*m_ballMass, lp[2]*m_ballMass);
 	
 	
 	//////////////
 	// Shaking force
-	dVector3 a = {m_accX_lp, m_accY_lp, m_accZ_lp};
+	dVector3 a = {lp[0], lp[1], lp[2]};
 	dVector3 b = {0, 0, -1};
-	dVector3 c = {m_accX_hp, m_accY_hp, m_accZ_hp};
+	dVector3 c = {hp[0], hp[1], hp[2]};
 	dVector3 result;
 	unrotateVectorByVector(a, b, c, result);
 	
@@ -335,14 +458,115 @@ static void nearCallback(void * data, dGeomID o1, dGeomID o2) {
 	
 	//////////////
 	// Finish up
-	dSpaceCollide(m_space, NULL, &nearCallback);
-	dWorldStep(m_world, .15);
+	// Collide everything in one pass and create all the contact joints at once, with the surfaces
+	// from the world's material table
+	dContactBatchReset(m_contactBatch);
+	dSpaceCollectContacts(m_space, m_contactBatch);
+	dJointCreateContacts(m_world, m_contactGroup, m_contactBatch, NULL);
+	[self handleCollisions];
+	// Small islands (like a single ball against the walls) get the accurate dense solver, and anything
+	// bigger gets QuickStep, so adding balls doesn't blow up the step cost
+	dWorldAutoStep(m_world, PHYSICS_STEP_SIZE);
 	dJointGroupEmpty(m_contactGroup);	
 }
 
-- (void) drawGameView {
+- (void) resetBallInterpolation {
+	// Make the current ball state the start of the interpolation. Call this after moving the ball by hand,
+	// so it is drawn where it is now instead of sweeping over from its old position.
+	// The physics thread must not be running (see waitForPhysics).
 	const dReal * pos = dBodyGetPosition(m_ballID);
-	const dReal * rot = dBodyGetRotation(m_ballID);
+	const dReal * quat = dBodyGetQuaternion(m_ballID);
+	for (int s = 0; s < 2; s++) {
+		BallSnapshot * snapshot = &m_ballSnapshots[s];
+		memcpy(snapshot->prevPos, pos, sizeof(snapshot->prevPos));
+		memcpy(snapshot->prevQuat, quat, sizeof(snapshot->prevQuat));
+		memcpy(snapshot->pos, pos, sizeof(snapshot->pos));
+		memcpy(snapshot->quat, quat, sizeof(snapshot->quat));
+		snapshot->alpha = 0;
+	}
+}
+
+- (void) getInterpolatedBallPos: (dVector3) pos andRot: (dMatrix3) rot {
+	// Blend between the two physics states of the front snapshot by the fraction of a step that hadn't been
+	// simulated yet. The physics thread may be filling the back one at the same time.
+	const BallSnapshot * snapshot = &m_ballSnapshots[m_frontSnapshot];
+	dReal alpha = snapshot->alpha;
+	for (int i = 0; i < 3; i++)
+		pos[i] = snapshot->prevPos[i] + (snapshot->pos[i] - snapshot->prevPos[i]) * alpha;
+	
+	// Normalized lerp of the orientation, along the shorter arc
+	dReal dot = 0;
+	for (int i = 0; i < 4; i++) dot += snapshot->prevQuat[i] * snapshot->quat[i];
+	dReal sign = (dot < 0) ? -1 : 1;
+	dQuaternion quat;
+	for (int i = 0; i < 4; i++)
+		quat[i] = snapshot->prevQuat[i] + (sign * snapshot->quat[i] - snapshot->prevQuat[i]) * alpha;
+	dNormalize4(quat);
+	dQtoR(quat, rot);
+}
+
+
+#pragma mark ----- Physics Thread -----
+
+static void * physicsThreadMain(void * game) {
+	[(__bridge BasicGame *)game physicsThreadLoop];
+	return NULL;
+}
+
+- (void) startPhysicsThread {
+	// A plain pthread rather than an NSThread, which would keep the game alive
+	pthread_create(&m_physicsThread, NULL, physicsThreadMain, (__bridge void *)self);
+}
+
+- (void) stopPhysicsThread {
+	pthread_mutex_lock(&m_physicsMutex);
+	m_physicsThreadShouldExit = YES;
+	pthread_cond_broadcast(&m_physicsCondition);
+	pthread_mutex_unlock(&m_physicsMutex);
+	pthread_join(m_physicsThread, NULL);
+	pthread_cond_destroy(&m_physicsCondition);
+	pthread_mutex_destroy(&m_physicsMutex);
+}
+
+- (void) physicsThreadLoop {
+	// ODE keeps some data per thread
+	dAllocateODEDataForThread(dAllocateMaskAll);
+	
+	pthread_mutex_lock(&m_physicsMutex);
+	for (;;) {
+		// Finish the frame in progress before exiting, so waitForPhysics never hangs
+		while (!m_physicsFrameRunning && !m_physicsThreadShouldExit)
+			pthread_cond_wait(&m_physicsCondition, &m_physicsMutex);
+		if (!m_physicsFrameRunning)
+			break;
+		pthread_mutex_unlock(&m_physicsMutex);
+		
+		@autoreleasepool {
+			[self simulateFrame];
+		}
+		
+		pthread_mutex_lock(&m_physicsMutex);
+		m_physicsFrameRunning = NO;
+		pthread_cond_broadcast(&m_physicsCondition);
+	}
+	pthread_mutex_unlock(&m_physicsMutex);
+	
+	dCleanupODEAllDataForThread();
+}
+
+- (void) waitForPhysics {
+	// Wait until the physics thread is done with the frame it was handed, if any. After this the main thread
+	// can use the ODE objects until the next physicsTimeStep.
+	pthread_mutex_lock(&m_physicsMutex);
+	while (m_physicsFrameRunning)
+		pthread_cond_wait(&m_physicsCondition, &m_physicsMutex);
+	pthread_mutex_unlock(&m_physicsMutex);
+}
+
+- (void) drawGameView {
+	dVector3 pos;
+	dMatrix3 rot;
+	[self getInterpolatedBallPos: pos andRot: rot];
 	//NSLog(@"x = %f, y = %f, z = %f", pos[0], pos[1], pos[2]);
 	
 	// Change height of camera relative to box
@@ -393,6 +617,12 @@ static void nearCallback(void * data, dGeomID o1, dGeomID o2) {
 	[m_ball setPos: pos];
 	[m_ball setRot: rot];
 	
+	// Use a coarser ball mesh when the ball is small on screen
+	GLfloat dx = pos[0] - m_cameraX;
+	GLfloat dy = pos[1] - m_cameraY;
+	GLfloat dz = pos[2] - m_cameraZ;
+	[m_ball setScreenRadius: ballMeshScreenRadius(m_ballRadius, sqrtf(dx*dx + dy*dy + dz*dz), 45, m_viewportHeight)];
+	
 	[m_walls draw];
 	[m_ball draw];
 	
@@ -598,47 +828,45 @@ static void nearCallback(void * data, dGeomID o1, dGeomID o2) {
 	//NSLog(@"Collision speed: %f", relativeSpeed);
 	//NSLog(@"Collision angle: %f", RADIANS_TO_DEGREES(collisionAngle));
 	
-	// Play the sound for the collision
-	[self handleCollisionWithSpeed:relativeSpeed andAngle:collisionAngle];
+	// Play the sound for the collision at the end of the frame, back on the main thread
+	if (m_numCollisionSounds < MAX_COLLISION_SOUNDS) {
+		m_collisionSounds[m_numCollisionSounds].speed = relativeSpeed;
+		m_collisionSounds[m_numCollisionSounds].angle = collisionAngle;
+		m_numCollisionSounds++;
+	}
 	
 }
 
 
-#pragma mark ----- Near Callback Method -----
+#pragma mark ----- Contact Methods -----
 
-- (void) callBack: (void *) data id1: (dGeomID) o1 id2: (dGeomID) o2 {
+- (void) updateContactSurface {
+	dSurfaceParameters surface;
+	memset(&surface, 0, sizeof(surface));
+	surface.mode = dContactBounce | dContactSoftCFM;
+	// friction parameter
+	surface.mu = 8;
 	
-	if (dGeomIsSpace(o1) || dGeomIsSpace(o2)) {
-		// colliding a space with something
-		dSpaceCollide2(o1, o2, data, &nearCallback);
-		// collide all geoms internal to the space(s)
-		if (dGeomIsSpace(o1)) dSpaceCollide(o1, data, &nearCallback);
-		if (dGeomIsSpace(o2)) dSpaceCollide(o2, data, &nearCallback);
-	}
-	else {
-		//NSLog(@"colliding two non-space geoms");
-		// colliding two non-space geoms, so generate contact points between o1 and o2
-		int num_contacts = dCollide(o1, o2, MAX_CONTACTS, &contact_array[0].geom, sizeof(dContact));
-		for (int i = 0; i < num_contacts; i++) {
-			contact_array[i].surface.mode = dContactBounce | dContactSoftCFM;
-			// friction parameter
-			contact_array[i].surface.mu = 8;
-			
-			// bounce is the amount of "bouncyness".
-			contact_array[i].surface.bounce = m_ballBounce;
-			// bounce_vel is the minimum incoming velocity to cause a bounce
-			contact_array[i].surface.bounce_vel = 0.25;//0.1;
-			// soft_cfm is the "constraint force mixing parameter"
-			contact_array[i].surface.soft_cfm = 0.001;
-			
-			dJointID c = dJointCreateContact (m_world, m_contactGroup, &contact_array[i]);
-			dJointAttach (c, dGeomGetBody(contact_array[i].geom.g1), dGeomGetBody(contact_array[i].geom.g2));
-			
-			// Play a sound for the collision
-			// It works to play a sound here because we are working with spheres, which only have one contact point
-			[self handleCollisionForGID: o1 andGID: o2];
-			
-		}
+	// bounce is the amount of "bouncyness".
+	surface.bounce = m_ballBounce;
+	// bounce_vel is the minimum incoming velocity to cause a bounce
+	surface.bounce_vel = 0.25;//0.1;
+	// soft_cfm is the "constraint force mixing parameter"
+	surface.soft_cfm = 0.001;
+	
+	// The ball is in every contact, so they all get its bounce
+	// Stick to bounce, soft CFM, and mu so the contacts get ODE's fast path for this surface mode
+	dMaterialTableSetSurface(m_materials, kMaterialIDBall, kMaterialIDWall, &surface);
+	dMaterialTableSetSurface(m_materials, kMaterialIDBall, kMaterialIDBall, &surface);
+}
+
+- (void) handleCollisions {
+	// Queue a sound for every collision of the last collision pass
+	// One sound per pair of geoms, which is one per contact for the spheres we are working with
+	const dContactBatchPair * pairs = dContactBatchGetPairs(m_contactBatch);
+	int numPairs = dContactBatchGetNumPairs(m_contactBatch);
+	for (int i = 0; i < numPairs; i++) {
+		[self handleCollisionForGID: pairs[i].g1 andGID: pairs[i].g2];
 	}
 }
 
@@ -648,7 +876,10 @@ static void nearCallback(void * data, dGeomID o1, dGeomID o2) {
 - (void) addTorqueX: (dReal) x Y: (dReal) y Z: (dReal) z {
 	dReal scale = (m_ballRadius + 3) * (m_ballRadius + 3) * .025;
 	//NSLog(@"torqMagSq: %f", torqMagSq);
-	dBodyAddTorque(m_ballID, x * scale, y * scale, z * scale);
+	// The physics thread may be stepping the ball, so add it with the next frame's input
+	m_pendingTorque[0] += x * scale;
+	m_pendingTorque[1] += y * scale;
+	m_pendingTorque[2] += z * scale;
 }
 
 - (float) magnitude:(dVector3) vector {
@@ -689,6 +920,9 @@ static void nearCallback(void * data, dGeomID o1, dGeomID o2) {
 
 - (void) setBallSize:(float)radius andBounce:(float)bounce andMass:(float)mass {
 	
+	// Don't change the ball under the physics thread
+	[self waitForPhysics];
+	
 	// Set ball size
 	m_ballRadius = radius;
 	m_ballArea = PI * radius * radius;
@@ -705,9 +939,11 @@ static void nearCallback(void * data, dGeomID o1, dGeomID o2) {
 	
 	// Set ball bounciness
 	m_ballBounce = bounce;
+	[self updateContactSurface];
 	
 	// Reset position of ball (to make sure it isn't inside a wall or the floor)
 	dBodySetPosition(m_ballID, 0, 0, -2*m_ballRadius);
+	[self resetBallInterpolation];
 }
 
 
@@ -896,7 +1132,10 @@ static void nearCallback(void * data, dGeomID o1, dGeomID o2) {
 }
 
 - (void) dealloc {
+	[self stopPhysicsThread];
 	dJointGroupDestroy(m_contactGroup);
+	dContactBatchDestroy(m_contactBatch);
+	dMaterialTableDestroy(m_materials);
 	dBodyDestroy(m_ballID);
 	dWorldDestroy(m_world);
 	
@@ -31,8 +31,8 @@
 	GLfloat m_y;
 	GLfloat m_z;
 	
-	// Ball rotation (matrix form)
-	GLfloat m_rot[12];
+	// Ball rotation (column-major 4x4 matrix, ready for glMultMatrixf)
+	GLfloat m_rot[16];
 	
 	// This is the radius of the ball
 	GLfloat m_scale;
@@ -40,6 +40,9 @@
 	// OpenGL texture number for the ball
 	GLuint m_textureID;
 	
+	// Level of detail of the mesh used to draw the ball (see ball_mesh.h)
+	unsigned int m_lod;
+	
 	// scaling/shift parameters to "squish" the ball (currently unused)
 	GLfloat m_xSquish;
 	GLfloat m_xShift;
@@ -58,10 +61,12 @@
 - (void) draw;
 
 - (void) setScale: (GLfloat) scale;
+- (void) setScreenRadius: (GLfloat) pixels;
 - (void) setTexture: (NSString*) imName releaseOld: (BOOL) releaseOld reloadCustomImage: (BOOL) loadCustomBallImage;
 - (void) setTexture: (NSString*) imName releaseOld: (BOOL) releaseOld;
 - (void) setPos: (const dReal *) pos;
 - (void) setRot: (const dReal *) rot;
+- (void) setTransform: (const dReal *) matrix;
 - (void) setXSquish: (GLfloat) squish andShift: (GLfloat) shift;
 - (void) setYSquish: (GLfloat) squish andShift: (GLfloat) shift;
 - (void) setZSquish: (GLfloat) squish andShift: (GLfloat) shift;
@@ -26,12 +26,24 @@
 #import <OpenGLES/ES1/gl.h>
 #import <OpenGLES/ES1/glext.h>
 
+#include <stddef.h>
+
 #import "GLBall.h"
 #import "TextureLoader.h"
-#import "ball_model.h"
+#import "ball_mesh.h"
 #import "ode.h"
 #import "UserDefaults.h"
 
+// Vertex and index buffers for every level of detail of the ball mesh. Buffer
+// objects belong to a GL context, so there is one set per context (the game and
+// the preview views each have their own), shared by all the balls drawn in it.
+typedef struct BallMeshBuffers {
+	GLuint vertexBuffer[BALL_MESH_NUM_LODS];
+	GLuint indexBuffer[BALL_MESH_NUM_LODS];
+} BallMeshBuffers;
+
+static NSMutableDictionary * meshBuffersByContext = nil;
+
 @implementation GLBall
 
 @synthesize imageName;
@@ -42,20 +54,9 @@
 	m_z = z;
 	
 	// initialize with no rotation (identity matrix)
-	m_rot[0] = 1;
-	m_rot[1] = 0;
-	m_rot[2] = 0;
-	m_rot[3] = 0;
-	
-	m_rot[4] = 0;
-	m_rot[5] = 1;
-	m_rot[6] = 0;
-	m_rot[7] = 0;
-	
-	m_rot[8] = 0;
-	m_rot[9] = 0;
-	m_rot[10] = 1;
-	m_rot[11] = 1;
+	for (int i = 0; i < 16; i++) {
+		m_rot[i] = (i % 5 == 0) ? 1 : 0;
+	}
 	
 	// these aren't really used yet (these values make them have no effect)
 	m_xShift = 0.0;
@@ -68,9 +69,43 @@
 	m_scale = scale;
 	imageName = NULL;
 	
+	// full detail until told how big the ball is on screen
+	m_lod = BALL_MESH_NUM_LODS - 1;
+	
 	return self;
 }
 
+// Bind the buffers holding the mesh for a level of detail in the current
+// context, uploading the mesh the first time it is used there
++ (const BallMesh *) bindMeshForLOD: (unsigned int) lod {
+	const BallMesh * mesh = ballMeshForLOD(lod);
+	
+	if (meshBuffersByContext == nil)
+		meshBuffersByContext = [[NSMutableDictionary alloc] init];
+	
+	// Contexts are never destroyed, so it is safe to key on the pointer
+	NSValue * key = [NSValue valueWithNonretainedObject: [EAGLContext currentContext]];
+	NSMutableData * data = [meshBuffersByContext objectForKey: key];
+	if (data == nil) {
+		data = [NSMutableData dataWithLength: sizeof(BallMeshBuffers)];
+		[meshBuffersByContext setObject: data forKey: key];
+	}
+	BallMeshBuffers * buffers = [data mutableBytes];
+	
+	if (!buffers->vertexBuffer[lod]) {
+		glGenBuffers(1, &buffers->vertexBuffer[lod]);
+		glBindBuffer(GL_ARRAY_BUFFER, buffers->vertexBuffer[lod]);
+		glBufferData(GL_ARRAY_BUFFER, mesh->numVertices * sizeof(BallMeshVertex), mesh->vertices, GL_STATIC_DRAW);
+		glGenBuffers(1, &buffers->indexBuffer[lod]);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers->indexBuffer[lod]);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh->numIndices * sizeof(GLushort), mesh->indices, GL_STATIC_DRAW);
+	}
+	else {
+		glBindBuffer(GL_ARRAY_BUFFER, buffers->vertexBuffer[lod]);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers->indexBuffer[lod]);
+	}
+	return mesh;
+}
 
 - (void) draw {
 	
@@ -86,32 +121,16 @@
 	glScalef(m_xSquish, m_ySquish, m_zSquish);
 	
 	// apply ball rotation
-	GLfloat matrix[16];
-	matrix[0] = m_rot[0];
-	matrix[1] = m_rot[4];
-	matrix[2] = m_rot[8];
-	matrix[3] = 0;
-	matrix[4] = m_rot[1];
-	matrix[5] = m_rot[5];
-	matrix[6] = m_rot[9];
-	matrix[7] = 0;
-	matrix[8] = m_rot[2];
-	matrix[9] = m_rot[6];
-	matrix[10] = m_rot[10];
-	matrix[11] = 0;
-	matrix[12] = 0;
-	matrix[13] = 0;
-	matrix[14] = 0;
-	matrix[15] = 1;
-	glMultMatrixf(matrix);
+	glMultMatrixf(m_rot);
 	
 	// apply ball scale (radius)
 	glScalef(m_scale, m_scale, m_scale);
 	
-	// perform drawing using coordinate/normal/texture arrays
-	glVertexPointer(3, GL_FLOAT, 0, ballVertices);
-	glNormalPointer(GL_FLOAT, 0, ballNormals);
-	glTexCoordPointer (2, GL_FLOAT, 0, ballTexture);
+	// perform drawing using the interleaved coordinate/normal/texture buffer
+	const BallMesh * mesh = [GLBall bindMeshForLOD: m_lod];
+	glVertexPointer(3, GL_FLOAT, sizeof(BallMeshVertex), (const GLvoid *)offsetof(BallMeshVertex, position));
+	glNormalPointer(GL_FLOAT, sizeof(BallMeshVertex), (const GLvoid *)offsetof(BallMeshVertex, normal));
+	glTexCoordPointer (2, GL_FLOAT, sizeof(BallMeshVertex), (const GLvoid *)offsetof(BallMeshVertex, texCoord));
 	glEnableClientState(GL_VERTEX_ARRAY);
 	glEnableClientState(GL_NORMAL_ARRAY);
 	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
@@ -121,15 +140,16 @@
 //	glBlendFunc(GL_ONE_MINUS_DST_ALPHA, GL_DST_ALPHA);
 //	glDisable(GL_DEPTH_TEST);
 	glColor4f(1, 1, 1, 1);
-	for (unsigned int i = 0; i < ballIndexCount/3; i++) {
-		glDrawElements(GL_TRIANGLES, 3, GL_UNSIGNED_SHORT, &ballIndices[i * 3]);
-	}
+	glDrawElements(GL_TRIANGLES, mesh->numIndices, GL_UNSIGNED_SHORT, 0);
 //	glEnable(GL_DEPTH_TEST);
 //	glDisable(GL_BLEND);
 	glDisable(GL_TEXTURE_2D);
 	glDisableClientState(GL_VERTEX_ARRAY);
 	glDisableClientState(GL_NORMAL_ARRAY);
 	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	// the rest of the scene draws from client-side arrays
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	glPopMatrix();
 }
 
@@ -137,6 +157,11 @@
 	m_scale = scale;
 }
 
+// pick the level of detail from the ball's radius on screen (in pixels)
+- (void) setScreenRadius: (GLfloat) pixels {
+	m_lod = ballMeshLODForScreenRadius(pixels);
+}
+
 - (void) setTexture: (NSString*) imName releaseOld: (BOOL) releaseOld reloadCustomImage: (BOOL) loadCustomBallImage {
 	//NSLog(@"imageName: %@", imageName);
 	static NSString *customBallName = @"customBall";
@@ -188,11 +213,26 @@
 	m_z = pos[2];
 }
 
-// set ball rotation
+// set ball rotation from an ODE (row-major 3x4) matrix
 - (void) setRot: (const dReal *) rot {
-	for (int i = 0; i < 12; i++) {
-		m_rot[i] = rot[i];
+	// OpenGL matrices are column-major, so the rows of rot become the columns
+	for (int row = 0; row < 3; row++) {
+		for (int col = 0; col < 3; col++) {
+			m_rot[col*4 + row] = rot[row*4 + col];
+		}
+	}
+}
+
+// set ball position and rotation from a column-major 4x4 matrix, as returned by dWorldGetBodyStates
+- (void) setTransform: (const dReal *) matrix {
+	for (int col = 0; col < 3; col++) {
+		for (int row = 0; row < 3; row++) {
+			m_rot[col*4 + row] = matrix[col*4 + row];
+		}
 	}
+	m_x = matrix[12];
+	m_y = matrix[13];
+	m_z = matrix[14];
 }
 
 // unused
@@ -66,6 +66,7 @@ typedef enum glObjTypeEnum {
 	BallTypes * ballTypes;
 	GLBall * m_ball;
 	dReal m_ballRadius;
+	GLfloat m_viewportHeight; // In pixels, for picking the ball's level of detail
 	
 	// Walls
 	GLWalls * m_walls;	
@@ -32,6 +32,7 @@
 #import "GLBall.h"
 #import "GLWalls.h"
 #import "glUtil.h"
+#import "ball_mesh.h"
 #import "TextureLoader.h"
 #import "ode.h"
 #import "BallTypes.h"
@@ -183,6 +184,9 @@ static EAGLContext * static_context = nil;
 		gluPerspective(45, rect.size.width / rect.size.height, .1, MAX_DEPTH);
 		glViewport(0, 0, rect.size.width, rect.size.height);
 	}
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	m_viewportHeight = viewport[3];
 
 	
 	glMatrixMode(GL_MODELVIEW);
@@ -233,12 +237,14 @@ static EAGLContext * static_context = nil;
 			cameraAngleY -= 360;
 		
 		// Set camera posision
-		glTranslatef(0, 0, -15);
+		static const GLfloat cameraDistance = 15;
+		glTranslatef(0, 0, -cameraDistance);
 		
 		// set camera rotation
 		glRotatef(cameraAngleX, 1.0, 0, 0);
 		glRotatef(cameraAngleY, 0, 1.0, 0);
 
+		[m_ball setScreenRadius: ballMeshScreenRadius(m_ballRadius, cameraDistance, 45, m_viewportHeight)];
 		[m_ball draw];
 	}
 	else if (objType == glWallType) {
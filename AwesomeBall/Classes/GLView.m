@@ -134,8 +134,9 @@ static EAGLContext * static_context = nil;
     glMatrixMode(GL_MODELVIEW);
 	glLoadIdentity();
 	
-	[m_gameType drawGameView];
+	// Start the physics for the next frame first, so it runs in the background while this one is drawn
 	[m_gameType physicsTimeStep];
+	[m_gameType drawGameView];
 	
     glBindRenderbufferOES(GL_RENDERBUFFER_OES, viewRenderbuffer);
     [context presentRenderbuffer:GL_RENDERBUFFER_OES];	
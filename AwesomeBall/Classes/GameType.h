@@ -29,7 +29,7 @@
 @protocol GameType
 
 #pragma mark ----- Game Methods -----
-- (void) physicsTimeStep;
+- (void) physicsTimeStep; // Called at every frame boundary, before drawGameView
 - (void) drawGameView;
 
 #pragma mark ----- Touch Handling Methods -----
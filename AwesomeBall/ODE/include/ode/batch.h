@@ -0,0 +1,249 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+#ifndef _ODE_BATCH_H_
+#define _ODE_BATCH_H_
+
+#include <ode/common.h>
+#include <ode/contact.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup batch Batched Contacts
+ *
+ * The usual way to create contacts is a near callback that calls dCollide()
+ * for every pair that dSpaceCollide() reports and then creates and attaches
+ * one contact joint per contact point. For scenes with many pairs, the
+ * same can be done in bulk:
+ *
+ * @code
+ * dContactBatchReset (batch);
+ * dSpaceCollectContacts (space, batch);
+ * dJointCreateContacts (world, contactgroup, batch, materials);
+ * @endcode
+ *
+ * dSpaceCollectContacts() first gathers all potentially colliding pairs
+ * from the broadphase, then runs the narrowphase on all of them, writing
+ * the contact points into one contiguous buffer. dJointCreateContacts()
+ * then creates the contact joints of all pairs in one go, with the surface
+ * parameters that a material table gives for the materials of the two
+ * geoms (see dGeomSetMaterial()). The pairs and contacts stay in the batch
+ * until it is reset, so they can be inspected, e.g. to play sounds.
+ *
+ * A world can have a material table of its own (dWorldSetMaterialTable()),
+ * which near callbacks can use as well through dWorldGetPairSurface().
+ * Contact joints whose surface mode only uses dContactBounce,
+ * dContactSoftERP, dContactSoftCFM and dContactApprox1 (all or none of it)
+ * are filled in by the steppers with a variant of the contact code that
+ * is specialized for that mode, so a small number of materials with such
+ * surfaces is the fastest setup.
+ */
+
+struct dxMaterialTable;
+typedef struct dxMaterialTable *dMaterialTableID;
+
+struct dxContactBatch;
+typedef struct dxContactBatch *dContactBatchID;
+
+
+/**
+ * @brief Create a table of surface parameters for every pair of materials.
+ * @ingroup batch
+ * @param num_materials materials are numbered 0..num_materials-1.
+ * @remarks
+ * All surfaces are initially mode 0 with mu = dInfinity.
+ */
+ODE_API dMaterialTableID dMaterialTableCreate (int num_materials);
+
+/**
+ * @brief Destroy a material table.
+ * @ingroup batch
+ */
+ODE_API void dMaterialTableDestroy (dMaterialTableID);
+
+/**
+ * @brief Get the number of materials of a table.
+ * @ingroup batch
+ */
+ODE_API int dMaterialTableGetNumMaterials (dMaterialTableID);
+
+/**
+ * @brief Set the surface parameters used where materials m1 and m2 touch.
+ * @ingroup batch
+ * @remarks
+ * The table is symmetric, this sets both (m1,m2) and (m2,m1).
+ */
+ODE_API void dMaterialTableSetSurface (dMaterialTableID, int m1, int m2,
+                                       const dSurfaceParameters *surface);
+
+/**
+ * @brief Get the surface parameters used where materials m1 and m2 touch.
+ * @ingroup batch
+ */
+ODE_API void dMaterialTableGetSurface (dMaterialTableID, int m1, int m2,
+                                       dSurfaceParameters *surface);
+
+/**
+ * @brief Set the material table of a world.
+ * @ingroup batch
+ * @remarks
+ * The world does not take ownership of the table, which must outlive the
+ * link; pass 0 to remove it. Several worlds can share a table.
+ */
+ODE_API void dWorldSetMaterialTable (dWorldID, dMaterialTableID);
+
+/**
+ * @brief Get the material table of a world, or 0.
+ * @ingroup batch
+ */
+ODE_API dMaterialTableID dWorldGetMaterialTable (dWorldID);
+
+/**
+ * @brief Get the surface parameters for contacts between two geoms from the
+ * material table of a world.
+ * @ingroup batch
+ * @remarks
+ * This is meant to be called once per pair in a near callback. Without a
+ * table, mode 0 and mu = dInfinity are returned.
+ */
+ODE_API void dWorldGetPairSurface (dWorldID, dGeomID g1, dGeomID g2,
+                                   dSurfaceParameters *surface);
+
+/**
+ * @brief Set the material of a geom.
+ * @ingroup batch
+ * @remarks
+ * New geoms have material 0. Materials outside of a table are treated as 0
+ * by that table.
+ */
+ODE_API void dGeomSetMaterial (dGeomID, int material);
+
+/**
+ * @brief Get the material of a geom.
+ * @ingroup batch
+ */
+ODE_API int dGeomGetMaterial (dGeomID);
+
+
+/**
+ * @brief A pair of geoms in a contact batch, and its contacts.
+ * @ingroup batch
+ */
+typedef struct dContactBatchPair {
+  dGeomID g1, g2;		/**< as passed to dCollide() */
+  int first;			/**< index of the first contact of the pair */
+  int count;			/**< number of contacts, always > 0 */
+} dContactBatchPair;
+
+/**
+ * @brief Create a contact batch.
+ * @ingroup batch
+ * @param max_contacts_per_pair the number of contacts that dCollide() is
+ * allowed to return for a pair, as its `flags' argument.
+ */
+ODE_API dContactBatchID dContactBatchCreate (int max_contacts_per_pair);
+
+/**
+ * @brief Destroy a contact batch.
+ * @ingroup batch
+ */
+ODE_API void dContactBatchDestroy (dContactBatchID);
+
+/**
+ * @brief Remove all pairs and contacts from a batch.
+ * @ingroup batch
+ * @remarks
+ * The memory of the batch is kept, so a batch that is reset every step stops
+ * allocating once the scene has settled.
+ */
+ODE_API void dContactBatchReset (dContactBatchID);
+
+/**
+ * @brief Get the number of pairs with contacts in a batch.
+ * @ingroup batch
+ */
+ODE_API int dContactBatchGetNumPairs (dContactBatchID);
+
+/**
+ * @brief Get the pairs with contacts of a batch.
+ * @ingroup batch
+ * @remarks
+ * The array is valid until the batch is changed.
+ */
+ODE_API const dContactBatchPair *dContactBatchGetPairs (dContactBatchID);
+
+/**
+ * @brief Get the number of contacts in a batch.
+ * @ingroup batch
+ */
+ODE_API int dContactBatchGetNumContacts (dContactBatchID);
+
+/**
+ * @brief Get the contacts of a batch, in the order of its pairs.
+ * @ingroup batch
+ * @remarks
+ * The array is valid until the batch is changed.
+ */
+ODE_API const dContactGeom *dContactBatchGetContacts (dContactBatchID);
+
+/**
+ * @brief Add the contacts of all colliding geoms in a space to a batch.
+ * @ingroup batch
+ * @remarks
+ * This does what dSpaceCollide() does with a near callback that calls
+ * dCollide() for every pair of geoms and dSpaceCollide2() for every pair
+ * with a space in it. The geoms inside every space nested in the space are
+ * collided with each other once, whether or not anything overlaps that
+ * space. Pairs whose bodies are already connected by a joint other than a
+ * contact are left out.
+ *
+ * All pairs are gathered first and the narrowphase is run on them
+ * afterwards, so no user code runs in between.
+ * @return the number of contacts added.
+ */
+ODE_API int dSpaceCollectContacts (dSpaceID, dContactBatchID);
+
+/**
+ * @brief Create and attach a contact joint for every contact in a batch.
+ * @ingroup batch
+ * @param group the joint group to put the joints in, or 0.
+ * @param materials gives the surface parameters of every pair, from the
+ * materials of its geoms. If it is 0, the world's table is used, and if the
+ * world has none, mode 0 and mu = dInfinity.
+ * @remarks
+ * This is the same as calling dJointCreateContact() and dJointAttach() for
+ * every contact, with the surface looked up once per pair and with no
+ * friction direction (fdir1 is 0).
+ * @return the number of joints created.
+ */
+ODE_API int dJointCreateContacts (dWorldID, dJointGroupID group,
+                                  dContactBatchID, dMaterialTableID materials);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
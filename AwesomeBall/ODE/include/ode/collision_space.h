@@ -65,6 +65,118 @@ ODE_API dSpaceID dQuadTreeSpaceCreate (dSpaceID space, const dVector3 Center, co
 
 ODE_API dSpaceID dSweepAndPruneSpaceCreate( dSpaceID space, int axisorder );
 
+/**
+ * @brief Set the number of threads a sweep and prune space uses to find
+ * overlapping pairs.
+ *
+ * With more than one thread the sorted AABBs are split into chunks that are
+ * pruned in parallel, each into its own pair list. The near callback is still
+ * only called from the thread calling dSpaceCollide(), and the pairs are
+ * reported in the same order as with a single thread.
+ *
+ * @param space the sweep and prune space.
+ * @param count the number of threads, including the calling thread. The
+ * default is 1.
+ * @ingroup collide
+ */
+ODE_API void dSweepAndPruneSpaceSetThreadCount( dSpaceID space, int count );
+
+/**
+ * @brief Get the number of threads a sweep and prune space uses to find
+ * overlapping pairs.
+ * @ingroup collide
+ */
+ODE_API int dSweepAndPruneSpaceGetThreadCount( dSpaceID space );
+
+
+
+/**
+ * @brief Create a space that keeps its geoms in a dynamic AABB tree.
+ *
+ * Every geom gets a leaf with a "fat" box, its AABB grown by a margin (see
+ * dBVHSpaceSetMargin). A geom that moves within its fat box costs nothing,
+ * one that leaves it is taken out of the tree and put back in, and the tree
+ * is kept balanced by rotations as that happens. The tree needs no extents
+ * or levels up front and copes well with geoms of very different sizes.
+ *
+ * dSpaceCollide2 walks the tree with the AABB of the other geom, or with the
+ * ray itself for ray geoms, so tests against a few geoms are cheap. Geoms
+ * with infinite AABBs (e.g. planes) are kept out of the tree and tested
+ * against everything.
+ *
+ * @param space the space to contain the new space. May be null.
+ * @returns The new space.
+ * @ingroup collide
+ * @see dBVHSpaceQueryAABB
+ * @see dBVHSpaceQueryRay
+ */
+ODE_API dSpaceID dBVHSpaceCreate (dSpaceID space);
+
+/**
+ * @brief Set the margin that AABBs are grown by in a BVH space.
+ *
+ * A larger margin lets geoms move further before the tree must be changed,
+ * but makes the boxes overlap more, so more pairs of tree nodes are tested
+ * in dSpaceCollide. The new margin is used for geoms that move after the
+ * call. The default is 0.1.
+ *
+ * @param space the BVH space.
+ * @param margin the margin, in world units, at least 0.
+ * @ingroup collide
+ */
+ODE_API void dBVHSpaceSetMargin (dSpaceID space, dReal margin);
+
+/**
+ * @brief Get the margin that AABBs are grown by in a BVH space.
+ * @ingroup collide
+ */
+ODE_API dReal dBVHSpaceGetMargin (dSpaceID space);
+
+/**
+ * @brief Callback for the geoms found by the BVH space queries.
+ *
+ * @param data The user data object, as passed to the query.
+ * @param geom A geom found by the query.
+ * @ingroup collide
+ */
+typedef void dSpaceQueryCallback (void *data, dGeomID geom);
+
+/**
+ * @brief Find the geoms of a BVH space whose AABB overlaps a box.
+ *
+ * Only enabled geoms are reported, each of them once. Geoms within the
+ * space that are spaces themselves are reported as a whole. The space must
+ * not be changed by the callback.
+ *
+ * @param space the BVH space.
+ * @param aabb the box, as (minx,maxx,miny,maxy,minz,maxz) like
+ * dGeomGetAABB.
+ * @param data passed to the callback.
+ * @param callback called for every geom found.
+ * @ingroup collide
+ */
+ODE_API void dBVHSpaceQueryAABB (dSpaceID space, const dReal aabb[6],
+				 void *data, dSpaceQueryCallback *callback);
+
+/**
+ * @brief Find the geoms of a BVH space whose AABB is crossed by a ray.
+ *
+ * The ray is the segment from @a start along @a dir for @a length times
+ * the length of @a dir. Geoms are reported as by dBVHSpaceQueryAABB, in no
+ * particular order. Call dCollide on the geoms found to get the actual hit
+ * points.
+ *
+ * @param space the BVH space.
+ * @param start the start of the ray.
+ * @param dir the direction of the ray, need not be of unit length.
+ * @param length the length of the ray, in multiples of @a dir.
+ * @param data passed to the callback.
+ * @param callback called for every geom found.
+ * @ingroup collide
+ */
+ODE_API void dBVHSpaceQueryRay (dSpaceID space, const dVector3 start,
+				const dVector3 dir, dReal length,
+				void *data, dSpaceQueryCallback *callback);
 
 
 ODE_API void dSpaceDestroy (dSpaceID);
@@ -113,6 +225,43 @@ ODE_API void dSpaceSetSublevel (dSpaceID space, int sublevel);
 */
 ODE_API int dSpaceGetSublevel (dSpaceID space);
 
+/**
+* @brief Sets whether a space skips pairs of idle geoms.
+*
+* A geom is idle if nothing can move it: it has no body, or its body is
+* disabled (e.g. by auto-disabling). When this is on, dSpaceCollide never
+* reports a pair of two idle geoms, since resting bodies need no contacts
+* with each other or with the static environment. A body that is woken up by
+* a contact with a moving body is kept awake for a while (as by
+* dBodyEnable), so that its own contacts are found in the next steps and
+* the waking spreads through a pile of resting bodies.
+*
+* The simple and hash spaces leave idle geoms out while looking for pairs,
+* so worlds that are mostly at rest collide in time roughly proportional to
+* the moving geoms. The sweep and prune space filters the pairs it finds and
+* returns early if all its geoms are idle; the quadtree space only filters.
+* The BVH space skips every part of its tree in which all geoms are idle.
+*
+* Spaces within the space are never idle. dSpaceCollide2 is not affected.
+* This is off by default, as pairs of static geoms (e.g. a ray without a
+* body against the level) are reported otherwise.
+*
+* @param space the space to modify
+* @param ignore 1 to skip pairs of idle geoms, 0 to report them
+* @ingroup collide
+* @see dSpaceGetIgnoreIdlePairs
+*/
+ODE_API void dSpaceSetIgnoreIdlePairs (dSpaceID space, int ignore);
+
+/**
+* @brief Gets whether a space skips pairs of idle geoms.
+*
+* @param space the space to query
+* @ingroup collide
+* @see dSpaceSetIgnoreIdlePairs
+*/
+ODE_API int dSpaceGetIgnoreIdlePairs (dSpaceID space);
+
 ODE_API void dSpaceAdd (dSpaceID, dGeomID);
 ODE_API void dSpaceRemove (dSpaceID, dGeomID);
 ODE_API int dSpaceQuery (dSpaceID, dGeomID);
@@ -128,6 +277,7 @@ ODE_API dGeomID dSpaceGetGeom (dSpaceID, int i);
  *  @li dHashSpaceClass
  *  @li dSweepAndPruneSpaceClass
  *  @li dQuadTreeSpaceClass
+ *  @li dBVHSpaceClass
  *  @li dFirstUserClass
  *  @li dLastUserClass
  *
@@ -115,6 +115,13 @@ ODE_API int dIsPositiveDefinite (const dReal *A, int n);
 ODE_API void dFactorLDLT (dReal *A, dReal *d, int n, int nskip);
 
 
+/* the same as dFactorLDLT(), but always with the unblocked algorithm that
+ * dFactorLDLT() uses for small matrices. big matrices are factored by blocks
+ * of columns, which gives slightly different results.
+ */
+ODE_API void dFactorLDLTUnblocked (dReal *A, dReal *d, int n, int nskip);
+
+
 /* solve L*x=b, where L is n*n lower triangular with ones on the diagonal,
  * and x,b are n*1. b is overwritten with x.
  * the leading dimension of L is `nskip'.
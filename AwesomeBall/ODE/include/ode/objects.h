@@ -186,6 +186,62 @@ ODE_API void dWorldImpulseToForce
 ODE_API void dWorldQuickStep (dWorldID w, dReal stepsize);
 
 
+/**
+ * @brief Step the world, picking the solver for every island.
+ * @ingroup world
+ * @remarks
+ * Small islands are stepped like in dWorldStep(), with the accurate but
+ * O(m^3) LCP solver, and all other islands are stepped like in
+ * dWorldQuickStep(). An island counts as small if it has no more bodies
+ * and constraint rows than set with dWorldSetAutoStepThresholds().
+ *
+ * This gives the accuracy of dWorldStep() to scenes of a few bodies,
+ * without the cost blowing up once bodies pile up into a large island.
+ * The QuickStep parameters (iterations, over-relaxation, warm starting)
+ * apply to the islands that are stepped with QuickStep.
+ * @see dWorldGetSolverIslandCounts
+ */
+ODE_API void dWorldAutoStep (dWorldID w, dReal stepsize);
+
+/**
+ * @brief Set the largest island that dWorldAutoStep() steps with the
+ * dense LCP solver.
+ * @ingroup world
+ * @param max_dense_bodies the default is 8 bodies.
+ * @param max_dense_rows the default is 32 constraint rows. A contact
+ * has 1 to 3 rows, depending on its friction.
+ */
+ODE_API void dWorldSetAutoStepThresholds (dWorldID, int max_dense_bodies,
+                                          int max_dense_rows);
+
+/**
+ * @brief Get the dWorldAutoStep() thresholds.
+ * @ingroup world
+ */
+ODE_API void dWorldGetAutoStepThresholds (dWorldID, int *max_dense_bodies,
+                                          int *max_dense_rows);
+
+/**
+ * @brief Get the number of islands that were stepped with each solver.
+ * @ingroup world
+ * @remarks
+ * These counters are incremented by dWorldStep() (dense), dWorldQuickStep()
+ * (quick) and dWorldAutoStep() (either), once for every island stepped.
+ * @param dense if nonzero, receives the number of islands stepped with the
+ * dense LCP solver.
+ * @param quick if nonzero, receives the number of islands stepped with
+ * QuickStep.
+ */
+ODE_API void dWorldGetSolverIslandCounts (dWorldID, unsigned long *dense,
+                                          unsigned long *quick);
+
+/**
+ * @brief Set the counters of dWorldGetSolverIslandCounts() to 0.
+ * @ingroup world
+ */
+ODE_API void dWorldResetSolverIslandCounts (dWorldID);
+
+
 /**
  * @brief Set the number of iterations that the QuickStep method performs per
  *        step.
@@ -220,6 +276,161 @@ ODE_API void dWorldSetQuickStepW (dWorldID, dReal over_relaxation);
  */
 ODE_API dReal dWorldGetQuickStepW (dWorldID);
 
+/**
+ * @brief Set how much of the previous step's constraint forces QuickStep
+ * starts from.
+ * @ingroup world
+ * @remarks
+ * With warm starting, the SOR iterations start from the lambda (constraint
+ * force) each joint ended the previous step with, scaled by this factor,
+ * instead of from zero. Stacks and resting contacts then settle with far
+ * fewer iterations.
+ *
+ * Contact joints are usually destroyed after every step, so their lambda is
+ * kept in a contact cache owned by the world. It is keyed by geom pair and
+ * contact features (dContactGeom::side1 and side2), and among contacts with
+ * the same key the closest one within the warm start tolerance is used.
+ * Friction rows are only reused if the contact has the same number of rows
+ * and the geoms are the same way around.
+ *
+ * Warm starting can hurt with high-friction contacts, so a factor somewhat
+ * below 1 is recommended, e.g. 0.85.
+ * @param factor 0 (the default) disables warm starting, 1 is the maximum.
+ */
+ODE_API void dWorldSetQuickStepWarmStarting (dWorldID, dReal factor);
+
+/**
+ * @brief Get the QuickStep warm starting factor.
+ * @ingroup world
+ */
+ODE_API dReal dWorldGetQuickStepWarmStarting (dWorldID);
+
+/**
+ * @brief Set how far a contact can move between steps and still be matched
+ * up with its cached lambda for warm starting.
+ * @ingroup world
+ * @param distance The default is 0.05.
+ */
+ODE_API void dWorldSetQuickStepWarmStartTolerance (dWorldID, dReal distance);
+
+/**
+ * @brief Get the QuickStep warm start tolerance.
+ * @ingroup world
+ */
+ODE_API dReal dWorldGetQuickStepWarmStartTolerance (dWorldID);
+
+/**
+ * @brief Set the maximum number of threads used to step islands.
+ * @ingroup world
+ * @remarks
+ * Bodies that are not connected to each other through joints (directly or
+ * indirectly) form separate islands, which can be stepped independently.
+ * With a count above 1, dWorldStep() and dWorldQuickStep() first collect
+ * all islands and then step them concurrently on a pool of worker threads
+ * owned by the world (the calling thread is one of them).
+ *
+ * Body and joint tags and the auto-disable state are the same as with
+ * serial stepping. Geom dirtying and body moved callbacks are deferred
+ * until all islands have been stepped, and are then issued on the calling
+ * thread in the serial order. The constraint reordering of QuickStep
+ * draws from a per-island random sequence (seeded from dRand()) instead of
+ * dRand() itself, so the trajectories do not match serial stepping bit for
+ * bit, but they are the same for every count above 1.
+ *
+ * Every thread takes the temporaries of its islands from its own memory
+ * arena, see dWorldGetStepMemoryStats().
+ * @param count 1 (the default) steps all islands on the calling thread.
+ */
+ODE_API void dWorldSetStepIslandsProcessingMaxThreadCount (dWorldID, int count);
+
+/**
+ * @brief Get the maximum number of threads used to step islands.
+ * @ingroup world
+ */
+ODE_API int dWorldGetStepIslandsProcessingMaxThreadCount (dWorldID);
+
+/**
+ * @brief Memory used for the temporaries of the steppers.
+ * @ingroup world
+ * @see dWorldGetStepMemoryStats
+ */
+typedef struct dWorldStepMemoryStats {
+  size_t peak;			/**< most bytes in use at once */
+  size_t reserved;		/**< bytes currently held by the world */
+  unsigned long heap_allocations; /**< times memory was taken from the heap */
+} dWorldStepMemoryStats;
+
+/**
+ * @brief Get statistics on the memory used by dWorldStep() and
+ * dWorldQuickStep() for their temporaries.
+ * @ingroup world
+ * @remarks
+ * The steppers take their temporaries from per-thread arenas owned by the
+ * world (one per island thread) rather than from the stack, so the size of
+ * an island is not limited by the stack size. The arenas grow to the
+ * largest step that has been taken and keep that memory, so once the
+ * scene has settled, heap_allocations stops changing. The numbers are
+ * summed over all threads. They are kept for the life of the world.
+ */
+ODE_API void dWorldGetStepMemoryStats (dWorldID, dWorldStepMemoryStats *stats);
+
+/**
+ * @brief Buffers for the state of many bodies, see dWorldGetBodyStates().
+ * @ingroup world
+ * @remarks
+ * Each field is a pointer to the value of the first body, and the value of
+ * body i is i times the stride (in bytes) further on. A stride of 0 means
+ * the values are packed one after the other. Fields that are 0 are not
+ * copied.
+ */
+typedef struct dBodyStateBuffers {
+  dReal *pos;		/**< position, 3 dReals */
+  int pos_stride;
+  dReal *quat;		/**< orientation quaternion, 4 dReals (w,x,y,z) */
+  int quat_stride;
+  dReal *matrix;	/**< column-major 4x4 transform, 16 dReals */
+  int matrix_stride;
+  dReal *lvel;		/**< linear velocity, 3 dReals */
+  int lvel_stride;
+  dReal *avel;		/**< angular velocity, 3 dReals */
+  int avel_stride;
+} dBodyStateBuffers;
+
+/**
+ * @brief Copy the state of many bodies into caller-provided buffers.
+ * @ingroup world
+ * @remarks
+ * This is the same as calling dBodyGetPosition(), dBodyGetQuaternion(),
+ * dBodyGetRotation(), dBodyGetLinearVel() and dBodyGetAngularVel() for
+ * every body, but done in one pass, with the values going straight to
+ * wherever a renderer or a network layer wants them. The matrix is the
+ * rotation and position of the body in the layout that OpenGL's
+ * glMultMatrix() takes.
+ * @param bodies the bodies, which must all be in the world.
+ * @param count the number of bodies.
+ * @param buffers where the values go.
+ */
+ODE_API void dWorldGetBodyStates (dWorldID, const dBodyID *bodies, int count,
+				  const dBodyStateBuffers *buffers);
+
+/**
+ * @brief Set the state of many bodies from caller-provided buffers.
+ * @ingroup world
+ * @remarks
+ * This is the reverse of dWorldGetBodyStates(), and is the same as calling
+ * dBodySetPosition(), dBodySetQuaternion(), dBodySetRotation(),
+ * dBodySetLinearVel() and dBodySetAngularVel() for every body, except that
+ * the geoms of a body are only told once that it has moved. The rotation
+ * and position in a matrix are used as they are in dBodySetRotation() and
+ * dBodySetPosition(), so a matrix can not be given together with positions
+ * or quaternions. The bodies are not enabled.
+ * @param bodies the bodies, which must all be in the world.
+ * @param count the number of bodies.
+ * @param buffers where the values come from.
+ */
+ODE_API void dWorldSetBodyStates (dWorldID, const dBodyID *bodies, int count,
+				  const dBodyStateBuffers *buffers);
+
 /* World contact parameter functions */
 
 /**
@@ -1489,6 +1700,34 @@ ODE_API void dJointDestroy (dJointID);
  */
 ODE_API dJointGroupID dJointGroupCreate (int max_size);
 
+/**
+ * @brief Create a joint group for the contact joints of a world.
+ * @ingroup joints
+ *
+ * This is a joint group for the contacts that are made in every step and
+ * thrown away after it. The contacts are kept in blocks that are reused
+ * when the group is emptied, so dJointGroupEmpty() takes constant time and
+ * frees nothing. The contacts are not in the world's joint list, and are
+ * only linked to their bodies while the world is stepped, which saves
+ * putting every contact in those lists and taking it out again.
+ *
+ * Only contact joints of @a world can be created in the group, with
+ * dJointCreateContact() or dJointCreateContacts(). They are stepped by
+ * dWorldStep(), dWorldQuickStep() and dWorldAutoStep(), but not by
+ * dWorldStepFast1(). As they are not in their bodies' joint lists,
+ * dBodyGetNumJoints(), dBodyGetJoint() and dAreConnected() do not see
+ * them. Destroying a body detaches it from the contacts of the group, which
+ * takes time proportional to the number of contacts in the group, so it is
+ * best done while the group is empty.
+ *
+ * The group must be destroyed with dJointGroupDestroy() before the world
+ * is, or any time after.
+ *
+ * @param world the world of the contacts.
+ * @return the new group.
+ */
+ODE_API dJointGroupID dContactGroupCreate (dWorldID world);
+
 /**
  * @brief Destroy a joint group.
  * @ingroup joints
@@ -39,9 +39,11 @@
 #include <ode/mass.h>
 #include <ode/misc.h>
 #include <ode/objects.h>
+#include <ode/profile.h>
 #include <ode/odecpp.h>
 #include <ode/collision_space.h>
 #include <ode/collision.h>
+#include <ode/batch.h>
 #include <ode/odecpp_collision.h>
 #include <ode/export-dif.h>
 
@@ -0,0 +1,191 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+#ifndef _ODE_PROFILE_H_
+#define _ODE_PROFILE_H_
+
+#include <ode/common.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup profile Profiling
+ *
+ * A world can measure where the time of a simulation frame goes. Profiling
+ * is always compiled in; while it is off for a world, the instrumented code
+ * only tests a pointer.
+ *
+ * A frame ends with every call of dWorldStep(), dWorldQuickStep(),
+ * dWorldAutoStep() or dWorldStepFast1(), and covers everything profiled
+ * since the previous one, including the collision detection of spaces
+ * that report to the world (see dSpaceSetProfilingWorld()).
+ *
+ * Times are exclusive: when a zone runs inside another one (the
+ * narrowphase inside the broadphase, for instance), its time is not
+ * counted again for the outer zone. Zones that run on several threads at
+ * once are summed over the threads.
+ */
+
+/**
+ * @brief The zones that the time of a frame is split into.
+ * @ingroup profile
+ */
+enum {
+  dProfileBroadphase = 0,	/**< dSpaceCollide(), dSpaceCollide2() and the
+				   near callbacks, except for dCollide() */
+  dProfileNarrowphase,		/**< dCollide() inside the above */
+  dProfileIslands,		/**< finding the islands and bookkeeping around
+				   the steppers. with several island threads
+				   this includes the time the calling thread
+				   waits for the others */
+  dProfileJacobian,		/**< assembling the constraint Jacobian, the
+				   right hand side and the LCP matrix */
+  dProfileSolver,		/**< the LCP solver (SOR iterations for
+				   QuickStep) */
+  dProfileIntegrate,		/**< velocity and position update */
+
+  dProfileNumZones
+};
+
+/** @brief Number of buckets of dProfileZoneStats::histogram. @ingroup profile */
+#define dPROFILE_HISTOGRAM_BUCKETS 16
+
+/**
+ * @brief Statistics of one zone, see dWorldGetProfileZoneStats().
+ * @ingroup profile
+ */
+typedef struct dProfileZoneStats {
+  unsigned long frames;		/**< frames in which the zone ran */
+  unsigned long calls;		/**< times the zone was entered */
+  double total;			/**< seconds, over all frames */
+  double last;			/**< seconds in the last frame */
+  double max;			/**< most seconds in one frame */
+  /** number of frames by time spent in the zone: bucket 0 counts frames
+   * below 1 microsecond, bucket i those from 2^(i-1) up to 2^i
+   * microseconds, and the last bucket everything longer. */
+  unsigned long histogram[dPROFILE_HISTOGRAM_BUCKETS];
+} dProfileZoneStats;
+
+/**
+ * @brief Narrowphase statistics of one pair of geom classes, see
+ * dWorldGetProfilePairStats().
+ * @ingroup profile
+ */
+typedef struct dProfilePairStats {
+  unsigned long calls;		/**< dCollide() calls for the pair */
+  unsigned long contacts;	/**< contacts they returned */
+  double total;			/**< seconds spent in them */
+} dProfilePairStats;
+
+
+/**
+ * @brief Turn profiling of a world on or off.
+ * @ingroup profile
+ * @remarks
+ * Turning it off discards all statistics and the trace.
+ */
+ODE_API void dWorldSetProfiling (dWorldID, int enable);
+
+/**
+ * @brief Get whether a world is being profiled.
+ * @ingroup profile
+ */
+ODE_API int dWorldGetProfiling (dWorldID);
+
+/**
+ * @brief Set all statistics of a world's profile to 0 and clear the trace.
+ * @ingroup profile
+ */
+ODE_API void dWorldResetProfile (dWorldID);
+
+/**
+ * @brief Get the statistics of a zone.
+ * @ingroup profile
+ * @param zone one of the dProfileXXX zones.
+ * @remarks
+ * All fields are 0 if the world is not being profiled.
+ */
+ODE_API void dWorldGetProfileZoneStats (dWorldID, int zone,
+                                        dProfileZoneStats *stats);
+
+/**
+ * @brief Get the narrowphase statistics of a pair of geom classes.
+ * @ingroup profile
+ * @remarks
+ * The pair is ordered as the geoms were passed to dCollide(), so
+ * (dSphereClass, dBoxClass) and (dBoxClass, dSphereClass) are counted
+ * apart. These statistics are kept over all frames.
+ */
+ODE_API void dWorldGetProfilePairStats (dWorldID, int class1, int class2,
+                                        dProfilePairStats *stats);
+
+/**
+ * @brief Get the name of a zone, e.g. "broadphase".
+ * @ingroup profile
+ */
+ODE_API const char *dProfileZoneName (int zone);
+
+/**
+ * @brief Report the collision detection of a space to a world's profile.
+ * @ingroup profile
+ * @remarks
+ * Spaces do not belong to a world, so this links them. It affects
+ * dSpaceCollide() on the space and dSpaceCollide2() where either argument
+ * is the space, including the dCollide() calls of the near callback. The
+ * world must outlive the link; pass 0 to remove it.
+ */
+ODE_API void dSpaceSetProfilingWorld (dSpaceID, dWorldID);
+
+/**
+ * @brief Get the world a space reports its collision detection to.
+ * @ingroup profile
+ */
+ODE_API dWorldID dSpaceGetProfilingWorld (dSpaceID);
+
+/**
+ * @brief Record the zones of a world's profile as a trace.
+ * @ingroup profile
+ * @remarks
+ * While tracing, every zone that is entered is recorded with its thread,
+ * start and duration, until max_events have been recorded. The trace can
+ * be written out with dWorldWriteProfileTrace(). Tracing only works while
+ * the world is being profiled.
+ * @param max_events 0 stops tracing and discards the trace.
+ */
+ODE_API void dWorldSetProfileTrace (dWorldID, int max_events);
+
+/**
+ * @brief Write the trace of a world's profile in the Chrome trace event
+ * format (JSON), which chrome://tracing and Perfetto can load.
+ * @ingroup profile
+ * @return the number of events written.
+ */
+ODE_API int dWorldWriteProfileTrace (dWorldID, FILE *f);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
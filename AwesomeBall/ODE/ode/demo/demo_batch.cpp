@@ -0,0 +1,217 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+/*
+
+headless check of dSpaceCollectContacts() against a near callback that
+collides the same space with dSpaceCollide(). every scene is collided both
+ways and one line of JSON is printed for it, e.g.
+
+  demo_batch -seed 3
+
+options:
+
+  -seed <n>		seed for dRandSetSeed (default 0)
+
+the near callback pairs the geoms of a sub-space with what overlaps it
+through dSpaceCollide2(), and the geoms inside every sub-space are collided
+once. both ways must find the same pairs, each exactly once, with the same
+contacts. the program exits with 1 if any scene differs.
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <ode/ode.h>
+#include <vector>
+#include <algorithm>
+
+#ifdef _MSC_VER
+#pragma warning(disable:4244 4305)  // for VC++, no precision loss complaints
+#endif
+
+
+#define MAX_CONTACTS 4
+
+
+// a colliding pair, with the geoms in increasing address order
+
+struct Pair {
+  dGeomID g1,g2;
+  int count;
+  dReal depth;		// sum of the contact depths
+
+  bool operator< (const Pair &p) const
+  {
+    if (g1 != p.g1) return g1 < p.g1;
+    return g2 < p.g2;
+  }
+};
+
+static Pair makePair (dGeomID g1, dGeomID g2, const dContactGeom *contact,
+		      int count)
+{
+  Pair p;
+  p.g1 = (g1 < g2) ? g1 : g2;
+  p.g2 = (g1 < g2) ? g2 : g1;
+  p.count = count;
+  p.depth = 0;
+  for (int i=0; i<count; i++) p.depth += contact[i].depth;
+  return p;
+}
+
+
+// the reference: a near callback
+
+static void nearCallback (void *data, dGeomID o1, dGeomID o2)
+{
+  if (dGeomIsSpace (o1) || dGeomIsSpace (o2)) {
+    dSpaceCollide2 (o1,o2,data,&nearCallback);
+    return;
+  }
+  dContactGeom contact[MAX_CONTACTS];
+  int n = dCollide (o1,o2,MAX_CONTACTS,contact,sizeof(dContactGeom));
+  if (n > 0) ((std::vector<Pair>*) data)->push_back (makePair (o1,o2,contact,n));
+}
+
+
+static void collideSubSpaces (dSpaceID space, std::vector<Pair> *pairs)
+{
+  for (int i=0; i<dSpaceGetNumGeoms (space); i++) {
+    dGeomID g = dSpaceGetGeom (space,i);
+    if (dGeomIsSpace (g)) {
+      dSpaceCollide ((dSpaceID) g,pairs,&nearCallback);
+      collideSubSpaces ((dSpaceID) g,pairs);
+    }
+  }
+}
+
+
+// collide `space' both ways and compare. `a' and `b', if given, must touch
+// exactly once.
+
+static int checkScene (const char *name, dSpaceID space,
+		       dGeomID a = 0, dGeomID b = 0)
+{
+  std::vector<Pair> ref;
+  dSpaceCollide (space,&ref,&nearCallback);
+  collideSubSpaces (space,&ref);
+
+  std::vector<Pair> batched;
+  dContactBatchID batch = dContactBatchCreate (MAX_CONTACTS);
+  dSpaceCollectContacts (space,batch);
+  const dContactBatchPair *bp = dContactBatchGetPairs (batch);
+  const dContactGeom *contacts = dContactBatchGetContacts (batch);
+  for (int i=0; i<dContactBatchGetNumPairs (batch); i++)
+    batched.push_back (makePair (bp[i].g1,bp[i].g2,contacts + bp[i].first,
+				 bp[i].count));
+  dContactBatchDestroy (batch);
+
+  std::sort (ref.begin(),ref.end());
+  std::sort (batched.begin(),batched.end());
+  int ok = (ref.size() == batched.size());
+  for (size_t i=0; ok && i<ref.size(); i++) {
+    if (ref[i].g1 != batched[i].g1 || ref[i].g2 != batched[i].g2 ||
+	ref[i].count != batched[i].count ||
+	fabs (ref[i].depth - batched[i].depth) > 1e-5) ok = 0;
+    if (i > 0 && !(ref[i-1] < ref[i])) ok = 0;	// a pair found twice
+  }
+
+  int ab = -1;
+  if (a && b) {
+    ab = 0;
+    for (size_t i=0; i<batched.size(); i++) {
+      if ((batched[i].g1 == a && batched[i].g2 == b) ||
+	  (batched[i].g1 == b && batched[i].g2 == a)) ab++;
+    }
+    if (ab != 1) ok = 0;
+  }
+
+  printf ("{\"scene\":\"%s\",\"pairs\":%d,\"batch_pairs\":%d,\"ab_pairs\":%d,"
+	  "\"ok\":%d}\n",name,(int) ref.size(),(int) batched.size(),ab,ok);
+  return ok;
+}
+
+
+// spheres at random in a box
+
+static void addSpheres (dSpaceID space, int n, dReal size)
+{
+  for (int i=0; i<n; i++) {
+    dGeomID g = dCreateSphere (space,REAL(0.2) + dRandReal()*REAL(0.3));
+    dGeomSetPosition (g,dRandReal()*size,dRandReal()*size,dRandReal()*size);
+  }
+}
+
+
+int main (int argc, char **argv)
+{
+  unsigned long seed = 0;
+  for (int i=1; i<argc; i++) {
+    if (strcmp (argv[i],"-seed")==0 && i+1 < argc) seed = atol (argv[++i]);
+    else {
+      fprintf (stderr,"usage: %s [-seed <n>]\n",argv[0]);
+      exit (1);
+    }
+  }
+
+  dInitODE();
+  dRandSetSeed (seed);
+  int ok = 1;
+
+  // a flat space
+  dSpaceID space = dHashSpaceCreate (0);
+  dCreatePlane (space,0,0,1,REAL(0.5));
+  addSpheres (space,300,8);
+  ok &= checkScene ("flat",space);
+  dSpaceDestroy (space);
+
+  // spaces nested two deep, overlapping each other
+  space = dHashSpaceCreate (0);
+  dSpaceID sub = dSimpleSpaceCreate (space);
+  dSpaceID subsub = dSweepAndPruneSpaceCreate (sub,dSAP_AXES_XYZ);
+  dCreatePlane (space,0,0,1,REAL(0.5));
+  addSpheres (space,100,8);
+  addSpheres (sub,100,8);
+  addSpheres (subsub,100,8);
+  ok &= checkScene ("nested",space);
+  dSpaceDestroy (space);
+
+  // a sub-space that nothing else overlaps, holding two touching spheres
+  space = dSimpleSpaceCreate (0);
+  sub = dSimpleSpaceCreate (space);
+  dGeomID a = dCreateSphere (sub,1);
+  dGeomID b = dCreateSphere (sub,1);
+  dGeomSetPosition (b,REAL(1.5),0,0);
+  ok &= checkScene ("nested_alone",space,a,b);
+
+  // the same, with two geoms of the outer space overlapping the sub-space
+  dGeomSetPosition (dCreateSphere (space,REAL(0.5)),0,REAL(1.2),0);
+  dGeomSetPosition (dCreateSphere (space,REAL(0.5)),REAL(1.5),REAL(-1.2),0);
+  ok &= checkScene ("nested_overlapped",space,a,b);
+  dSpaceDestroy (space);
+
+  dCloseODE();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,554 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+/*
+
+headless benchmark of some of the demo scenes. every scene is stepped a
+fixed number of times without drawing and one line of JSON is printed for
+it, e.g.
+
+  demo_bench -n 2000 -s crash -solver auto
+
+options:
+
+  -n <steps>		steps per scene (default 1000)
+  -s <scene>		run only this scene (default all of them)
+  -seed <n>		seed for dRandSetSeed (default 0)
+  -solver <name>	quick, step or auto: override the stepper of the scene
+  -profile		also print the time spent in every profile zone
+
+the random numbers come from dRand, so runs with the same options build the
+same scenes. memory is measured by installing counting allocation handlers,
+so `peak_bytes' is the most memory ODE held at once (including the stepper
+arenas, see `arena_bytes').
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <ode/ode.h>
+
+#ifndef WIN32
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+
+#ifdef _MSC_VER
+#pragma warning(disable:4244 4305)  // for VC++, no precision loss complaints
+#endif
+
+
+// counting allocation handlers
+
+static size_t mem_current = 0;
+static size_t mem_peak = 0;
+
+static void *benchAlloc (size_t size)
+{
+  mem_current += size;
+  if (mem_current > mem_peak) mem_peak = mem_current;
+  return malloc (size);
+}
+
+static void *benchRealloc (void *ptr, size_t oldsize, size_t newsize)
+{
+  mem_current += newsize - oldsize;
+  if (mem_current > mem_peak) mem_peak = mem_current;
+  return realloc (ptr,newsize);
+}
+
+static void benchFree (void *ptr, size_t size)
+{
+  mem_current -= size;
+  free (ptr);
+}
+
+
+// a scene and the state shared by the collision callback
+
+enum Stepper { STEP_DEFAULT, STEP_QUICK, STEP_DENSE, STEP_AUTO };
+
+struct Scene {
+  const char *name;
+  void (*create) ();
+  void (*update) (int step);	// called before every step, may be 0
+  Stepper stepper;
+  dReal stepsize;
+};
+
+static dWorldID world;
+static dSpaceID space;
+static dJointGroupID contactgroup;
+static dSurfaceParameters surface;	// used for every contact of the scene
+static int max_contacts;		// per pair of geoms
+static unsigned long num_contacts;	// contacts created in this step
+static int num_bodies;			// bodies created by the scene
+
+#define MAX_CONTACTS 8
+
+
+static void nearCallback (void *, dGeomID o1, dGeomID o2)
+{
+  // exit without doing anything if the two bodies are connected by a joint
+  dBodyID b1 = dGeomGetBody(o1);
+  dBodyID b2 = dGeomGetBody(o2);
+  if (b1 && b2 && dAreConnectedExcluding (b1,b2,dJointTypeContact)) return;
+
+  dContact contact[MAX_CONTACTS];
+  int n = dCollide (o1,o2,max_contacts,&contact[0].geom,sizeof(dContact));
+  for (int i=0; i<n; i++) {
+    contact[i].surface = surface;
+    dJointID c = dJointCreateContact (world,contactgroup,contact+i);
+    dJointAttach (c,b1,b2);
+  }
+  num_contacts += n;
+}
+
+
+static void setupWorld (dReal gravity)
+{
+  world = dWorldCreate();
+  contactgroup = dJointGroupCreate (0);
+  dWorldSetGravity (world,0,0,gravity);
+  dWorldSetCFM (world,1e-5);
+  memset (&surface,0,sizeof(surface));
+  max_contacts = 4;
+  num_bodies = 0;
+}
+
+
+// drop a random box, sphere or capsule at (x,y,z), as demo_boxstack does
+
+static void dropObject (dReal x, dReal y, dReal z)
+{
+  dBodyID b = dBodyCreate (world);
+  num_bodies++;
+  dBodySetPosition (b,x,y,z);
+  dMatrix3 R;
+  dRFromAxisAndAngle (R,dRandReal()*2.0-1.0,dRandReal()*2.0-1.0,
+		      dRandReal()*2.0-1.0,dRandReal()*10.0-5.0);
+  dBodySetRotation (b,R);
+
+  dReal sides[3];
+  for (int k=0; k<3; k++) sides[k] = dRandReal()*0.5+0.1;
+
+  dMass m;
+  dGeomID g;
+  switch (dRandInt (3)) {
+  case 0:
+    dMassSetBox (&m,5.0,sides[0],sides[1],sides[2]);
+    g = dCreateBox (space,sides[0],sides[1],sides[2]);
+    break;
+  case 1:
+    sides[0] *= 0.5;
+    dMassSetSphere (&m,5.0,sides[0]);
+    g = dCreateSphere (space,sides[0]);
+    break;
+  default:
+    dMassSetCapsule (&m,5.0,3,sides[0],sides[1]);
+    g = dCreateCapsule (space,sides[0],sides[1]);
+    break;
+  }
+  dBodySetMass (b,&m);
+  dGeomSetBody (g,b);
+}
+
+
+// demo_space_stress: lots of spheres in a quadtree space
+
+static void createSpaceStress ()
+{
+  setupWorld (-0.5);
+  dVector3 center = {0,0,0,0};
+  dVector3 extents = {55,55,55,0};
+  space = dQuadTreeSpaceCreate (0,center,extents,6);
+  dCreatePlane (space,0,0,1,0);
+
+  surface.mode = dContactBounce | dContactSoftCFM;
+  surface.mu = dInfinity;
+  surface.bounce = 0.1;
+  surface.bounce_vel = 0.1;
+  surface.soft_cfm = 0.01;
+
+  for (int i=0; i<2000; i++) {
+    dBodyID b = dBodyCreate (world);
+    num_bodies++;
+    dBodySetPosition (b,dRandReal()*100-50,dRandReal()*100-50,
+		      dRandReal()*4+1);
+    dReal radius = dRandReal()*0.25+0.1;
+    dMass m;
+    dMassSetSphere (&m,5.0,radius);
+    dBodySetMass (b,&m);
+    dGeomSetBody (dCreateSphere (space,radius),b);
+  }
+}
+
+
+// demo_boxstack: a pile of mixed objects in a hash space, with auto-disable
+
+static void createBoxstack ()
+{
+  setupWorld (-0.5);
+  space = dHashSpaceCreate (0);
+  dCreatePlane (space,0,0,1,0);
+
+  dWorldSetAutoDisableFlag (world,1);
+  dWorldSetAutoDisableAverageSamplesCount (world,10);
+  dWorldSetLinearDamping (world,0.00001);
+  dWorldSetAngularDamping (world,0.005);
+  dWorldSetMaxAngularSpeed (world,200);
+  dWorldSetContactMaxCorrectingVel (world,0.1);
+  dWorldSetContactSurfaceLayer (world,0.001);
+
+  surface.mode = dContactBounce | dContactSoftCFM;
+  surface.mu = dInfinity;
+  surface.bounce = 0.1;
+  surface.bounce_vel = 0.1;
+  surface.soft_cfm = 0.01;
+  max_contacts = MAX_CONTACTS;
+
+  for (int i=0; i<100; i++)
+    dropObject (dRandReal()*2-1,dRandReal()*2-1,1+i*0.5);
+}
+
+
+// demo_crash: a cannon ball fired at a wall of boxes in an SAP space
+
+#define WALL_WIDTH 12
+#define WALL_HEIGHT 10
+#define WBOX_SIZE 1.0
+#define CANNON_X -10
+#define CANNON_Y 5
+
+static dBodyID cannon_ball;
+
+// the demo aims the cannon by hand, fire it at the middle of the wall
+
+static void fireCannon ()
+{
+  dMatrix3 R;
+  dRSetIdentity (R);
+  dBodySetPosition (cannon_ball,CANNON_X,CANNON_Y,1);
+  dBodySetRotation (cannon_ball,R);
+  dBodySetLinearVel (cannon_ball,-20,-2*CANNON_Y,4);
+  dBodySetAngularVel (cannon_ball,0,0,0);
+  dBodyEnable (cannon_ball);
+}
+
+static void createCrash ()
+{
+  setupWorld (-1.5);
+  space = dSweepAndPruneSpaceCreate (0,dSAP_AXES_XYZ);
+  dCreatePlane (space,0,0,1,0);
+  dWorldSetERP (world,0.8);
+  dWorldSetQuickStepNumIterations (world,20);
+
+  surface.mode = dContactSlip1 | dContactSlip2 | dContactSoftERP |
+    dContactSoftCFM | dContactApprox1;
+  surface.mu = 0.5;
+  surface.slip1 = 0.0;
+  surface.slip2 = 0.0;
+  surface.soft_erp = 0.8;
+  surface.soft_cfm = 0.01;
+
+  // the wall, narrowing towards the top
+  dMass m;
+  dMassSetBox (&m,1,WBOX_SIZE,WBOX_SIZE,WBOX_SIZE);
+  for (dReal z = WBOX_SIZE/2.0; z <= WALL_HEIGHT; z += WBOX_SIZE) {
+    for (dReal y = (-WALL_WIDTH+z)/2; y <= (WALL_WIDTH-z)/2; y += WBOX_SIZE) {
+      dBodyID b = dBodyCreate (world);
+      num_bodies++;
+      dBodySetPosition (b,-20,y,z);
+      dBodySetMass (b,&m);
+      dGeomID g = dCreateBox (space,WBOX_SIZE,WBOX_SIZE,WBOX_SIZE);
+      dGeomSetBody (g,b);
+    }
+  }
+
+  cannon_ball = dBodyCreate (world);
+  num_bodies++;
+  dMassSetSphereTotal (&m,10,0.5);
+  dBodySetMass (cannon_ball,&m);
+  dGeomSetBody (dCreateSphere (space,0.5),cannon_ball);
+  fireCannon ();
+}
+
+static void updateCrash (int step)
+{
+  if (step > 0 && step % 200 == 0) fireCannon ();
+}
+
+
+// demo_chain2: chains of boxes connected by ball joints, pushed around
+
+#define CHAINS 10
+#define CHAIN_LENGTH 10
+#define SIDE (0.2f)
+
+static dBodyID chain[CHAINS][CHAIN_LENGTH];
+
+static void createChain2 ()
+{
+  setupWorld (-0.5);
+  space = dHashSpaceCreate (0);
+  dCreatePlane (space,0,0,1,0);
+
+  surface.mode = 0;
+  surface.mu = dInfinity;
+  max_contacts = 1;
+
+  dMass m;
+  dMassSetBox (&m,1,SIDE,SIDE,SIDE);
+  dMassAdjust (&m,1);
+  for (int c=0; c<CHAINS; c++) {
+    dReal y = (c - CHAINS/2) * 4*SIDE;
+    for (int i=0; i<CHAIN_LENGTH; i++) {
+      dBodyID b = dBodyCreate (world);
+      num_bodies++;
+      dBodySetPosition (b,i*2*SIDE,y,2+c*0.1);
+      dBodySetMass (b,&m);
+      dGeomSetBody (dCreateBox (space,SIDE,SIDE,SIDE),b);
+      chain[c][i] = b;
+      if (i > 0) {
+	dJointID j = dJointCreateBall (world,0);
+	dJointAttach (j,chain[c][i-1],b);
+	dJointSetBallAnchor (j,(i-0.5)*2*SIDE,y,2+c*0.1);
+      }
+    }
+  }
+}
+
+static void updateChain2 (int step)
+{
+  dReal angle = step * 0.05;
+  for (int c=0; c<CHAINS; c++)
+    dBodyAddForce (chain[c][CHAIN_LENGTH-1],0,0,1.5*(sin(angle+c)+1.0));
+}
+
+
+// demo_heightfield: objects dropped on a procedural heightfield
+
+#define HFIELD_WSTEP 15
+#define HFIELD_DSTEP 31
+#define HFIELD_WIDTH REAL(4.0)
+#define HFIELD_DEPTH REAL(8.0)
+
+static dHeightfieldDataID heightid;
+
+static dReal heightfieldCallback (void *, int x, int z)
+{
+  dReal fx = (((dReal)x) - (HFIELD_WSTEP-1)/2) / (dReal)(HFIELD_WSTEP-1);
+  dReal fz = (((dReal)z) - (HFIELD_DSTEP-1)/2) / (dReal)(HFIELD_DSTEP-1);
+  return REAL(1.0) + (REAL(-16.0) * (fx*fx*fx + fz*fz*fz));
+}
+
+static void createHeightfield ()
+{
+  setupWorld (-0.05);
+  space = dHashSpaceCreate (0);
+  dCreatePlane (space,0,0,1,0);
+
+  dWorldSetAutoDisableFlag (world,1);
+  dWorldSetContactMaxCorrectingVel (world,0.1);
+  dWorldSetContactSurfaceLayer (world,0.001);
+
+  surface.mode = dContactBounce | dContactSoftCFM;
+  surface.mu = dInfinity;
+  surface.bounce = 0.1;
+  surface.bounce_vel = 0.1;
+  surface.soft_cfm = 0.01;
+  max_contacts = MAX_CONTACTS;
+
+  heightid = dGeomHeightfieldDataCreate();
+  dGeomHeightfieldDataBuildCallback (heightid,0,heightfieldCallback,
+				     HFIELD_WIDTH,HFIELD_DEPTH,
+				     HFIELD_WSTEP,HFIELD_DSTEP,
+				     REAL(1.0),REAL(0.0),REAL(0.0),0);
+  dGeomHeightfieldDataSetBounds (heightid,REAL(-4.0),REAL(+6.0));
+  dGeomID gheight = dCreateHeightfield (space,heightid,1);
+
+  // the heightfield is y up, the rest of the scene z up
+  dMatrix3 R;
+  dRFromAxisAndAngle (R,1,0,0,M_PI*0.5);
+  dGeomSetRotation (gheight,R);
+
+  for (int i=0; i<60; i++)
+    dropObject (dRandReal()*3-1.5,dRandReal()*6-3,2+i*0.2);
+}
+
+
+static const Scene scenes[] = {
+  {"space_stress", createSpaceStress, 0, STEP_QUICK, 0.05},
+  {"boxstack", createBoxstack, 0, STEP_QUICK, 0.02},
+  {"crash", createCrash, updateCrash, STEP_QUICK, 0.05},
+  {"chain2", createChain2, updateChain2, STEP_DENSE, 0.05},
+  {"heightfield", createHeightfield, 0, STEP_QUICK, 0.05},
+};
+
+#define NUM_SCENES ((int)(sizeof(scenes)/sizeof(scenes[0])))
+
+
+static int compareDouble (const void *a, const void *b)
+{
+  double x = *(const double*)a, y = *(const double*)b;
+  return (x < y) ? -1 : (x > y);
+}
+
+static long maxRSS ()
+{
+#ifndef WIN32
+  struct rusage usage;
+  if (getrusage (RUSAGE_SELF,&usage) == 0) return usage.ru_maxrss;
+#endif
+  return -1;
+}
+
+
+static void runScene (const Scene &scene, int steps, unsigned long seed,
+		      Stepper stepper, int profile)
+{
+  dRandSetSeed (seed);
+  mem_peak = mem_current;
+  scene.create();
+  if (profile) {
+    dWorldSetProfiling (world,1);
+    dSpaceSetProfilingWorld (space,world);
+  }
+  if (stepper == STEP_DEFAULT) stepper = scene.stepper;
+
+  double *times = (double*) malloc (steps * sizeof(double));
+  double total = 0;
+  unsigned long total_contacts = 0;
+
+  for (int i=0; i<steps; i++) {
+    if (scene.update) scene.update (i);
+
+    dStopwatch sw;
+    dStopwatchReset (&sw);
+    dStopwatchStart (&sw);
+    num_contacts = 0;
+    dSpaceCollide (space,0,&nearCallback);
+    switch (stepper) {
+    case STEP_DENSE: dWorldStep (world,scene.stepsize); break;
+    case STEP_AUTO: dWorldAutoStep (world,scene.stepsize); break;
+    default: dWorldQuickStep (world,scene.stepsize); break;
+    }
+    dJointGroupEmpty (contactgroup);
+    dStopwatchStop (&sw);
+
+    times[i] = dStopwatchTime (&sw);
+    total += times[i];
+    total_contacts += num_contacts;
+  }
+
+  qsort (times,steps,sizeof(double),compareDouble);
+  double p50 = times[steps/2];
+  double p99 = times[(steps*99)/100];
+  free (times);
+
+  dWorldStepMemoryStats arena;
+  dWorldGetStepMemoryStats (world,&arena);
+
+  printf ("{\"scene\":\"%s\",\"steps\":%d,\"bodies\":%d,\"seconds\":%.6f,"
+	  "\"steps_per_sec\":%.2f,\"contacts\":%lu,\"contacts_per_sec\":%.1f,"
+	  "\"p50_ms\":%.4f,\"p99_ms\":%.4f,\"peak_bytes\":%lu,"
+	  "\"arena_bytes\":%lu,\"maxrss\":%ld}\n",
+	  scene.name,steps,num_bodies,total,
+	  total > 0 ? steps/total : 0.0,total_contacts,
+	  total > 0 ? total_contacts/total : 0.0,
+	  p50*1000.0,p99*1000.0,(unsigned long) mem_peak,
+	  (unsigned long) arena.peak,maxRSS());
+
+  if (profile) {
+    for (int z=0; z<dProfileNumZones; z++) {
+      dProfileZoneStats stats;
+      dWorldGetProfileZoneStats (world,z,&stats);
+      printf ("  %-12s %10.3f ms %10.4f ms/frame max %8.4f ms\n",
+	      dProfileZoneName (z),stats.total*1000.0,
+	      stats.frames ? stats.total*1000.0/stats.frames : 0.0,
+	      stats.max*1000.0);
+    }
+  }
+
+  // the bodies detach themselves from their geoms when the world is
+  // destroyed, so the geoms and their space must still be there
+  dJointGroupDestroy (contactgroup);
+  dWorldDestroy (world);
+  dSpaceDestroy (space);
+  if (scene.create == createHeightfield) dGeomHeightfieldDataDestroy (heightid);
+}
+
+
+static void usage (const char *prog)
+{
+  fprintf (stderr,"usage: %s [-n steps] [-s scene] [-seed n] "
+	   "[-solver quick|step|auto] [-profile]\nscenes:",prog);
+  for (int i=0; i<NUM_SCENES; i++) fprintf (stderr," %s",scenes[i].name);
+  fprintf (stderr,"\n");
+  exit (1);
+}
+
+
+int main (int argc, char **argv)
+{
+  int steps = 1000;
+  const char *only = 0;
+  unsigned long seed = 0;
+  Stepper stepper = STEP_DEFAULT;
+  int profile = 0;
+
+  for (int i=1; i<argc; i++) {
+    if (strcmp (argv[i],"-n")==0 && i+1 < argc) steps = atoi (argv[++i]);
+    else if (strcmp (argv[i],"-s")==0 && i+1 < argc) only = argv[++i];
+    else if (strcmp (argv[i],"-seed")==0 && i+1 < argc)
+      seed = strtoul (argv[++i],0,10);
+    else if (strcmp (argv[i],"-solver")==0 && i+1 < argc) {
+      const char *s = argv[++i];
+      if (strcmp (s,"quick")==0) stepper = STEP_QUICK;
+      else if (strcmp (s,"step")==0) stepper = STEP_DENSE;
+      else if (strcmp (s,"auto")==0) stepper = STEP_AUTO;
+      else usage (argv[0]);
+    }
+    else if (strcmp (argv[i],"-profile")==0) profile = 1;
+    else usage (argv[0]);
+  }
+  if (steps < 1) usage (argv[0]);
+
+  dSetAllocHandler (benchAlloc);
+  dSetReallocHandler (benchRealloc);
+  dSetFreeHandler (benchFree);
+  dInitODE2 (0);
+
+  int ran = 0;
+  for (int i=0; i<NUM_SCENES; i++) {
+    if (only && strcmp (only,scenes[i].name) != 0) continue;
+    runScene (scenes[i],steps,seed,stepper,profile);
+    fflush (stdout);
+    ran++;
+  }
+  if (!ran) usage (argv[0]);
+
+  dCloseODE();
+  return 0;
+}
@@ -0,0 +1,217 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+// headless benchmark for parallel island stepping. a world is filled with
+// ISLANDS independent chains of boxes hanging from fixed points, and is
+// stepped with 1..MAXTHREADS island threads. every fourth chain hangs still
+// so that auto-disable puts it to sleep. the number of steps per second is
+// reported for each thread count, and every threaded run is checked:
+//   * the body/joint tags and the enabled state of every body must be the
+//     same as after the single thread (serial) run.
+//   * the final body positions must be identical to those of the two thread
+//     run. they are not compared with the serial run, because the threads
+//     give every island its own random number sequence.
+//
+// usage: demo_islands [islands] [steps] [maxthreads] [quick]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+#include <ode/ode.h>
+#include "../src/objects.h"
+#include "../src/joints/joint.h"
+
+#ifdef _MSC_VER
+#pragma warning(disable:4244 4305)  // for VC++, no precision loss complaints
+#endif
+
+// some constants
+
+#define ISLANDS 64		// default number of islands
+#define LINKS 12		// bodies per island
+#define STEPS 200		// default number of steps per run
+#define MAXTHREADS 8		// default largest thread count tried
+#define SIDE (0.2)		// side length of a box
+#define MASS (1.0)		// mass of a box
+#define STEPSIZE (0.01)
+
+
+static dWorldID world;
+static dJointGroupID joints;
+static dBodyID *body;
+static dJointID *joint;
+static int num_bodies;
+
+
+static double wallTime()
+{
+  struct timeval tv;
+  gettimeofday (&tv,0);
+  return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+
+static void createWorld (int islands)
+{
+  world = dWorldCreate();
+  dWorldSetGravity (world,0,0,-9.81);
+  dWorldSetQuickStepNumIterations (world,20);
+  // a chain that hangs still jitters a little in the joints, more than the
+  // default thresholds allow
+  dWorldSetAutoDisableFlag (world,1);
+  dWorldSetAutoDisableLinearThreshold (world,0.2);
+  dWorldSetAutoDisableAngularThreshold (world,0.2);
+  joints = dJointGroupCreate (0);
+
+  num_bodies = islands * LINKS;
+  body = (dBodyID*) malloc (num_bodies * sizeof(dBodyID));
+  joint = (dJointID*) malloc (num_bodies * sizeof(dJointID));
+
+  dMass m;
+  dMassSetBox (&m,1,SIDE,SIDE,SIDE);
+  dMassAdjust (&m,MASS);
+
+  for (int i=0; i<islands; i++) {
+    dReal x = (i % 8) * 2.0;
+    dReal y = (i / 8) * 2.0;
+    // give each island a slightly different sideways offset so that the
+    // chains swing, except every fourth one, which hangs straight down
+    dReal offset = (i % 4 == 3) ? 0 : SIDE*(0.1 + 0.01*(i%7));
+    dBodyID prev = 0;
+    for (int j=0; j<LINKS; j++) {
+      dBodyID b = dBodyCreate (world);
+      dBodySetMass (b,&m);
+      dBodySetPosition (b,x + (j+1)*offset,y,10 - j*SIDE);
+      body[i*LINKS+j] = b;
+
+      dJointID jt = dJointCreateBall (world,joints);
+      dJointAttach (jt,b,prev);
+      dJointSetBallAnchor (jt,x + j*offset,y,10 - j*SIDE + SIDE*0.5);
+      joint[i*LINKS+j] = jt;
+      prev = b;
+    }
+  }
+}
+
+
+static void destroyWorld()
+{
+  dJointGroupDestroy (joints);
+  dWorldDestroy (world);
+  free (body);
+  free (joint);
+}
+
+
+// run the scene, and store the final body positions in `result' and the
+// body tags, body enabled flags and joint tags in `state'.
+
+static double run (int islands, int steps, int threads, int quick,
+		   dReal *result, int *state)
+{
+  dRandSetSeed (0);
+  createWorld (islands);
+  dWorldSetStepIslandsProcessingMaxThreadCount (world,threads);
+
+  double start = wallTime();
+  for (int i=0; i<steps; i++) {
+    if (quick) dWorldQuickStep (world,STEPSIZE);
+    else dWorldStep (world,STEPSIZE);
+  }
+  double elapsed = wallTime() - start;
+
+  for (int i=0; i<num_bodies; i++) {
+    const dReal *pos = dBodyGetPosition (body[i]);
+    result[i*3+0] = pos[0];
+    result[i*3+1] = pos[1];
+    result[i*3+2] = pos[2];
+    state[i*3+0] = body[i]->tag;
+    state[i*3+1] = dBodyIsEnabled (body[i]);
+    state[i*3+2] = joint[i]->tag;
+  }
+  destroyWorld();
+  return elapsed;
+}
+
+
+int main (int argc, char **argv)
+{
+  int islands = (argc > 1) ? atoi (argv[1]) : ISLANDS;
+  int steps = (argc > 2) ? atoi (argv[2]) : STEPS;
+  int maxthreads = (argc > 3) ? atoi (argv[3]) : MAXTHREADS;
+  int quick = (argc > 4) ? atoi (argv[4]) : 1;
+  if (islands < 1) islands = 1;
+  if (steps < 1) steps = 1;
+  if (maxthreads < 1) maxthreads = 1;
+
+  dInitODE2(0);
+
+  int n = islands * LINKS * 3;
+  dReal *reference = (dReal*) malloc (n * sizeof(dReal));
+  dReal *result = (dReal*) malloc (n * sizeof(dReal));
+  int *serial_state = (int*) malloc (n * sizeof(int));
+  int *state = (int*) malloc (n * sizeof(int));
+
+  printf ("%d islands of %d bodies, %d steps, %s\n",islands,LINKS,steps,
+	  quick ? "dWorldQuickStep" : "dWorldStep");
+
+  int mismatch = 0;
+  double serial = 0;
+  for (int threads=1; threads<=maxthreads; threads++) {
+    double t = run (islands,steps,threads,quick,result,state);
+    const char *check = "";
+    const char *state_check = "";
+    if (threads == 1) {
+      serial = t;
+      memcpy (serial_state,state,n * sizeof(int));
+    }
+    else {
+      if (memcmp (serial_state,state,n * sizeof(int)) == 0)
+	state_check = "states as serial";
+      else {
+	state_check = "STATE MISMATCH";
+	mismatch = 1;
+      }
+      if (threads == 2) {
+	memcpy (reference,result,n * sizeof(dReal));
+      }
+      else if (memcmp (reference,result,n * sizeof(dReal)) == 0) {
+	check = "identical";
+      }
+      else {
+	check = "MISMATCH";
+	mismatch = 1;
+      }
+    }
+    printf ("threads %2d: %8.3f s  %10.1f steps/s  x%.2f  %s  %s\n",threads,
+	    t,steps / t,serial / t,state_check,check);
+  }
+
+  free (reference);
+  free (result);
+  free (serial_state);
+  free (state);
+  dCloseODE();
+  return mismatch;
+}
@@ -0,0 +1,177 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+/*
+
+benchmark of dFactorLDLT() against dFactorLDLTUnblocked(), the factorizer
+it uses for small matrices. for every size from -min to -max (doubling) a
+random symmetric positive definite matrix is factored a number of times by
+both, and one line of JSON is printed, e.g.
+
+  demo_ldlt -min 16 -max 1024
+
+options:
+
+  -min <n>		smallest matrix size (default 16)
+  -max <n>		largest matrix size (default 1024)
+  -seed <n>		seed for dRandSetSeed (default 0)
+
+`*_ms' is the average time of a factorization, and `*_residual' is |A*x-b|/|b| for a
+random b solved with the factors, to check that the blocked factors are as
+good as the unblocked ones.
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <ode/ode.h>
+
+#ifdef _MSC_VER
+#pragma warning(disable:4244 4305)  // for VC++, no precision loss complaints
+#endif
+
+
+// A = M*M' + n*I, stored by rows with leading dimension nskip
+
+static void makeMatrix (dReal *A, int n, int nskip)
+{
+  dReal *M = (dReal*) malloc (n*nskip*sizeof(dReal));
+  for (int i=0; i<n*nskip; i++) M[i] = dRandReal() - REAL(0.5);
+  for (int i=0; i<n; i++) {
+    for (int j=0; j<=i; j++) {
+      dReal sum = 0;
+      for (int k=0; k<n; k++) sum += M[i*nskip+k] * M[j*nskip+k];
+      if (i == j) sum += n;
+      A[i*nskip+j] = sum;
+      A[j*nskip+i] = sum;
+    }
+  }
+  free (M);
+}
+
+
+// |A*x-b| / |b| for x solved from the factors L,d of A
+
+static double residual (const dReal *A, const dReal *L, const dReal *d,
+			int n, int nskip)
+{
+  dReal *b = (dReal*) malloc (n*sizeof(dReal));
+  dReal *x = (dReal*) malloc (n*sizeof(dReal));
+  for (int i=0; i<n; i++) b[i] = x[i] = dRandReal() - REAL(0.5);
+  dSolveLDLT (L,d,x,n,nskip);
+  double r = 0, bb = 0;
+  for (int i=0; i<n; i++) {
+    double sum = 0;
+    for (int j=0; j<n; j++) sum += A[i*nskip+j] * x[j];
+    r += (sum - b[i]) * (sum - b[i]);
+    bb += b[i] * b[i];
+  }
+  free (b);
+  free (x);
+  return sqrt (r / bb);
+}
+
+
+typedef void Factorizer (dReal *A, dReal *d, int n, int nskip);
+
+// the time of one factorization of A in seconds, averaged over `runs' of
+// them. the factors of the last one are left in L,d.
+
+static double timeFactor (Factorizer *factor, const dReal *A, dReal *L,
+			  dReal *d, int n, int nskip, int runs)
+{
+  // every run starts from a fresh copy of A. the time of the copies is
+  // measured separately and taken off.
+  dStopwatch copy,sw;
+  dStopwatchReset (&copy);
+  dStopwatchReset (&sw);
+  dStopwatchStart (&copy);
+  for (int r=0; r<runs; r++) memcpy (L,A,n*nskip*sizeof(dReal));
+  dStopwatchStop (&copy);
+  dStopwatchStart (&sw);
+  for (int r=0; r<runs; r++) {
+    memcpy (L,A,n*nskip*sizeof(dReal));
+    factor (L,d,n,nskip);
+  }
+  dStopwatchStop (&sw);
+  double t = dStopwatchTime (&sw) - dStopwatchTime (&copy);
+  return (t > 0) ? t/runs : 0;
+}
+
+
+static void usage (const char *prog)
+{
+  fprintf (stderr,"usage: %s [-min n] [-max n] [-seed n]\n",prog);
+  exit (1);
+}
+
+
+int main (int argc, char **argv)
+{
+  int min_n = 16, max_n = 1024;
+  unsigned long seed = 0;
+
+  for (int i=1; i<argc; i++) {
+    if (strcmp (argv[i],"-min")==0 && i+1 < argc) min_n = atoi (argv[++i]);
+    else if (strcmp (argv[i],"-max")==0 && i+1 < argc) max_n = atoi (argv[++i]);
+    else if (strcmp (argv[i],"-seed")==0 && i+1 < argc)
+      seed = strtoul (argv[++i],0,10);
+    else usage (argv[0]);
+  }
+  if (min_n < 1 || max_n < min_n) usage (argv[0]);
+
+  dInitODE2 (0);
+  dRandSetSeed (seed);
+
+  for (int n=min_n; n<=max_n; n*=2) {
+    const int nskip = dPAD(n);
+    dReal *A = (dReal*) malloc (n*nskip*sizeof(dReal));
+    dReal *L = (dReal*) malloc (n*nskip*sizeof(dReal));
+    dReal *d = (dReal*) malloc (n*sizeof(dReal));
+    makeMatrix (A,n,nskip);
+
+    // about the same total time for every size
+    int runs = (int) (1e9 / ((double)n*n*n + 1e4));
+    if (runs < 5) runs = 5;
+
+    double t_unblocked = timeFactor (dFactorLDLTUnblocked,A,L,d,n,nskip,runs);
+    double r_unblocked = residual (A,L,d,n,nskip);
+    double t_ldlt = timeFactor (dFactorLDLT,A,L,d,n,nskip,runs);
+    double r_ldlt = residual (A,L,d,n,nskip);
+
+    printf ("{\"n\":%d,\"runs\":%d,\"unblocked_ms\":%.4f,\"ldlt_ms\":%.4f,"
+	    "\"speedup\":%.2f,\"unblocked_residual\":%.3g,"
+	    "\"ldlt_residual\":%.3g}\n",
+	    n,runs,t_unblocked*1000.0,t_ldlt*1000.0,
+	    t_ldlt > 0 ? t_unblocked/t_ldlt : 0.0,r_unblocked,r_ldlt);
+    fflush (stdout);
+
+    free (A);
+    free (L);
+    free (d);
+  }
+
+  dCloseODE();
+  return 0;
+}
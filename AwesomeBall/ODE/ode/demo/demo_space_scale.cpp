@@ -0,0 +1,237 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+/*
+
+headless stress test of the hash space at large geom counts. for every size
+from -min to -max (times 10) a hash space (or a BVH space) is filled with randomly sized
+boxes and spheres at a constant density, some of them are moved every
+frame, and one line of JSON is printed, e.g.
+
+  demo_space_scale -min 1000 -max 100000 -frames 20
+
+options:
+
+  -min <n>		smallest number of geoms (default 1000)
+  -max <n>		largest number of geoms (default 100000)
+  -frames <n>		dSpaceCollide() calls per size (default 20)
+  -seed <n>		seed for dRandSetSeed (default 0)
+  -bvh			use a BVH space instead of the hash space
+  -check		also count the pairs with a sweep and prune space
+			holding the same geoms, which must find the same ones
+
+`peak_bytes' is the most memory ODE held at once, measured by counting
+allocation handlers. the hash space used to need an n*n bit table on the
+stack in every dSpaceCollide(), which is 1.2 GB at 100000 geoms.
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <ode/ode.h>
+
+#ifndef WIN32
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+
+#ifdef _MSC_VER
+#pragma warning(disable:4244 4305)  // for VC++, no precision loss complaints
+#endif
+
+
+// counting allocation handlers
+
+static size_t mem_current = 0;
+static size_t mem_peak = 0;
+
+static void *scaleAlloc (size_t size)
+{
+  mem_current += size;
+  if (mem_current > mem_peak) mem_peak = mem_current;
+  return malloc (size);
+}
+
+static void *scaleRealloc (void *ptr, size_t oldsize, size_t newsize)
+{
+  mem_current += newsize - oldsize;
+  if (mem_current > mem_peak) mem_peak = mem_current;
+  return realloc (ptr,newsize);
+}
+
+static void scaleFree (void *ptr, size_t size)
+{
+  mem_current -= size;
+  free (ptr);
+}
+
+
+static long maxRSS ()
+{
+#ifndef WIN32
+  struct rusage usage;
+  if (getrusage (RUSAGE_SELF,&usage) == 0) return usage.ru_maxrss;
+#endif
+  return -1;
+}
+
+
+// the near callback only counts the pairs whose AABBs overlap, like every
+// space is supposed to report them
+
+static unsigned long num_pairs;
+
+static void countPairs (void *, dGeomID o1, dGeomID o2)
+{
+  dReal a[6],b[6];
+  dGeomGetAABB (o1,a);
+  dGeomGetAABB (o2,b);
+  if (a[0] > b[1] || b[0] > a[1] || a[2] > b[3] || b[2] > a[3] ||
+      a[4] > b[5] || b[4] > a[5]) return;
+  num_pairs++;
+}
+
+
+// geoms take up about this fraction of the volume, whatever their number
+#define DENSITY 0.02
+// fraction of the geoms that move every frame
+#define MOVING 0.1
+
+static void randomPosition (dGeomID g, dReal side)
+{
+  dGeomSetPosition (g,dRandReal()*side,dRandReal()*side,dRandReal()*side);
+}
+
+
+static void runSize (int n, int frames, int check, int bvh)
+{
+  mem_peak = mem_current;
+  dSpaceID space;
+  if (bvh) space = dBVHSpaceCreate (0);
+  else {
+    space = dHashSpaceCreate (0);
+    dHashSpaceSetLevels (space,-2,4);
+  }
+  dGeomID *geoms = (dGeomID*) malloc (n*sizeof(dGeomID));
+
+  // sizes are 0.25..1.25, so about 0.5 cubic units per geom on average
+  const dReal side = (dReal) pow (n*0.5/DENSITY,1.0/3.0);
+  for (int i=0; i<n; i++) {
+    dReal size = REAL(0.25) + dRandReal();
+    if (i & 1) geoms[i] = dCreateSphere (space,size*REAL(0.5));
+    else geoms[i] = dCreateBox (space,size,size,size);
+    randomPosition (geoms[i],side);
+  }
+
+  const int moving = (int) (n*MOVING);
+  double total = 0, worst = 0;
+  unsigned long pairs = 0;
+  for (int f=0; f<frames; f++) {
+    for (int i=0; i<moving; i++) randomPosition (geoms[dRandInt (n)],side);
+    dStopwatch sw;
+    dStopwatchReset (&sw);
+    dStopwatchStart (&sw);
+    num_pairs = 0;
+    dSpaceCollide (space,0,&countPairs);
+    dStopwatchStop (&sw);
+    double t = dStopwatchTime (&sw);
+    total += t;
+    if (t > worst) worst = t;
+    pairs = num_pairs;
+  }
+
+  // the pairs of the last frame, found by another kind of space holding
+  // copies of the geoms
+  long check_pairs = -1;
+  if (check) {
+    dSpaceID sap = dSweepAndPruneSpaceCreate (0,dSAP_AXES_XYZ);
+    for (int i=0; i<n; i++) {
+      dGeomID g;
+      if (dGeomGetClass (geoms[i]) == dSphereClass)
+	g = dCreateSphere (sap,dGeomSphereGetRadius (geoms[i]));
+      else {
+	dVector3 lengths;
+	dGeomBoxGetLengths (geoms[i],lengths);
+	g = dCreateBox (sap,lengths[0],lengths[1],lengths[2]);
+      }
+      const dReal *pos = dGeomGetPosition (geoms[i]);
+      dGeomSetPosition (g,pos[0],pos[1],pos[2]);
+    }
+    num_pairs = 0;
+    dSpaceCollide (sap,0,&countPairs);
+    check_pairs = (long) num_pairs;
+    dSpaceDestroy (sap);
+  }
+
+  printf ("{\"space\":\"%s\",\"geoms\":%d,\"frames\":%d,\"ms_per_frame\":%.3f,\"max_ms\":%.3f,"
+	  "\"pairs\":%lu,\"check_pairs\":%ld,\"peak_bytes\":%lu,"
+	  "\"maxrss\":%ld}\n",
+	  bvh ? "bvh" : "hash",n,frames,total*1000.0/frames,worst*1000.0,pairs,check_pairs,
+	  (unsigned long) mem_peak,maxRSS());
+
+  dSpaceDestroy (space);
+  free (geoms);
+}
+
+
+static void usage (const char *prog)
+{
+  fprintf (stderr,"usage: %s [-min n] [-max n] [-frames n] [-seed n] "
+	   "[-bvh] [-check]\n",prog);
+  exit (1);
+}
+
+
+int main (int argc, char **argv)
+{
+  int min_n = 1000, max_n = 100000, frames = 20, check = 0, bvh = 0;
+  unsigned long seed = 0;
+
+  for (int i=1; i<argc; i++) {
+    if (strcmp (argv[i],"-min")==0 && i+1 < argc) min_n = atoi (argv[++i]);
+    else if (strcmp (argv[i],"-max")==0 && i+1 < argc) max_n = atoi (argv[++i]);
+    else if (strcmp (argv[i],"-frames")==0 && i+1 < argc)
+      frames = atoi (argv[++i]);
+    else if (strcmp (argv[i],"-seed")==0 && i+1 < argc)
+      seed = strtoul (argv[++i],0,10);
+    else if (strcmp (argv[i],"-bvh")==0) bvh = 1;
+    else if (strcmp (argv[i],"-check")==0) check = 1;
+    else usage (argv[0]);
+  }
+  if (min_n < 2 || max_n < min_n || frames < 1) usage (argv[0]);
+
+  dSetAllocHandler (scaleAlloc);
+  dSetReallocHandler (scaleRealloc);
+  dSetFreeHandler (scaleFree);
+  dInitODE2 (0);
+  dRandSetSeed (seed);
+
+  for (int n=min_n; n<=max_n; n*=10) {
+    runSize (n,frames,check,bvh);
+    fflush (stdout);
+  }
+
+  dCloseODE();
+  return 0;
+}
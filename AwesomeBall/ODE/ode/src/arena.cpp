@@ -0,0 +1,134 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+#include <ode/common.h>
+#include <ode/error.h>
+#include <ode/memory.h>
+#include "arena.h"
+#include "util.h"
+
+//****************************************************************************
+// dxArena
+
+#define BLOCK_ALLOC_SIZE(size) (sizeof(Block) + (size) + EFFICIENT_ALIGNMENT)
+
+
+dxArena::dxArena()
+{
+  first = 0;
+  current = 0;
+  used = 0;
+  peak = 0;
+  reserved = 0;
+  heap_allocations = 0;
+}
+
+
+dxArena::~dxArena()
+{
+  freeBlocks();
+}
+
+
+dxArena::Block *dxArena::newBlock (size_t min_size)
+{
+  // grow geometrically, so that few blocks are needed to reach the peak
+  size_t size = min_size;
+  if (size < dARENA_MIN_BLOCK_SIZE) size = dARENA_MIN_BLOCK_SIZE;
+  if (size < reserved) size = reserved;
+
+  Block *b = (Block*) dAlloc (BLOCK_ALLOC_SIZE(size));
+  b->next = 0;
+  b->size = size;
+  b->used = 0;
+  b->data = (char*) dEFFICIENT_SIZE ((size_t) (b+1));
+  reserved += size;
+  heap_allocations++;
+  return b;
+}
+
+
+void dxArena::freeBlocks()
+{
+  Block *b = first;
+  while (b) {
+    Block *next = b->next;
+    dFree (b,BLOCK_ALLOC_SIZE(b->size));
+    b = next;
+  }
+  first = 0;
+  current = 0;
+  reserved = 0;
+}
+
+
+void *dxArena::alloc (size_t num_bytes)
+{
+  size_t size = dEFFICIENT_SIZE(num_bytes);
+  Block *b = current;
+  if (!b || b->used + size > b->size) {
+    // all blocks after the current one are empty. take the first one that
+    // is big enough, or add a new one.
+    Block **link = current ? &current->next : &first;
+    while (*link && (*link)->size < size) link = &(*link)->next;
+    if (!*link) *link = newBlock (size);
+    b = current = *link;
+  }
+
+  void *p = b->data + b->used;
+  b->used += size;
+  used += size;
+  if (used > peak) peak = used;
+  return p;
+}
+
+
+dxArena::Marker dxArena::mark() const
+{
+  Marker m;
+  m.block = current;
+  m.block_used = current ? current->used : 0;
+  m.used = used;
+  return m;
+}
+
+
+void dxArena::release (const Marker &m)
+{
+  current = m.block;
+  if (current) current->used = m.block_used;
+  for (Block *b = current ? current->next : first; b; b = b->next) b->used = 0;
+  used = m.used;
+}
+
+
+void dxArena::reset()
+{
+  if (first && first->next) {
+    // replace the blocks by one that can hold everything at once
+    freeBlocks();
+    first = newBlock (peak);
+  }
+  if (first) first->used = 0;
+  current = 0;
+  used = 0;
+}
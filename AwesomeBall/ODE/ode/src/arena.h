@@ -0,0 +1,89 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+/*
+
+a growable, resettable arena for the temporaries of the island steppers.
+this is like dObStack, but blocks are sized to fit the requests (so there is
+no limit on the size of one allocation), and memory is released back to a
+marker in stack order. every thread that steps islands has its own arena.
+
+blocks are kept when memory is released, and reset() merges them into one
+block as large as the most memory ever used at once. so after the first
+few steps have grown the arena, stepping takes nothing from the heap.
+
+*/
+
+#ifndef _ODE_ARENA_H_
+#define _ODE_ARENA_H_
+
+#include "objects.h"
+
+// the smallest block that is taken from the heap
+#ifndef dARENA_MIN_BLOCK_SIZE
+#define dARENA_MIN_BLOCK_SIZE (64*1024)
+#endif
+
+
+struct dxArena : public dBase {
+  struct Block {
+    Block *next;		// next block in list, all later blocks are empty
+    size_t size;		// number of bytes at `data'
+    size_t used;		// number of bytes handed out from this block
+    char *data;			// block memory, EFFICIENT_ALIGNMENT aligned
+  };
+
+  struct Marker {
+    Block *block;		// block that was current, 0 if none
+    size_t block_used;		// its `used' field
+    size_t used;		// the arena's `used' field
+  };
+
+  Block *first;			// block list, 0 if no blocks yet
+  Block *current;		// block where memory is taken from, 0 if none
+  size_t used;			// number of bytes handed out from all blocks
+  size_t peak;			// most bytes that were handed out at once
+  size_t reserved;		// total size of all blocks
+  unsigned long heap_allocations; // number of blocks taken from the heap
+
+  dxArena();
+  ~dxArena();
+
+  void *alloc (size_t num_bytes);
+  // return num_bytes of memory aligned to EFFICIENT_ALIGNMENT, taking a new
+  // block from the heap if none of the remaining blocks is big enough.
+
+  Marker mark() const;
+  void release (const Marker &m);
+  // release all memory that was allocated since mark() returned m.
+
+  void reset();
+  // release all memory, and merge the blocks into a single block if there
+  // is more than one.
+
+private:
+  Block *newBlock (size_t min_size);
+  void freeBlocks();
+};
+
+
+#endif
@@ -0,0 +1,386 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+/*
+
+material tables and contact batches.
+
+dSpaceCollectContacts() runs in two passes: the broadphase only records the
+pairs it finds (pairing the geoms of a sub-space with what overlaps it, and
+colliding the inside of every sub-space once), and the narrowphase then
+goes through the recorded pairs and writes their contacts one after the
+other into the batch. keeping the two apart means the broadphase walks the
+space without calling out, and the narrowphase works through a flat list.
+
+the narrowphase also looks for runs of consecutive sphere-plane or
+sphere-sphere pairs, which is what a space full of balls in a box gives.
+a run goes to the batched sphere colliders of sphere.cpp in one call instead
+of through dCollide() pair by pair. the contacts are the same either way,
+except that sphere-plane depths can differ in the last bits where the
+compiler fuses multiply-adds in the scalar code only (see sphere.cpp).
+
+*/
+
+#include <ode/common.h>
+#include <ode/collision.h>
+#include <ode/objects.h>
+#include <ode/odemath.h>
+#include "config.h"
+#include "collision_kernel.h"
+#include "collision_std.h"
+#include "profile.h"
+#include "batch.h"
+
+//****************************************************************************
+// material tables
+
+dxMaterialTable::dxMaterialTable (int _num)
+{
+  num = _num;
+  surface = (dSurfaceParameters*) dAlloc (num*num*sizeof(dSurfaceParameters));
+  memset (surface,0,num*num*sizeof(dSurfaceParameters));
+  for (int i=0; i<num*num; i++) surface[i].mu = dInfinity;
+}
+
+
+dxMaterialTable::~dxMaterialTable()
+{
+  dFree (surface,num*num*sizeof(dSurfaceParameters));
+}
+
+
+dMaterialTableID dMaterialTableCreate (int num_materials)
+{
+  dUASSERT (num_materials > 0,"need at least one material");
+  return new dxMaterialTable (num_materials);
+}
+
+
+void dMaterialTableDestroy (dxMaterialTable *t)
+{
+  dAASSERT (t);
+  delete t;
+}
+
+
+int dMaterialTableGetNumMaterials (dxMaterialTable *t)
+{
+  dAASSERT (t);
+  return t->num;
+}
+
+
+void dMaterialTableSetSurface (dxMaterialTable *t, int m1, int m2,
+			       const dSurfaceParameters *surface)
+{
+  dAASSERT (t && surface);
+  dUASSERT (m1 >= 0 && m1 < t->num && m2 >= 0 && m2 < t->num,
+	    "material out of range");
+  t->surface[m1*t->num + m2] = *surface;
+  t->surface[m2*t->num + m1] = *surface;
+}
+
+
+void dMaterialTableGetSurface (dxMaterialTable *t, int m1, int m2,
+			       dSurfaceParameters *surface)
+{
+  dAASSERT (t && surface);
+  dUASSERT (m1 >= 0 && m1 < t->num && m2 >= 0 && m2 < t->num,
+	    "material out of range");
+  *surface = t->surface[m1*t->num + m2];
+}
+
+
+void dWorldSetMaterialTable (dxWorld *w, dxMaterialTable *t)
+{
+  dAASSERT (w);
+  w->materials = t;
+}
+
+
+dMaterialTableID dWorldGetMaterialTable (dxWorld *w)
+{
+  dAASSERT (w);
+  return w->materials;
+}
+
+
+void dWorldGetPairSurface (dxWorld *w, dxGeom *g1, dxGeom *g2,
+			   dSurfaceParameters *surface)
+{
+  dAASSERT (w && g1 && g2 && surface);
+  if (w->materials) {
+    *surface = *w->materials->get (g1->material,g2->material);
+  }
+  else {
+    memset (surface,0,sizeof(dSurfaceParameters));
+    surface->mu = dInfinity;
+  }
+}
+
+//****************************************************************************
+// contact batches
+
+dContactBatchID dContactBatchCreate (int max_contacts_per_pair)
+{
+  dUASSERT (max_contacts_per_pair > 0 &&
+	    max_contacts_per_pair <= NUMC_MASK,
+	    "bad number of contacts per pair");
+  dxContactBatch *b = new dxContactBatch;
+  b->max_contacts = max_contacts_per_pair;
+  return b;
+}
+
+
+void dContactBatchDestroy (dxContactBatch *b)
+{
+  dAASSERT (b);
+  delete b;
+}
+
+
+void dContactBatchReset (dxContactBatch *b)
+{
+  dAASSERT (b);
+  b->candidates.setSize (0);
+  b->pairs.setSize (0);
+  b->contacts.setSize (0);
+}
+
+
+int dContactBatchGetNumPairs (dxContactBatch *b)
+{
+  dAASSERT (b);
+  return b->pairs.size();
+}
+
+
+const dContactBatchPair *dContactBatchGetPairs (dxContactBatch *b)
+{
+  dAASSERT (b);
+  return b->pairs.data();
+}
+
+
+int dContactBatchGetNumContacts (dxContactBatch *b)
+{
+  dAASSERT (b);
+  return b->contacts.size();
+}
+
+
+const dContactGeom *dContactBatchGetContacts (dxContactBatch *b)
+{
+  dAASSERT (b);
+  return b->contacts.data();
+}
+
+
+// the broadphase pass: record every pair, and break pairs with spaces up.
+// only the geoms of the two sides are paired here. the pairs inside a
+// sub-space are collected once by collideSubSpaces(), however many geoms
+// overlap it.
+
+static void recordPair (void *data, dxGeom *g1, dxGeom *g2)
+{
+  if (IS_SPACE(g1) || IS_SPACE(g2)) {
+    dSpaceCollide2 (g1,g2,data,&recordPair);
+    return;
+  }
+  dxGeomPair pair;
+  pair.g1 = g1;
+  pair.g2 = g2;
+  ((dxContactBatch*)data)->candidates.push (pair);
+}
+
+
+// collect the pairs inside every space nested in `space', at any depth
+
+static void collideSubSpaces (dxSpace *space, dxContactBatch *b)
+{
+  for (dxGeom *g = space->first; g; g = g->next) {
+    if (IS_SPACE(g)) {
+      dSpaceCollide ((dxSpace*)g,b,&recordPair);
+      collideSubSpaces ((dxSpace*)g,b);
+    }
+  }
+}
+
+
+// the narrowphase pass: collide one pair, appending its contacts at `n'.
+// returns the new number of contacts.
+
+static int collidePair (dxContactBatch *b, dxGeom *g1, dxGeom *g2, int n)
+{
+  if (g1->body && g2->body &&
+      dAreConnectedExcluding (g1->body,g2->body,dJointTypeContact))
+    return n;
+
+  // make room for the most contacts the pair can have
+  const int max_contacts = b->max_contacts;
+  if (n + max_contacts > b->contacts.allocatedSize())
+    b->contacts.setSize (n + max_contacts);
+  int count = dCollide (g1,g2,max_contacts,b->contacts.data() + n,
+			sizeof(dContactGeom));
+  if (count > 0) {
+    dContactBatchPair pair;
+    pair.g1 = g1;
+    pair.g2 = g2;
+    pair.first = n;
+    pair.count = count;
+    b->pairs.push (pair);
+    n += count;
+  }
+  return n;
+}
+
+
+// the kinds of pairs that can make up a run
+
+enum {
+  RUN_NONE = 0,
+  RUN_SPHERE_PLANE,
+  RUN_SPHERE_SPHERE
+};
+
+#define MIN_RUN 4	// shorter runs just go to dCollide()
+#define MAX_RUN 64	// longer runs are tested in parts of this size
+
+
+static inline int runKind (const dxGeomPair &p)
+{
+  const int t1 = p.g1->type, t2 = p.g2->type;
+  if (t1 == dSphereClass) {
+    if (t2 == dSphereClass) return RUN_SPHERE_SPHERE;
+    if (t2 == dPlaneClass) return RUN_SPHERE_PLANE;
+  }
+  else if (t1 == dPlaneClass && t2 == dSphereClass) return RUN_SPHERE_PLANE;
+  return RUN_NONE;
+}
+
+
+// collide a run of `num' pairs of the given kind, like collidePair() would
+
+static int collideRun (dxContactBatch *b, const dxGeomPair *run, int num,
+		       int kind, int n)
+{
+  dxGeom *g1[MAX_RUN], *g2[MAX_RUN];
+  int index[MAX_RUN], count[MAX_RUN];
+  dIASSERT (num <= MAX_RUN);
+
+  // the pairs dCollide() would take, with the sphere first
+  int m = 0;
+  for (int i=0; i<num; i++) {
+    dxGeom *o1 = run[i].g1, *o2 = run[i].g2;
+    if (o1->body && o2->body) {
+      if (o1->body == o2->body ||
+	  dAreConnectedExcluding (o1->body,o2->body,dJointTypeContact))
+	continue;
+    }
+    o1->recomputePosr();
+    o2->recomputePosr();
+    if (o1->type != dSphereClass) {
+      dxGeom *tmp = o1;
+      o1 = o2;
+      o2 = tmp;
+    }
+    g1[m] = o1;
+    g2[m] = o2;
+    index[m] = i;
+    m++;
+  }
+
+  // every pair has one contact at most
+  if (n + m > b->contacts.allocatedSize()) b->contacts.setSize (n + m);
+  dContactGeom *contacts = b->contacts.data() + n;
+  if (kind == RUN_SPHERE_PLANE)
+    dCollideSpherePlaneBatch (g1,g2,m,contacts,count);
+  else
+    dCollideSphereSphereBatch (g1,g2,m,contacts,count);
+
+  for (int i=0, k=0; i<m; i++) {
+    if (count[i] == 0) continue;
+    const dxGeomPair &p = run[index[i]];
+    if (p.g1 != g1[i]) {
+      // the pair was turned around, turn its contact back like dCollide()
+      dContactGeom *c = contacts + k;
+      c->normal[0] = -c->normal[0];
+      c->normal[1] = -c->normal[1];
+      c->normal[2] = -c->normal[2];
+      dxGeom *tmp = c->g1;
+      c->g1 = c->g2;
+      c->g2 = tmp;
+      int tmpint = c->side1;
+      c->side1 = c->side2;
+      c->side2 = tmpint;
+    }
+    dContactBatchPair pair;
+    pair.g1 = p.g1;
+    pair.g2 = p.g2;
+    pair.first = n + k;
+    pair.count = 1;
+    b->pairs.push (pair);
+    k++;
+  }
+  for (int i=0; i<m; i++) n += count[i];
+  return n;
+}
+
+
+int dSpaceCollectContacts (dxSpace *space, dxContactBatch *b)
+{
+  dAASSERT (space && b);
+  dUASSERT (dGeomIsSpace(space),"argument not a space");
+
+  b->candidates.setSize (0);
+  dSpaceCollide (space,b,&recordPair);
+  collideSubSpaces (space,b);
+
+  // the narrowphase pass. the time between the dCollide() calls goes to
+  // the broadphase, like the near callback's would. the runs don't go
+  // through dCollide(), so their pairs are counted there as well.
+  dxProfileCollision profile (space->profile_world ?
+			      space->profile_world->profile : 0);
+
+  const dxGeomPair *candidates = b->candidates.data();
+  const int num_candidates = b->candidates.size();
+  const int first_contact = b->contacts.size();
+  int n = first_contact;
+  for (int i=0; i<num_candidates; ) {
+    const int kind = runKind (candidates[i]);
+    int len = 1;
+    if (kind != RUN_NONE) {
+      while (i+len < num_candidates && len < MAX_RUN &&
+	     runKind (candidates[i+len]) == kind) len++;
+    }
+    if (len >= MIN_RUN) {
+      n = collideRun (b,candidates+i,len,kind,n);
+      i += len;
+    }
+    else {
+      n = collidePair (b,candidates[i].g1,candidates[i].g2,n);
+      i++;
+    }
+  }
+  b->contacts.setSize (n);
+  return n - first_contact;
+}
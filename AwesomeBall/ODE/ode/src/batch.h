@@ -0,0 +1,65 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+// material tables and contact batches, see include/ode/batch.h.
+
+#ifndef _ODE_BATCH_INTERNAL_H_
+#define _ODE_BATCH_INTERNAL_H_
+
+#include <ode/common.h>
+#include <ode/contact.h>
+#include <ode/batch.h>
+#include "objects.h"
+#include "array.h"
+
+
+struct dxMaterialTable : public dBase {
+  int num;			// number of materials
+  dSurfaceParameters *surface;	// num*num surfaces, symmetric
+
+  dxMaterialTable (int _num);
+  ~dxMaterialTable();
+
+  // materials outside of the table are treated as material 0
+  const dSurfaceParameters *get (int m1, int m2) const {
+    if (m1 >= num) m1 = 0;
+    if (m2 >= num) m2 = 0;
+    return surface + m1*num + m2;
+  }
+};
+
+
+// a pair of geoms reported by the broadphase
+struct dxGeomPair {
+  dxGeom *g1, *g2;
+};
+
+
+struct dxContactBatch : public dBase {
+  int max_contacts;		// per pair, passed to dCollide()
+  dArray<dxGeomPair> candidates;// broadphase pairs of the last collection
+  dArray<dContactBatchPair> pairs;
+  dArray<dContactGeom> contacts;
+};
+
+
+#endif
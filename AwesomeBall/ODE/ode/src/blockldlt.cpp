@@ -0,0 +1,255 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+/*
+
+blocked L*D*L' factorization, for the big matrices of large islands.
+
+dFactorLDLTUnblocked() in fastldlt.c goes through the matrix two rows at a
+time, and every row is solved against all the rows above it. once the
+matrix no longer fits in the cache, every pair of rows reads the whole
+factor computed so far. the blocked version is right-looking: for every
+block of BLOCK columns it
+
+  1. factors the diagonal block with dFactorLDLTUnblocked(),
+  2. solves the rows below the block against it (the "panel"), and
+  3. subtracts the panel's outer product from the lower triangle of the
+     rest of the matrix.
+
+step 3 is where nearly all the time goes. it works on tiles of 4 rows by 8
+columns that stay in registers, using SSE or NEON in single precision if the
+compiler targets one of them (define dLDLT_NO_SIMD to always use the plain C
+loop). the sums are done in a different order than in the unblocked code,
+so the factors differ from it in the last bits.
+
+like the unblocked code, only the strict lower triangle of A is written.
+
+the work arrays grow with the size of the matrix, and island threads have
+small stacks, so they are taken from the stepper's arena if there is one and
+from the heap otherwise.
+
+*/
+
+#include <ode/common.h>
+#include <ode/matrix.h>
+#include "util.h"
+#include "config.h"
+#include "arena.h"
+#include "lcp.h"
+
+#if defined(dSINGLE) && !defined(dLDLT_NO_SIMD)
+#if defined(__SSE__) || defined(_M_IX86_FP) || defined(_M_X64)
+#include <xmmintrin.h>
+#define LDLT_SIMD_SSE 1
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define LDLT_SIMD_NEON 1
+#endif
+#endif
+
+// columns per block. the panel of a block is BLOCK columns of the rows below
+// it, so a tile of the update reads 4 rows and 8 columns of BLOCK values.
+#define BLOCK 32
+
+// smaller matrices go to dFactorLDLTUnblocked(), which is faster while the
+// whole matrix stays in the cache
+#define MIN_BLOCKED_SIZE 192
+
+
+// solve the panel rows against the factored diagonal block: for each of the
+// m rows `a' (BLOCK or fewer values at A + r*nskip), y = inverse(L) * a and
+// l = y .* d. l overwrites a, and y is written into column r of yt (with
+// leading dimension ldy), which the update reads a row at a time.
+
+static void solvePanel (const dReal *L, const dReal *d, dReal *A, int m,
+			int nb, int nskip, dReal *yt, int ldy)
+{
+  for (int r=0; r<m; r++) {
+    dReal *a = A + r*nskip;
+    for (int c=1; c<nb; c++) {
+      const dReal *ell = L + c*nskip;
+      dReal sum = 0;
+      for (int p=0; p<c; p++) sum += ell[p] * a[p];
+      a[c] -= sum;
+    }
+    for (int c=0; c<nb; c++) {
+      yt[c*ldy + r] = a[c];
+      a[c] *= d[c];
+    }
+  }
+}
+
+
+// A(i,j) -= sum_p l(i,p) * yt(p,j) for 4 rows i and 8 columns j. `l' points
+// at the panel of the first row and `a' at A(i,j) of the first row.
+
+static inline void updateTile (const dReal *l, const dReal *yt, dReal *a,
+			       int nb, int nskip, int ldy)
+{
+#if defined(LDLT_SIMD_SSE)
+  __m128 s00 = _mm_setzero_ps(), s01 = _mm_setzero_ps();
+  __m128 s10 = _mm_setzero_ps(), s11 = _mm_setzero_ps();
+  __m128 s20 = _mm_setzero_ps(), s21 = _mm_setzero_ps();
+  __m128 s30 = _mm_setzero_ps(), s31 = _mm_setzero_ps();
+  for (int p=0; p<nb; p++, yt += ldy) {
+    __m128 y0 = _mm_loadu_ps (yt), y1 = _mm_loadu_ps (yt+4);
+    __m128 l0 = _mm_set1_ps (l[p]), l1 = _mm_set1_ps (l[nskip+p]);
+    __m128 l2 = _mm_set1_ps (l[2*nskip+p]), l3 = _mm_set1_ps (l[3*nskip+p]);
+    s00 = _mm_add_ps (s00,_mm_mul_ps (l0,y0));
+    s01 = _mm_add_ps (s01,_mm_mul_ps (l0,y1));
+    s10 = _mm_add_ps (s10,_mm_mul_ps (l1,y0));
+    s11 = _mm_add_ps (s11,_mm_mul_ps (l1,y1));
+    s20 = _mm_add_ps (s20,_mm_mul_ps (l2,y0));
+    s21 = _mm_add_ps (s21,_mm_mul_ps (l2,y1));
+    s30 = _mm_add_ps (s30,_mm_mul_ps (l3,y0));
+    s31 = _mm_add_ps (s31,_mm_mul_ps (l3,y1));
+  }
+#define SUB_ROW(i,s0,s1) \
+  _mm_storeu_ps (a+i*nskip,_mm_sub_ps (_mm_loadu_ps (a+i*nskip),s0)); \
+  _mm_storeu_ps (a+i*nskip+4,_mm_sub_ps (_mm_loadu_ps (a+i*nskip+4),s1));
+  SUB_ROW(0,s00,s01) SUB_ROW(1,s10,s11) SUB_ROW(2,s20,s21) SUB_ROW(3,s30,s31)
+#undef SUB_ROW
+#elif defined(LDLT_SIMD_NEON)
+  float32x4_t s00 = vdupq_n_f32 (0), s01 = s00, s10 = s00, s11 = s00;
+  float32x4_t s20 = s00, s21 = s00, s30 = s00, s31 = s00;
+  for (int p=0; p<nb; p++, yt += ldy) {
+    float32x4_t y0 = vld1q_f32 (yt), y1 = vld1q_f32 (yt+4);
+    s00 = vmlaq_n_f32 (s00,y0,l[p]);
+    s01 = vmlaq_n_f32 (s01,y1,l[p]);
+    s10 = vmlaq_n_f32 (s10,y0,l[nskip+p]);
+    s11 = vmlaq_n_f32 (s11,y1,l[nskip+p]);
+    s20 = vmlaq_n_f32 (s20,y0,l[2*nskip+p]);
+    s21 = vmlaq_n_f32 (s21,y1,l[2*nskip+p]);
+    s30 = vmlaq_n_f32 (s30,y0,l[3*nskip+p]);
+    s31 = vmlaq_n_f32 (s31,y1,l[3*nskip+p]);
+  }
+#define SUB_ROW(i,s0,s1) \
+  vst1q_f32 (a+i*nskip,vsubq_f32 (vld1q_f32 (a+i*nskip),s0)); \
+  vst1q_f32 (a+i*nskip+4,vsubq_f32 (vld1q_f32 (a+i*nskip+4),s1));
+  SUB_ROW(0,s00,s01) SUB_ROW(1,s10,s11) SUB_ROW(2,s20,s21) SUB_ROW(3,s30,s31)
+#undef SUB_ROW
+#else
+  dReal s[4][8];
+  for (int i=0; i<4; i++) for (int j=0; j<8; j++) s[i][j] = 0;
+  for (int p=0; p<nb; p++, yt += ldy) {
+    for (int i=0; i<4; i++) {
+      dReal li = l[i*nskip+p];
+      for (int j=0; j<8; j++) s[i][j] += li * yt[j];
+    }
+  }
+  for (int i=0; i<4; i++) for (int j=0; j<8; j++) a[i*nskip+j] -= s[i][j];
+#endif
+}
+
+
+// A(i,j) -= sum_p l(i,p) * yt(p,j) for one element
+
+static inline void updateElement (const dReal *l, const dReal *yt, dReal *a,
+				  int nb, int ldy)
+{
+  dReal sum = 0;
+  for (int p=0; p<nb; p++, yt += ldy) sum += l[p] * yt[0];
+  *a -= sum;
+}
+
+
+// subtract the outer product of the panel from the lower triangle of the m*m
+// matrix at A. `l' is the panel of the first row.
+
+static void updateTrailing (const dReal *l, const dReal *yt, dReal *A, int m,
+			    int nb, int nskip, int ldy)
+{
+  int i = 0;
+  for (; i+4 <= m; i += 4) {
+    // tiles left of the diagonal, where all 4 rows are in the lower triangle
+    int j = 0;
+    for (; j+8 <= i+1; j += 8)
+      updateTile (l + i*nskip,yt + j,A + i*nskip + j,nb,nskip,ldy);
+    // the rest of the 4 rows, up to the diagonal
+    for (int ii=i; ii<i+4; ii++) {
+      for (int jj=j; jj<=ii; jj++)
+	updateElement (l + ii*nskip,yt + jj,A + ii*nskip + jj,nb,ldy);
+    }
+  }
+  for (; i<m; i++) {
+    for (int j=0; j<=i; j++)
+      updateElement (l + i*nskip,yt + j,A + i*nskip + j,nb,ldy);
+  }
+}
+
+
+// factor A with the given work arrays: `diag' holds n values and `yt' holds
+// BLOCK*n values.
+
+static void factorBlocked (dReal *A, dReal *d, int n, int nskip,
+			   dReal *diag, dReal *yt)
+{
+  // the updates change the diagonal of A, which the unblocked code leaves
+  // alone, so it is put back at the end
+  for (int i=0; i<n; i++) diag[i] = A[i*nskip+i];
+
+  // the panel's y values, transposed
+  const int ldy = n;
+
+  for (int k=0; k<n; k += BLOCK) {
+    const int nb = (n-k < BLOCK) ? n-k : BLOCK;
+    dReal *Akk = A + k*nskip + k;
+    dFactorLDLTUnblocked (Akk,d+k,nb,nskip);
+
+    const int m = n - k - nb;
+    if (m == 0) break;
+    dReal *panel = Akk + nb*nskip;
+    solvePanel (Akk,d+k,panel,m,nb,nskip,yt,ldy);
+    updateTrailing (panel,yt,panel + nb,m,nb,nskip,ldy);
+  }
+
+  for (int i=0; i<n; i++) A[i*nskip+i] = diag[i];
+}
+
+
+void dxFactorLDLT (dReal *A, dReal *d, int n, int nskip, dxArena *arena)
+{
+  if (n < MIN_BLOCKED_SIZE) {
+    dFactorLDLTUnblocked (A,d,n,nskip);
+    return;
+  }
+
+  const size_t diag_size = dEFFICIENT_SIZE (n*sizeof(dReal));
+  const size_t size = diag_size + BLOCK*n*sizeof(dReal);
+  if (arena) {
+    dxArena::Marker marker = arena->mark();
+    char *work = (char*) arena->alloc (size);
+    factorBlocked (A,d,n,nskip,(dReal*) work,(dReal*) (work + diag_size));
+    arena->release (marker);
+  }
+  else {
+    char *work = (char*) dAlloc (size);
+    factorBlocked (A,d,n,nskip,(dReal*) work,(dReal*) (work + diag_size));
+    dFree (work,size);
+  }
+}
+
+
+void dFactorLDLT (dReal *A, dReal *d, int n, int nskip)
+{
+  dxFactorLDLT (A,d,n,nskip,0);
+}
@@ -0,0 +1,864 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+/*
+
+a space that keeps its geoms in a dynamic bounding volume hierarchy, like
+the "dynamic AABB tree" of most modern physics engines.
+
+every geom with a finite AABB has a leaf in a binary tree. the box of a leaf
+is the AABB of its geom grown by a margin (a "fat" box), and the box of an
+inner node contains the boxes of both its children. when a geom moves, its
+leaf is only changed if the new AABB is no longer inside the fat box; the
+leaf is then taken out of the tree and inserted again, at the place where
+it makes the tree grow least in surface area. on the way back up from every
+insertion and removal the nodes are rotated to keep the tree balanced.
+
+geoms with infinite AABBs (e.g. planes) would make every box in the tree
+infinite, so they are kept in a list of their own instead and tested
+against all other geoms.
+
+*/
+
+#include <ode/common.h>
+#include <ode/matrix.h>
+#include <ode/collision_space.h>
+#include <ode/collision.h>
+#include "collision_kernel.h"
+
+#include "collision_space_internal.h"
+
+
+#define GEOM_ENABLED(g) (((g)->gflags & GEOM_ENABLE_TEST_MASK) == GEOM_ENABLE_TEST_VALUE)
+
+// the default margin AABBs are grown by
+#define DEFAULT_MARGIN REAL(0.1)
+
+// no node
+#define NULL_NODE (-1)
+
+// where the geom of a leaf is kept
+enum {
+  LEAF_NEW = 0,		// not yet anywhere, the geom has not been cleaned
+  LEAF_IN_TREE,		// in the tree
+  LEAF_INFINITE		// in the list of geoms with infinite AABBs
+};
+
+
+// a node of the tree. free nodes are linked through `parent'.
+
+struct dxBVHNode {
+  dReal box[6];		// fat AABB of a leaf, or union of the children
+  int parent;		// parent node, or the next free node
+  int child1,child2;	// children, NULL_NODE for leaves
+  int height;		// 0 for leaves, -1 for free nodes
+  int awake;		// 1 if a geom below is not idle, set by collide()
+  int state;		// LEAF_xxx, for leaves
+  int infinite_index;	// index in infinite, for LEAF_INFINITE leaves
+  dxGeom *geom;		// geom of a leaf
+};
+
+
+// the parameters of a ray or segment query
+
+struct dxBVHRay {
+  dVector3 start;
+  dVector3 dir;
+  dVector3 inv_dir;	// 1/dir, for the components that are not 0
+  dReal length;		// in multiples of dir
+};
+
+
+static inline int isLeaf (const dxBVHNode *node)
+{
+  return node->child1 == NULL_NODE;
+}
+
+
+static inline int boxesOverlap (const dReal *a, const dReal *b)
+{
+  return a[0] <= b[1] && b[0] <= a[1] && a[2] <= b[3] && b[2] <= a[3] &&
+    a[4] <= b[5] && b[4] <= a[5];
+}
+
+
+static inline int boxContains (const dReal *outer, const dReal *inner)
+{
+  return outer[0] <= inner[0] && inner[1] <= outer[1] &&
+    outer[2] <= inner[2] && inner[3] <= outer[3] &&
+    outer[4] <= inner[4] && inner[5] <= outer[5];
+}
+
+
+static inline void boxUnion (dReal *dest, const dReal *a, const dReal *b)
+{
+  for (int i=0; i<6; i+=2) {
+    dest[i] = (a[i] < b[i]) ? a[i] : b[i];
+    dest[i+1] = (a[i+1] > b[i+1]) ? a[i+1] : b[i+1];
+  }
+}
+
+
+// half the surface area of a box, which the cost of a tree is measured in
+
+static inline dReal boxArea (const dReal *box)
+{
+  dReal dx = box[1] - box[0];
+  dReal dy = box[3] - box[2];
+  dReal dz = box[5] - box[4];
+  return dx*dy + dy*dz + dz*dx;
+}
+
+
+static inline int boxIsInfinite (const dReal *box)
+{
+  return box[0] == -dInfinity || box[1] == dInfinity ||
+    box[2] == -dInfinity || box[3] == dInfinity ||
+    box[4] == -dInfinity || box[5] == dInfinity;
+}
+
+
+// slab test: does the ray cross the box somewhere between 0 and length?
+
+static int rayHitsBox (const dxBVHRay *ray, const dReal *box)
+{
+  dReal tmin = 0, tmax = ray->length;
+  for (int i=0; i<3; i++) {
+    const dReal lo = box[i*2], hi = box[i*2+1];
+    if (ray->dir[i] == 0) {
+      if (ray->start[i] < lo || ray->start[i] > hi) return 0;
+      continue;
+    }
+    dReal t1 = (lo - ray->start[i]) * ray->inv_dir[i];
+    dReal t2 = (hi - ray->start[i]) * ray->inv_dir[i];
+    if (t1 > t2) { dReal tmp = t1; t1 = t2; t2 = tmp; }
+    if (t1 > tmin) tmin = t1;
+    if (t2 < tmax) tmax = t2;
+    if (tmin > tmax) return 0;
+  }
+  return 1;
+}
+
+
+static void setupRay (dxBVHRay *ray, const dReal *start, const dReal *dir,
+		      dReal length)
+{
+  for (int i=0; i<3; i++) {
+    ray->start[i] = start[i];
+    ray->dir[i] = dir[i];
+    ray->inv_dir[i] = (dir[i] != 0) ? REAL(1.0) / dir[i] : 0;
+  }
+  ray->length = length;
+}
+
+
+// hash a geom pointer for the geom -> leaf lookup table
+
+static size_t hashGeom (dxGeom *geom)
+{
+  size_t h = ((size_t) geom) >> 4;
+  return h ^ (h >> 7) ^ (h >> 15);
+}
+
+//****************************************************************************
+// BVH space
+
+struct dxBVHSpace : public dxSpace {
+  dArray<dxBVHNode> nodes;	// all nodes, free ones included
+  int root;			// root of the tree, NULL_NODE if empty
+  int free_list;		// first free node, NULL_NODE if none
+  dArray<int> infinite;		// leaves of the geoms with infinite AABBs
+  dReal margin;			// fat boxes are grown by this much
+
+  int *lookup;			// open addressing geom -> leaf table
+  int lookup_size;		// allocated size of lookup, a power of two
+  int num_leaves;		// number of entries in lookup
+
+  dxBVHSpace (dSpaceID _space);
+  ~dxBVHSpace();
+  void add (dxGeom *);
+  void remove (dxGeom *);
+  void cleanGeoms();
+  void collide (void *data, dNearCallback *callback);
+  void collide2 (void *data, dxGeom *geom, dNearCallback *callback);
+
+  void queryAABB (const dReal *box, void *data, dSpaceQueryCallback *callback);
+  void queryRay (const dxBVHRay *ray, void *data,
+		 dSpaceQueryCallback *callback);
+
+  int allocNode();
+  void freeNode (int index);
+  int findLeaf (dxGeom *geom);
+  void insertLookup (int leaf);
+  void eraseLookup (dxGeom *geom);
+
+  void updateLeaf (int leaf);
+  void insertLeaf (int leaf);
+  void removeLeaf (int leaf);
+  void refitFrom (int index);
+  int balance (int index);
+  void removeInfinite (int leaf);
+
+  int markAwake (int index);
+  void collideNode (int index, void *data, dNearCallback *callback);
+  void collideNodes (int index1, int index2, void *data,
+		     dNearCallback *callback);
+  void collideGeomNode (int index, dxGeom *geom, int idle, void *data,
+			dNearCallback *callback);
+  void collideRayNode (int index, const dxBVHRay *ray, dxGeom *geom,
+		       void *data, dNearCallback *callback);
+  void queryAABBNode (int index, const dReal *box, void *data,
+		      dSpaceQueryCallback *callback);
+  void queryRayNode (int index, const dxBVHRay *ray, void *data,
+		     dSpaceQueryCallback *callback);
+};
+
+
+dxBVHSpace::dxBVHSpace (dSpaceID _space) : dxSpace (_space)
+{
+  type = dBVHSpaceClass;
+  root = NULL_NODE;
+  free_list = NULL_NODE;
+  margin = DEFAULT_MARGIN;
+  lookup = 0;
+  lookup_size = 0;
+  num_leaves = 0;
+}
+
+
+dxBVHSpace::~dxBVHSpace()
+{
+  // the geoms themselves are removed or destroyed by ~dxSpace(), which no
+  // longer sees this class, so all the tree data is freed here.
+  if (lookup) dFree (lookup,lookup_size*sizeof(int));
+}
+
+
+int dxBVHSpace::allocNode()
+{
+  int index;
+  if (free_list != NULL_NODE) {
+    index = free_list;
+    free_list = nodes[index].parent;
+  }
+  else {
+    index = nodes.size();
+    nodes.setSize (index+1);
+  }
+  dxBVHNode *node = &nodes[index];
+  node->parent = NULL_NODE;
+  node->child1 = NULL_NODE;
+  node->child2 = NULL_NODE;
+  node->height = 0;
+  node->awake = 1;
+  node->state = LEAF_NEW;
+  node->infinite_index = -1;
+  node->geom = 0;
+  return index;
+}
+
+
+void dxBVHSpace::freeNode (int index)
+{
+  nodes[index].parent = free_list;
+  nodes[index].height = -1;
+  nodes[index].geom = 0;
+  free_list = index;
+}
+
+
+int dxBVHSpace::findLeaf (dxGeom *geom)
+{
+  if (lookup_size == 0) return NULL_NODE;
+  size_t mask = lookup_size - 1;
+  for (size_t i = hashGeom (geom) & mask; lookup[i] != NULL_NODE;
+       i = (i+1) & mask) {
+    if (nodes[lookup[i]].geom == geom) return lookup[i];
+  }
+  return NULL_NODE;
+}
+
+
+void dxBVHSpace::insertLookup (int leaf)
+{
+  // keep the lookup table at most half full
+  if ((num_leaves+1)*2 > lookup_size) {
+    int *old = lookup;
+    int old_size = lookup_size;
+    lookup_size = old_size ? old_size*2 : 16;
+    lookup = (int*) dAlloc (lookup_size*sizeof(int));
+    for (int i=0; i<lookup_size; i++) lookup[i] = NULL_NODE;
+    if (old) {
+      size_t mask = lookup_size - 1;
+      for (int i=0; i<old_size; i++) {
+	if (old[i] != NULL_NODE) {
+	  size_t j = hashGeom (nodes[old[i]].geom) & mask;
+	  while (lookup[j] != NULL_NODE) j = (j+1) & mask;
+	  lookup[j] = old[i];
+	}
+      }
+      dFree (old,old_size*sizeof(int));
+    }
+  }
+  size_t mask = lookup_size - 1;
+  size_t i = hashGeom (nodes[leaf].geom) & mask;
+  while (lookup[i] != NULL_NODE) i = (i+1) & mask;
+  lookup[i] = leaf;
+  num_leaves++;
+}
+
+
+void dxBVHSpace::eraseLookup (dxGeom *geom)
+{
+  size_t mask = lookup_size - 1;
+  size_t i = hashGeom (geom) & mask;
+  while (nodes[lookup[i]].geom != geom) i = (i+1) & mask;
+  lookup[i] = NULL_NODE;
+  num_leaves--;
+
+  // shift back any following entries that would no longer be reachable
+  // across the hole we just made (linear probing deletion)
+  size_t j = i;
+  for (;;) {
+    j = (j+1) & mask;
+    if (lookup[j] == NULL_NODE) break;
+    size_t k = hashGeom (nodes[lookup[j]].geom) & mask;
+    if ((j > i && (k <= i || k > j)) || (j < i && (k <= i && k > j))) {
+      lookup[i] = lookup[j];
+      lookup[j] = NULL_NODE;
+      i = j;
+    }
+  }
+}
+
+
+void dxBVHSpace::add (dxGeom *geom)
+{
+  CHECK_NOT_LOCKED (this);
+  dxSpace::add (geom);
+
+  int leaf = allocNode();
+  nodes[leaf].geom = geom;
+  insertLookup (leaf);
+
+  // the geom is dirty, so it will be put in the tree on the next clean
+}
+
+
+void dxBVHSpace::remove (dxGeom *geom)
+{
+  CHECK_NOT_LOCKED (this);
+  int leaf = findLeaf (geom);
+  dUASSERT (leaf != NULL_NODE,"object is not in this space");
+
+  if (nodes[leaf].state == LEAF_IN_TREE) removeLeaf (leaf);
+  else if (nodes[leaf].state == LEAF_INFINITE) removeInfinite (leaf);
+  eraseLookup (geom);
+  freeNode (leaf);
+
+  dxSpace::remove (geom);
+}
+
+
+void dxBVHSpace::removeInfinite (int leaf)
+{
+  int i = nodes[leaf].infinite_index;
+  int last = infinite[infinite.size()-1];
+  infinite[i] = last;
+  nodes[last].infinite_index = i;
+  infinite.setSize (infinite.size()-1);
+  nodes[leaf].infinite_index = -1;
+  nodes[leaf].state = LEAF_NEW;
+}
+
+
+// put the leaf of a geom whose AABB has just been computed where it belongs
+
+void dxBVHSpace::updateLeaf (int leaf)
+{
+  dxBVHNode *node = &nodes[leaf];
+  const dReal *aabb = node->geom->aabb;
+
+  if (boxIsInfinite (aabb)) {
+    if (node->state == LEAF_INFINITE) return;
+    if (node->state == LEAF_IN_TREE) removeLeaf (leaf);
+    node = &nodes[leaf];
+    node->state = LEAF_INFINITE;
+    node->infinite_index = infinite.size();
+    infinite.push (leaf);
+    return;
+  }
+
+  if (node->state == LEAF_IN_TREE) {
+    // moving within the fat box changes nothing
+    if (boxContains (node->box,aabb)) return;
+    removeLeaf (leaf);
+  }
+  else if (node->state == LEAF_INFINITE) removeInfinite (leaf);
+
+  node = &nodes[leaf];
+  for (int i=0; i<6; i+=2) {
+    node->box[i] = aabb[i] - margin;
+    node->box[i+1] = aabb[i+1] + margin;
+  }
+  insertLeaf (leaf);
+}
+
+
+void dxBVHSpace::insertLeaf (int leaf)
+{
+  nodes[leaf].state = LEAF_IN_TREE;
+  if (root == NULL_NODE) {
+    root = leaf;
+    nodes[leaf].parent = NULL_NODE;
+    return;
+  }
+
+  // walk down to the best sibling. at every node the cost of making the
+  // leaf its sibling is compared with the least cost of going further down,
+  // where all the nodes on the way grow by the leaf's box.
+  const dReal *box = nodes[leaf].box;
+  int index = root;
+  while (!isLeaf (&nodes[index])) {
+    const dxBVHNode *node = &nodes[index];
+    dReal combined[6];
+    boxUnion (combined,node->box,box);
+    const dReal area = boxArea (node->box);
+    const dReal combined_area = boxArea (combined);
+
+    // cost of a new parent for this node and the leaf
+    const dReal cost = 2*combined_area;
+    // least cost of pushing the leaf further down
+    const dReal inheritance = 2*(combined_area - area);
+
+    dReal child_cost[2];
+    const int child[2] = { node->child1, node->child2 };
+    for (int i=0; i<2; i++) {
+      const dxBVHNode *c = &nodes[child[i]];
+      boxUnion (combined,c->box,box);
+      if (isLeaf (c)) child_cost[i] = boxArea (combined) + inheritance;
+      else child_cost[i] = boxArea (combined) - boxArea (c->box) + inheritance;
+    }
+
+    if (cost < child_cost[0] && cost < child_cost[1]) break;
+    index = (child_cost[0] < child_cost[1]) ? child[0] : child[1];
+  }
+
+  // make a new parent for the sibling and the leaf
+  const int sibling = index;
+  const int old_parent = nodes[sibling].parent;
+  const int new_parent = allocNode();
+  dxBVHNode *parent = &nodes[new_parent];
+  parent->parent = old_parent;
+  parent->geom = 0;
+  boxUnion (parent->box,nodes[sibling].box,nodes[leaf].box);
+  parent->height = nodes[sibling].height + 1;
+  parent->child1 = sibling;
+  parent->child2 = leaf;
+  nodes[sibling].parent = new_parent;
+  nodes[leaf].parent = new_parent;
+
+  if (old_parent != NULL_NODE) {
+    if (nodes[old_parent].child1 == sibling) nodes[old_parent].child1 = new_parent;
+    else nodes[old_parent].child2 = new_parent;
+  }
+  else root = new_parent;
+
+  refitFrom (new_parent);
+}
+
+
+void dxBVHSpace::removeLeaf (int leaf)
+{
+  nodes[leaf].state = LEAF_NEW;
+  if (leaf == root) {
+    root = NULL_NODE;
+    return;
+  }
+
+  // the sibling takes the place of the parent
+  const int parent = nodes[leaf].parent;
+  const int grand_parent = nodes[parent].parent;
+  const int sibling = (nodes[parent].child1 == leaf) ?
+    nodes[parent].child2 : nodes[parent].child1;
+
+  if (grand_parent != NULL_NODE) {
+    if (nodes[grand_parent].child1 == parent) nodes[grand_parent].child1 = sibling;
+    else nodes[grand_parent].child2 = sibling;
+    nodes[sibling].parent = grand_parent;
+    freeNode (parent);
+    refitFrom (grand_parent);
+  }
+  else {
+    root = sibling;
+    nodes[sibling].parent = NULL_NODE;
+    freeNode (parent);
+  }
+  nodes[leaf].parent = NULL_NODE;
+}
+
+
+// balance and refit the nodes from `index' up to the root
+
+void dxBVHSpace::refitFrom (int index)
+{
+  while (index != NULL_NODE) {
+    index = balance (index);
+    dxBVHNode *node = &nodes[index];
+    const dxBVHNode *c1 = &nodes[node->child1];
+    const dxBVHNode *c2 = &nodes[node->child2];
+    node->height = 1 + ((c1->height > c2->height) ? c1->height : c2->height);
+    boxUnion (node->box,c1->box,c2->box);
+    index = node->parent;
+  }
+}
+
+
+// if one subtree of node `a' is more than one level higher than the other,
+// rotate the higher child up. returns the node now in the place of `a'.
+
+int dxBVHSpace::balance (int a)
+{
+  dxBVHNode *A = &nodes[a];
+  if (isLeaf (A) || A->height < 2) return a;
+
+  const int b = A->child1;
+  const int c = A->child2;
+  const int diff = nodes[c].height - nodes[b].height;
+  if (diff >= -1 && diff <= 1) return a;
+
+  // the higher child `up' becomes the parent of `a', and the higher of its
+  // own children stays with it. `keep' is the child of `a' that stays.
+  const int up = (diff > 0) ? c : b;
+  const int keep = (diff > 0) ? b : c;
+  dxBVHNode *U = &nodes[up];
+  const int f = U->child1;
+  const int g = U->child2;
+
+  U->child1 = a;
+  U->parent = A->parent;
+  A->parent = up;
+  if (U->parent != NULL_NODE) {
+    if (nodes[U->parent].child1 == a) nodes[U->parent].child1 = up;
+    else nodes[U->parent].child2 = up;
+  }
+  else root = up;
+
+  const int high = (nodes[f].height > nodes[g].height) ? f : g;
+  const int low = (high == f) ? g : f;
+  U->child2 = high;
+  if (diff > 0) A->child2 = low;
+  else A->child1 = low;
+  nodes[low].parent = a;
+
+  const dxBVHNode *K = &nodes[keep];
+  const dxBVHNode *L = &nodes[low];
+  boxUnion (A->box,K->box,L->box);
+  A->height = 1 + ((K->height > L->height) ? K->height : L->height);
+  const dxBVHNode *H = &nodes[high];
+  boxUnion (U->box,A->box,H->box);
+  U->height = 1 + ((A->height > H->height) ? A->height : H->height);
+  return up;
+}
+
+
+void dxBVHSpace::cleanGeoms()
+{
+  // compute the AABBs of all dirty geoms, clear the dirty flags and update
+  // the leaves of the geoms that have left their fat boxes
+  lock_count++;
+  for (dxGeom *g=first; g && (g->gflags & GEOM_DIRTY); g=g->next) {
+    if (IS_SPACE(g)) {
+      ((dxSpace*)g)->cleanGeoms();
+    }
+    g->recomputeAABB();
+    g->gflags &= (~(GEOM_DIRTY|GEOM_AABB_BAD));
+    updateLeaf (findLeaf (g));
+  }
+  lock_count--;
+}
+
+
+// set the awake flags of the nodes below `index', if idle pairs are
+// ignored. returns the flag of `index'.
+
+int dxBVHSpace::markAwake (int index)
+{
+  dxBVHNode *node = &nodes[index];
+  if (isLeaf (node)) node->awake = !geomIsIdle (node->geom);
+  else {
+    int awake1 = markAwake (node->child1);
+    int awake2 = markAwake (node->child2);
+    node = &nodes[index];
+    node->awake = awake1 | awake2;
+  }
+  return node->awake;
+}
+
+
+// report the pairs of geoms below `index'
+
+void dxBVHSpace::collideNode (int index, void *data, dNearCallback *callback)
+{
+  const dxBVHNode *node = &nodes[index];
+  if (isLeaf (node) || !node->awake) return;
+  collideNode (node->child1,data,callback);
+  collideNode (node->child2,data,callback);
+  collideNodes (node->child1,node->child2,data,callback);
+}
+
+
+// report the pairs with one geom below each of two disjoint subtrees
+
+void dxBVHSpace::collideNodes (int index1, int index2, void *data,
+			       dNearCallback *callback)
+{
+  const dxBVHNode *n1 = &nodes[index1];
+  const dxBVHNode *n2 = &nodes[index2];
+  if (!n1->awake && !n2->awake) return;
+  if (!boxesOverlap (n1->box,n2->box)) return;
+
+  if (isLeaf (n1)) {
+    if (isLeaf (n2)) {
+      if (GEOM_ENABLED(n1->geom) && GEOM_ENABLED(n2->geom))
+	collideAABBs (n1->geom,n2->geom,data,callback);
+      return;
+    }
+  }
+  else if (isLeaf (n2) || n1->height >= n2->height) {
+    // descend into the higher subtree
+    collideNodes (n1->child1,index2,data,callback);
+    collideNodes (n1->child2,index2,data,callback);
+    return;
+  }
+  collideNodes (index1,n2->child1,data,callback);
+  collideNodes (index1,n2->child2,data,callback);
+}
+
+
+void dxBVHSpace::collide (void *data, dNearCallback *callback)
+{
+  dAASSERT (callback);
+
+  lock_count++;
+  cleanGeoms();
+
+  // the awake flags stay 1 unless idle pairs are ignored, as they are never
+  // cleared otherwise
+  const int skip_idle = ignore_idle;
+  if (root != NULL_NODE) {
+    if (skip_idle) markAwake (root);
+    collideNode (root,data,callback);
+  }
+
+  // the geoms with infinite AABBs against each other and against the tree
+  const int num_infinite = infinite.size();
+  for (int i=0; i<num_infinite; i++) {
+    dxGeom *g1 = nodes[infinite[i]].geom;
+    if (!GEOM_ENABLED(g1)) continue;
+    const int idle1 = skip_idle && geomIsIdle (g1);
+    for (int j=i+1; j<num_infinite; j++) {
+      dxGeom *g2 = nodes[infinite[j]].geom;
+      if (!GEOM_ENABLED(g2) || (idle1 && geomIsIdle (g2))) continue;
+      collideAABBs (g1,g2,data,callback);
+    }
+    if (root != NULL_NODE) collideGeomNode (root,g1,idle1,data,callback);
+  }
+
+  // only the next collide() with idle pairs ignored sets the flags again
+  if (skip_idle && root != NULL_NODE) {
+    for (int i=0; i<nodes.size(); i++) nodes[i].awake = 1;
+  }
+
+  lock_count--;
+}
+
+
+// report the pairs of `geom' with the geoms below `index'. if `idle' is
+// set, the parts of the tree where all geoms are idle are skipped.
+
+void dxBVHSpace::collideGeomNode (int index, dxGeom *geom, int idle,
+				  void *data, dNearCallback *callback)
+{
+  const dxBVHNode *node = &nodes[index];
+  if (idle && !node->awake) return;
+  if (!boxesOverlap (node->box,geom->aabb)) return;
+  if (isLeaf (node)) {
+    if (node->geom != geom && GEOM_ENABLED(node->geom))
+      collideAABBs (node->geom,geom,data,callback);
+    return;
+  }
+  collideGeomNode (node->child1,geom,idle,data,callback);
+  collideGeomNode (node->child2,geom,idle,data,callback);
+}
+
+
+// as collideGeomNode, but the ray geom is tested against the boxes itself
+// rather than its AABB, which is large for long diagonal rays
+
+void dxBVHSpace::collideRayNode (int index, const dxBVHRay *ray, dxGeom *geom,
+				 void *data, dNearCallback *callback)
+{
+  const dxBVHNode *node = &nodes[index];
+  if (!rayHitsBox (ray,node->box)) return;
+  if (isLeaf (node)) {
+    if (node->geom != geom && GEOM_ENABLED(node->geom))
+      collideAABBs (node->geom,geom,data,callback);
+    return;
+  }
+  collideRayNode (node->child1,ray,geom,data,callback);
+  collideRayNode (node->child2,ray,geom,data,callback);
+}
+
+
+void dxBVHSpace::collide2 (void *data, dxGeom *geom, dNearCallback *callback)
+{
+  dAASSERT (geom && callback);
+
+  lock_count++;
+  cleanGeoms();
+  geom->recomputeAABB();
+
+  if (root != NULL_NODE) {
+    if (geom->type == dRayClass) {
+      dVector3 start,dir;
+      dGeomRayGet (geom,start,dir);
+      dxBVHRay ray;
+      setupRay (&ray,start,dir,dGeomRayGetLength (geom));
+      collideRayNode (root,&ray,geom,data,callback);
+    }
+    else collideGeomNode (root,geom,0,data,callback);
+  }
+
+  const int num_infinite = infinite.size();
+  for (int i=0; i<num_infinite; i++) {
+    dxGeom *g = nodes[infinite[i]].geom;
+    if (g != geom && GEOM_ENABLED(g)) collideAABBs (g,geom,data,callback);
+  }
+
+  lock_count--;
+}
+
+
+void dxBVHSpace::queryAABBNode (int index, const dReal *box, void *data,
+				dSpaceQueryCallback *callback)
+{
+  const dxBVHNode *node = &nodes[index];
+  if (!boxesOverlap (node->box,box)) return;
+  if (isLeaf (node)) {
+    // the fat box overlaps, but the geom's own AABB might not
+    if (GEOM_ENABLED(node->geom) && boxesOverlap (node->geom->aabb,box))
+      callback (data,node->geom);
+    return;
+  }
+  queryAABBNode (node->child1,box,data,callback);
+  queryAABBNode (node->child2,box,data,callback);
+}
+
+
+void dxBVHSpace::queryRayNode (int index, const dxBVHRay *ray, void *data,
+			       dSpaceQueryCallback *callback)
+{
+  const dxBVHNode *node = &nodes[index];
+  if (!rayHitsBox (ray,node->box)) return;
+  if (isLeaf (node)) {
+    if (GEOM_ENABLED(node->geom) && rayHitsBox (ray,node->geom->aabb))
+      callback (data,node->geom);
+    return;
+  }
+  queryRayNode (node->child1,ray,data,callback);
+  queryRayNode (node->child2,ray,data,callback);
+}
+
+
+void dxBVHSpace::queryAABB (const dReal *box, void *data,
+			    dSpaceQueryCallback *callback)
+{
+  lock_count++;
+  cleanGeoms();
+  if (root != NULL_NODE) queryAABBNode (root,box,data,callback);
+  for (int i=0; i<infinite.size(); i++) {
+    dxGeom *g = nodes[infinite[i]].geom;
+    if (GEOM_ENABLED(g) && boxesOverlap (g->aabb,box)) callback (data,g);
+  }
+  lock_count--;
+}
+
+
+void dxBVHSpace::queryRay (const dxBVHRay *ray, void *data,
+			   dSpaceQueryCallback *callback)
+{
+  lock_count++;
+  cleanGeoms();
+  if (root != NULL_NODE) queryRayNode (root,ray,data,callback);
+  for (int i=0; i<infinite.size(); i++) {
+    dxGeom *g = nodes[infinite[i]].geom;
+    if (GEOM_ENABLED(g) && rayHitsBox (ray,g->aabb)) callback (data,g);
+  }
+  lock_count--;
+}
+
+//****************************************************************************
+// public API
+
+dSpaceID dBVHSpaceCreate (dxSpace *space)
+{
+  return new dxBVHSpace (space);
+}
+
+
+void dBVHSpaceSetMargin (dxSpace *space, dReal margin)
+{
+  dAASSERT (space);
+  dUASSERT (space->type == dBVHSpaceClass,"argument must be a BVH space");
+  dUASSERT (margin >= 0,"margin must not be negative");
+  ((dxBVHSpace*)space)->margin = margin;
+}
+
+
+dReal dBVHSpaceGetMargin (dxSpace *space)
+{
+  dAASSERT (space);
+  dUASSERT (space->type == dBVHSpaceClass,"argument must be a BVH space");
+  return ((dxBVHSpace*)space)->margin;
+}
+
+
+void dBVHSpaceQueryAABB (dxSpace *space, const dReal aabb[6],
+			 void *data, dSpaceQueryCallback *callback)
+{
+  dAASSERT (space && aabb && callback);
+  dUASSERT (space->type == dBVHSpaceClass,"argument must be a BVH space");
+  ((dxBVHSpace*)space)->queryAABB (aabb,data,callback);
+}
+
+
+void dBVHSpaceQueryRay (dxSpace *space, const dVector3 start,
+			const dVector3 dir, dReal length,
+			void *data, dSpaceQueryCallback *callback)
+{
+  dAASSERT (space && start && dir && callback);
+  dUASSERT (space->type == dBVHSpaceClass,"argument must be a BVH space");
+  dxBVHRay ray;
+  setupRay (&ray,start,dir,length);
+  ((dxBVHSpace*)space)->queryRay (&ray,data,callback);
+}
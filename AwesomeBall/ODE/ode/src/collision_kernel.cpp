@@ -39,6 +39,9 @@ for geometry objects
 #include "collision_transform.h"
 #include "collision_trimesh_internal.h"
 #include "odeou.h"
+#include "profile.h"
+#include "threading.h"
+#include <ode/batch.h>
 
 
 #ifdef _MSC_VER
@@ -50,50 +53,16 @@ for geometry objects
 
 // this struct records the parameters passed to dCollideSpaceGeom()
 
-#if dATOMICS_ENABLED 
-static volatile atomicptr s_cachedPosR = 0; // dxPosR *
-#endif // dATOMICS_ENABLED
+// posrs come from the small object pools, like the geoms themselves
 
 static inline dxPosR* dAllocPosr()
 {
-	dxPosR *retPosR;
-
-#if dATOMICS_ENABLED
-	retPosR = (dxPosR *)AtomicExchangePointer(&s_cachedPosR, NULL);
-
-	if (!retPosR)
-#endif
-	{
-		retPosR = (dxPosR*) dAlloc (sizeof(dxPosR));
-	}
-
-	return retPosR;
+	return (dxPosR*) dxPoolAlloc (sizeof(dxPosR));
 }
 
 static inline void dFreePosr(dxPosR *oldPosR)
 {
-#if dATOMICS_ENABLED
-	if (!AtomicCompareExchangePointer(&s_cachedPosR, NULL, (atomicptr)oldPosR))
-#endif
-	{
-		dFree(oldPosR, sizeof(dxPosR));
-	}
-}
-
-/*extern */void dClearPosrCache(void)
-{
-#if dATOMICS_ENABLED
-	// No threads should be accessing ODE at this time already,
-	// hence variable may be read directly.
-	dxPosR *existingPosR = (dxPosR *)s_cachedPosR;
-
-	if (existingPosR)
-	{
-		dFree(existingPosR, sizeof(dxPosR));
-
-		s_cachedPosR = 0;
-	}
-#endif
+	dxPoolFree (oldPosR, sizeof(dxPosR));
 }
 
 struct SpaceGeomColliderData {
@@ -273,6 +242,9 @@ int dCollide (dxGeom *o1, dxGeom *o2, int flags, dContactGeom *contact,
   o1->recomputePosr();
   o2->recomputePosr();
 
+  dxProfileScope profile (dxProfileCollisionActive ? dxProfileGetCollision() : 0,
+			  dProfileNarrowphase,o1->type*dGeomNumClasses + o2->type);
+
   dColliderEntry *ce = &colliders[o1->type][o2->type];
   int count = 0;
   if (ce->fn) {
@@ -295,12 +267,20 @@ int dCollide (dxGeom *o1, dxGeom *o2, int flags, dContactGeom *contact,
       count = (*ce->fn) (o1,o2,flags,contact,skip);
     }
   }
+  profile.setContacts (count);
   return count;
 }
 
 //****************************************************************************
 // dxGeom
 
+// the serial number of the next geom. geoms come from pools that hand out
+// the blocks of destroyed geoms again, so anything that remembers geoms
+// across steps (like the contact cache) identifies them by this number.
+// geoms can be created on several threads at once, so it is updated
+// atomically.
+static unsigned long next_geom_serial = 1;
+
 dxGeom::dxGeom (dSpaceID _space, int is_placeable)
 {
   // setup body vars. invalid type of -1 must be changed by the constructor.
@@ -327,6 +307,8 @@ dxGeom::dxGeom (dSpaceID _space, int is_placeable)
   dSetZero (aabb,6);
   category_bits = ~0;
   collide_bits = ~0;
+  material = 0;
+  serial = dxAtomicAdd (&next_geom_serial,1);
 
   // put this geom in a space if required
   if (_space) dSpaceAdd (_space,this);
@@ -715,6 +697,21 @@ unsigned long dGeomGetCollideBits (dxGeom *g)
 }
 
 
+void dGeomSetMaterial (dxGeom *g, int material)
+{
+  dAASSERT (g);
+  dUASSERT (material >= 0,"material must be >= 0");
+  g->material = material;
+}
+
+
+int dGeomGetMaterial (dxGeom *g)
+{
+  dAASSERT (g);
+  return g->material;
+}
+
+
 void dGeomEnable (dxGeom *g)
 {
 	dAASSERT (g);
@@ -87,7 +87,7 @@ enum {
 // the pos and R of the body (if body nonzero).
 // a dGeomID is a pointer to this object.
 
-struct dxGeom : public dBase {
+struct dxGeom : public dPooledBase {
   int type;		// geom type number, set by subclass constructor
   int gflags;		// flags used by geom and space
   void *data;		// user-defined data pointer
@@ -102,6 +102,8 @@ struct dxGeom : public dBase {
   dxSpace *parent_space;// the space this geom is contained in, 0 if none
   dReal aabb[6];	// cached AABB for this space
   unsigned long category_bits,collide_bits;
+  int material;		// index into a material table, see dGeomSetMaterial()
+  unsigned long serial;	// unique number, unlike the address never reused
 
   dxGeom (dSpaceID _space, int is_placeable);
   virtual ~dxGeom();
@@ -194,6 +196,9 @@ struct dxSpace : public dxGeom {
   // is locked.
   int lock_count;
 
+  dxWorld *profile_world;	// world that collide() reports to, or 0
+  int ignore_idle;		// 1 to skip pairs of idle geoms in collide()
+
   dxSpace (dSpaceID _space);
   ~dxSpace();
 
@@ -227,7 +232,6 @@ struct dxSpace : public dxGeom {
 void dInitColliders();
 void dFinitColliders();
 
-void dClearPosrCache(void);
 void dFinitUserClasses();
 
 
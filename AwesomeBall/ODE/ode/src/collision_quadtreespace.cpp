@@ -316,6 +316,21 @@ Block* Block::GetBlockChild(const dReal* AABB){
 	return this;	// This is the best block
 }
 
+// a near callback that passes on the pairs with at least one geom that is
+// not idle, as the blocks can not skip idle pairs any earlier.
+
+struct dxIdlePairFilter {
+  void *data;
+  dNearCallback *callback;
+};
+
+static void idlePairFilterCallback (void *data, dxGeom *g1, dxGeom *g2)
+{
+  if (geomIsIdle (g1) && geomIsIdle (g2)) return;
+  dxIdlePairFilter *filter = (dxIdlePairFilter*) data;
+  filter->callback (filter->data,g1,g2);
+}
+
 //****************************************************************************
 // quadtree space
 
@@ -548,7 +563,14 @@ void dxQuadTreeSpace::collide(void* UserData, dNearCallback* Callback){
   lock_count++;
   cleanGeoms();
 
-  Blocks[0].Collide(UserData, Callback);
+  if (ignore_idle) {
+    // the blocks don't know about idle geoms, so filter what they find
+    dxIdlePairFilter filter;
+    filter.data = UserData;
+    filter.callback = Callback;
+    Blocks[0].Collide(&filter, &idlePairFilterCallback);
+  }
+  else Blocks[0].Collide(UserData, Callback);
 
   lock_count--;
 }
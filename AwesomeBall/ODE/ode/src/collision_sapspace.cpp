@@ -40,6 +40,7 @@
 
 #include "collision_kernel.h"
 #include "collision_space_internal.h"
+#include "threading.h"
 
 // Reference counting helper for radix sort global data.
 //static void RadixSortRef();
@@ -126,6 +127,12 @@ void RaixSortContext::ReallocateRanksIfNecessary(size_t nNewNoElts)
 //  SAP space code
 // --------------------------------------------------------------------------
 
+// Threaded pruning splits the sorted list into about four chunks per thread,
+// but never more than dSAP_MAX_CHUNKS, and none smaller than
+// dSAP_MIN_CHUNK_SIZE boxes.
+#define dSAP_MAX_CHUNKS 64
+#define dSAP_MIN_CHUNK_SIZE 512
+
 struct dxSAPSpace : public dxSpace
 {
 	// Constructor / Destructor
@@ -142,6 +149,9 @@ struct dxSAPSpace : public dxSpace
 	virtual void collide( void *data, dNearCallback *callback );
 	virtual void collide2( void *data, dxGeom *geom, dNearCallback *callback );
 
+	void setThreadCount( int count );
+	int getThreadCount() const { return threadCount; }
+
 private:
 
 	//--------------------------------------------------------------------------
@@ -174,6 +184,24 @@ private:
 	 */
 	void BoxPruning( int count, const dxGeom** geoms, dArray< Pair >& pairs );
 
+	/**
+	 *	Prune part of the sorted list.
+	 *  Finds the overlapping pairs whose first box is at one of the sorted
+	 *  positions [begin,end), in the same order as the full prune.
+	 */
+	void PruneRange( int begin, int end, const uint32* sorted, int count,
+		const dxGeom** geoms, dArray< Pair >& pairs );
+
+	struct PruneJob
+	{
+		dxSAPSpace* space;
+		const uint32* sorted;
+		int count;
+		int chunks;
+		const dxGeom** geoms;
+	};
+	static void PruneChunkTask( void* data, int index, int thread );
+
 
 	//--------------------------------------------------------------------------
 	// Implementation Data
@@ -201,6 +229,12 @@ private:
 	// NOTE: this is float not dReal because of the OPCODE radix sorter
 	dArray< float > poslist;
 	RaixSortContext	sortContext;
+
+	// Threaded pruning. Each chunk of the sorted list gets its own pair
+	// list, and the lists are joined in chunk order afterwards.
+	int threadCount;
+	dxThreadPool* threadPool;
+	dArray< Pair > chunkPairs[ dSAP_MAX_CHUNKS ];
 };
 
 // Creation
@@ -208,6 +242,21 @@ dSpaceID dSweepAndPruneSpaceCreate( dxSpace* space, int axisorder ) {
 	return new dxSAPSpace( space, axisorder );
 }
 
+void dSweepAndPruneSpaceSetThreadCount( dxSpace* space, int count )
+{
+	dAASSERT( space );
+	dUASSERT( space->type == dSweepAndPruneSpaceClass, "argument must be a SAP space" );
+	dUASSERT( count >= 1, "thread count must be at least 1" );
+	((dxSAPSpace*)space)->setThreadCount( count );
+}
+
+int dSweepAndPruneSpaceGetThreadCount( dxSpace* space )
+{
+	dAASSERT( space );
+	dUASSERT( space->type == dSweepAndPruneSpaceClass, "argument must be a SAP space" );
+	return ((dxSAPSpace*)space)->getThreadCount();
+}
+
 
 //==============================================================================
 
@@ -267,6 +316,9 @@ dxSAPSpace::dxSAPSpace( dSpaceID _space, int axisorder ) : dxSpace( _space )
 	ax0idx = ( ( axisorder ) & 3 ) << 1;
 	ax1idx = ( ( axisorder >> 2 ) & 3 ) << 1;
 	ax2idx = ( ( axisorder >> 4 ) & 3 ) << 1;
+
+	threadCount = 1;
+	threadPool = 0;
 }
 
 dxSAPSpace::~dxSAPSpace()
@@ -282,6 +334,21 @@ dxSAPSpace::~dxSAPSpace()
 		for ( ; DirtyList.size(); remove( DirtyList[ 0 ] ) ) {}
 		for ( ; GeomList.size(); remove( GeomList[ 0 ] ) ) {}
 	}
+	if ( threadPool )
+		delete threadPool;
+}
+
+void dxSAPSpace::setThreadCount( int count )
+{
+	CHECK_NOT_LOCKED(this);
+	if ( count == threadCount )
+		return;
+	threadCount = count;
+	// the pool is created with the new size on the next collide()
+	if ( threadPool ) {
+		delete threadPool;
+		threadPool = 0;
+	}
 }
 
 dxGeom* dxSAPSpace::getGeom( int i )
@@ -432,10 +499,14 @@ void dxSAPSpace::collide( void *data, dNearCallback *callback )
 	TmpGeomList.setSize(0);
 	TmpInfGeomList.setSize(0);
 	int axis0max = ax0idx + 1;
+	const int skip_idle = ignore_idle;
+	int awake_count = 0;
 	for( int i = 0; i < geom_count; ++i ) {
 		dxGeom* g = GeomList[i];
 		if( !GEOM_ENABLED(g) ) // skip disabled ones
 			continue;
+		if( skip_idle && !geomIsIdle( g ) )
+			awake_count++;
 		const dReal& amax = g->aabb[axis0max];
 		if( amax == dInfinity ) // HACK? probably not...
 			TmpInfGeomList.push( g );
@@ -443,6 +514,12 @@ void dxSAPSpace::collide( void *data, dNearCallback *callback )
 			TmpGeomList.push( g );
 	}
 
+	// nothing to do if idle pairs are ignored and all geoms are idle
+	if( skip_idle && awake_count == 0 ) {
+		lock_count--;
+		return;
+	}
+
 	// do SAP on normal AABBs
 	dArray< Pair > overlapBoxes;
 	int tmp_geom_count = TmpGeomList.size();
@@ -462,6 +539,8 @@ void dxSAPSpace::collide( void *data, dNearCallback *callback )
 		const Pair& pair = overlapBoxes[ j ];
 		dxGeom* g1 = TmpGeomList[ pair.id0 ];
 		dxGeom* g2 = TmpGeomList[ pair.id1 ];
+		if ( skip_idle && geomIsIdle( g1 ) && geomIsIdle( g2 ) )
+			continue;
 		collideGeomsNoAABBs( g1, g2, data, callback );
 	}
 
@@ -472,16 +551,21 @@ void dxSAPSpace::collide( void *data, dNearCallback *callback )
 	for ( m = 0; m < infSize; ++m )
 	{
 		dxGeom* g1 = TmpInfGeomList[ m ];
+		const int idle1 = skip_idle && geomIsIdle( g1 );
 
 		// collide infinite ones
 		for( n = m+1; n < infSize; ++n ) {
 			dxGeom* g2 = TmpInfGeomList[n];
+			if ( idle1 && geomIsIdle( g2 ) )
+				continue;
 			collideGeomsNoAABBs( g1, g2, data, callback );
 		}
 
 		// collide infinite ones with normal ones
 		for( n = 0; n < normSize; ++n ) {
 			dxGeom* g2 = TmpGeomList[n];
+			if ( idle1 && geomIsIdle( g2 ) )
+				continue;
 			collideGeomsNoAABBs( g1, g2, data, callback );
 		}
 	}
@@ -524,40 +608,93 @@ void dxSAPSpace::BoxPruning( int count, const dxGeom** geoms, dArray< Pair >& pa
 	const uint32* Sorted = sortContext.RadixSort( poslist.data(), count );
 
 	// 3) Prune the list
+	int chunks = threadCount * 4;
+	if ( chunks > dSAP_MAX_CHUNKS )
+		chunks = dSAP_MAX_CHUNKS;
+	if ( chunks > count / dSAP_MIN_CHUNK_SIZE )
+		chunks = count / dSAP_MIN_CHUNK_SIZE;
+
+	if ( threadCount <= 1 || chunks <= 1 ) {
+		PruneRange( 0, count, Sorted, count, geoms, pairs );
+		return;
+	}
+
+	if ( !threadPool )
+		threadPool = new dxThreadPool( threadCount );
+
+	PruneJob job;
+	job.space = this;
+	job.sorted = Sorted;
+	job.count = count;
+	job.chunks = chunks;
+	job.geoms = geoms;
+	threadPool->run( chunks, &PruneChunkTask, &job );
+
+	// join the chunk pair lists in order, which gives exactly the pairs of
+	// the single threaded prune
+	int total = 0;
+	for( int k = 0; k < chunks; ++k )
+		total += chunkPairs[ k ].size();
+	pairs.setSize( total );
+	Pair* dst = pairs.data();
+	for( int k = 0; k < chunks; ++k ) {
+		int n = chunkPairs[ k ].size();
+		memcpy( dst, chunkPairs[ k ].data(), n * sizeof(Pair) );
+		dst += n;
+	}
+}
+
+void dxSAPSpace::PruneChunkTask( void* data, int index, int )
+{
+	PruneJob* job = (PruneJob*)data;
+	int begin = (int)( (long)job->count * index / job->chunks );
+	int end = (int)( (long)job->count * ( index + 1 ) / job->chunks );
+	dArray< Pair >& pairs = job->space->chunkPairs[ index ];
+	pairs.setSize( 0 );
+	job->space->PruneRange( begin, end, job->sorted, job->count, job->geoms, pairs );
+}
+
+void dxSAPSpace::PruneRange( int begin, int end, const uint32* Sorted, int count,
+	const dxGeom** geoms, dArray< Pair >& pairs )
+{
+	// The box at sorted position i can only overlap boxes that come after it
+	// in the sorted list and start before it ends on the primary axis, so the
+	// scan for each box starts right after it. This lets every position be
+	// pruned on its own. The last real box is followed by the FLT_MAX end
+	// cap, which never makes a pair.
+	const uint32 endCap = count - 1;
 	const uint32* const LastSorted = Sorted + count;
-	const uint32* RunningAddress = Sorted;
 
 	Pair IndexPair;
-	while ( RunningAddress < LastSorted && Sorted < LastSorted )
+	for( int i = begin; i < end; ++i )
 	{
-		IndexPair.id0 = *Sorted++;
+		IndexPair.id0 = Sorted[ i ];
+		if ( IndexPair.id0 == endCap )
+			continue;
+
+		const uint32* RunningAddress2 = Sorted + i + 1;
 
-		// empty, this loop just advances RunningAddress
-		while ( poslist[*RunningAddress++] < poslist[IndexPair.id0] ) {}
+		const dReal idx0ax0max = geoms[IndexPair.id0]->aabb[ax0idx+1];
+		const dReal idx0ax1max = geoms[IndexPair.id0]->aabb[ax1idx+1];
+		const dReal idx0ax2max = geoms[IndexPair.id0]->aabb[ax2idx+1];
 
-		if ( RunningAddress < LastSorted )
+		while ( RunningAddress2 < LastSorted &&
+			poslist[ IndexPair.id1 = *RunningAddress2++ ] <= idx0ax0max )
 		{
-			const uint32* RunningAddress2 = RunningAddress;
+			if ( IndexPair.id1 == endCap )
+				break;
 
-			const dReal idx0ax0max = geoms[IndexPair.id0]->aabb[ax0idx+1];
-			const dReal idx0ax1max = geoms[IndexPair.id0]->aabb[ax1idx+1];
-			const dReal idx0ax2max = geoms[IndexPair.id0]->aabb[ax2idx+1];
+			const dReal* aabb0 = geoms[ IndexPair.id0 ]->aabb;
+			const dReal* aabb1 = geoms[ IndexPair.id1 ]->aabb;
 
-			while ( poslist[ IndexPair.id1 = *RunningAddress2++ ] <= idx0ax0max )
+			// Intersection?
+			if ( idx0ax1max >= aabb1[ax1idx] && aabb1[ax1idx+1] >= aabb0[ax1idx] )
+			if ( idx0ax2max >= aabb1[ax2idx] && aabb1[ax2idx+1] >= aabb0[ax2idx] )
 			{
-				const dReal* aabb0 = geoms[ IndexPair.id0 ]->aabb;
-				const dReal* aabb1 = geoms[ IndexPair.id1 ]->aabb;
-
-				// Intersection?
-				if ( idx0ax1max >= aabb1[ax1idx] && aabb1[ax1idx+1] >= aabb0[ax1idx] )
-				if ( idx0ax2max >= aabb1[ax2idx] && aabb1[ax2idx+1] >= aabb0[ax2idx] )
-				{
-					pairs.push( IndexPair );
-				}
+				pairs.push( IndexPair );
 			}
 		}
-
-	}; // while ( RunningAddress < LastSorted && Sorted < LastSorted )
+	}
 }
 
 
@@ -34,6 +34,7 @@ spaces
 #include "collision_kernel.h"
 
 #include "collision_space_internal.h"
+#include "profile.h"
 
 #ifdef _MSC_VER
 #pragma warning(disable:4291)  // for VC++, no complaints about "no matching operator delete found"
@@ -88,6 +89,8 @@ dxSpace::dxSpace (dSpaceID _space) : dxGeom (_space,0)
   current_index = 0;
   current_geom = 0;
   lock_count = 0;
+  profile_world = 0;
+  ignore_idle = 0;
 }
 
 
@@ -172,7 +175,6 @@ int dxSpace::getNumGeoms()
   return count;
 }
 
-
 // the dirty geoms are numbered 0..k, the clean geoms are numbered k+1..count-1
 
 dxGeom *dxSpace::getGeom (int i)
@@ -256,6 +258,7 @@ struct dxSimpleSpace : public dxSpace {
   void cleanGeoms();
   void collide (void *data, dNearCallback *callback);
   void collide2 (void *data, dxGeom *geom, dNearCallback *callback);
+  void collideAwake (void *data, dNearCallback *callback);
 };
 
 
@@ -287,6 +290,12 @@ void dxSimpleSpace::collide (void *data, dNearCallback *callback)
   lock_count++;
   cleanGeoms();
 
+  if (ignore_idle) {
+    collideAwake (data,callback);
+    lock_count--;
+    return;
+  }
+
   // intersect all bounding boxes
   for (dxGeom *g1=first; g1; g1=g1->next) {
     if (GEOM_ENABLED(g1)){
@@ -302,6 +311,44 @@ void dxSimpleSpace::collide (void *data, dNearCallback *callback)
 }
 
 
+// collide() for spaces that ignore idle pairs. an idle geom is only
+// intersected with the geoms after it in the list that are not idle, which
+// are kept in a separate array, so the pairs come out in the same order.
+
+void dxSimpleSpace::collideAwake (void *data, dNearCallback *callback)
+{
+  dxGeom **awake = (dxGeom**) ALLOCA (count * sizeof(dxGeom*));
+  int *position = (int*) ALLOCA (count * sizeof(int));
+  int num_awake = 0;
+  int i = 0;
+  for (dxGeom *g=first; g; g=g->next, i++) {
+    if (GEOM_ENABLED(g) && !geomIsIdle(g)) {
+      awake[num_awake] = g;
+      position[num_awake] = i;
+      num_awake++;
+    }
+  }
+  if (num_awake == 0) return;
+
+  int next_awake = 0;		// first entry of `awake' after g1
+  i = 0;
+  for (dxGeom *g1=first; g1; g1=g1->next, i++) {
+    if (next_awake < num_awake && position[next_awake] == i) {
+      // g1 is not idle, so intersect it with everything after it
+      next_awake++;
+      for (dxGeom *g2=g1->next; g2; g2=g2->next) {
+	if (GEOM_ENABLED(g2)) collideAABBs (g1,g2,data,callback);
+      }
+    }
+    else if (GEOM_ENABLED(g1)) {
+      for (int k=next_awake; k<num_awake; k++) {
+	collideAABBs (g1,awake[k],data,callback);
+      }
+    }
+  }
+}
+
+
 void dxSimpleSpace::collide2 (void *data, dxGeom *geom,
 			      dNearCallback *callback)
 {
@@ -338,25 +385,42 @@ static const long int prime[NUM_PRIMES] = {1L,2L,3L,7L,13L,31L,61L,127L,251L,509
   67108859L,134217689L,268435399L,536870909L,1073741789L};
 
 
-// an axis aligned bounding box in the hash table
-struct dxAABB {
-  dxAABB *next;		// next in the list of all AABBs
-  int level;		// the level this is stored in (cell size = 2^level)
-  int dbounds[6];	// AABB bounds, discretized to cell size
-  dxGeom *geom;		// corresponding geometry object (AABB stored here)
-  int index;		// index of this AABB, starting from 0
-};
+// the maximum number of cells an AABB can occupy. findLevel() picks a cell
+// size no smaller than the largest AABB dimension, so in each axis the AABB
+// spans at most two cells. AABBs that end up spanning more cells than this
+// (which only happens because of rounding) are put in the big boxes list.
+#define MAX_CELLS 8
+
+struct dxAABB;
 
 
 // a hash table node that represents an AABB that intersects a particular cell
 // at a particular level
 struct Node {
   Node *next;		// next node in hash table collision list, 0 if none
+  Node **tome;		// hash table collision list backpointer
   int x,y,z;		// cell position in space, discretized to cell size
   dxAABB *aabb;		// axis aligned bounding box that intersects this cell
 };
 
 
+// an axis aligned bounding box in the hash table. every geom in the hash
+// space has one of these, and it stays in the hash table between calls to
+// collide() - it is only moved to other cells when its geom becomes dirty
+// and the cells it occupies actually change.
+struct dxAABB : public dPooledBase {
+  dxAABB *next;		// next in the big boxes list, if this is a big box
+  dxAABB **tome;	// big boxes list backpointer, 0 if not a big box
+  int level;		// the level this is stored in (cell size = 2^level)
+  int dbounds[6];	// AABB bounds, discretized to cell size
+  dxGeom *geom;		// corresponding geometry object (AABB stored here)
+  int index;		// index of this AABB, starting from 0
+  int num_nodes;	// number of hash table nodes in use, 0 if none
+  int idle;		// geom is idle, set by collide() if ignoring idle pairs
+  Node node[MAX_CELLS];	// the hash table nodes for the occupied cells
+};
+
+
 // return the `level' of an AABB. the AABB will be put into cells at this
 // level - the cell size will be 2^level. the level is chosen to be the
 // smallest value such that the AABB occupies no more than 8 cells, regardless
@@ -388,30 +452,73 @@ static int findLevel (dReal bounds[6])
 
 
 // find a virtual memory address for a cell at the given level and x,y,z
-// position.
-// @@@ currently this is not very sophisticated, e.g. the scaling
-// factors could be better designed to avoid collisions, and they should
-// probably depend on the hash table physical size.
+// position. the hash table is kept from one collide() to the next, so the
+// cells are scattered with large primes rather than the old decimal scheme,
+// which put neighbouring cells in the same few buckets.
 
 static unsigned long getVirtualAddress (int level, int x, int y, int z)
 {
-  return level*1000 + x*100 + y*10 + z;
+  return ((unsigned long) level * 2654435761UL) ^
+    ((unsigned long) x * 73856093UL) ^
+    ((unsigned long) y * 19349663UL) ^
+    ((unsigned long) z * 83492791UL);
+}
+
+
+// hash a geom pointer for the geom -> AABB lookup table
+
+static size_t hashGeom (dxGeom *geom)
+{
+  size_t h = ((size_t) geom) >> 4;
+  return h ^ (h >> 7) ^ (h >> 15);
 }
 
 //****************************************************************************
 // hash space
+//
+// the AABBs of all geoms and the hash table that holds them are kept in the
+// space. collide() only re-buckets the geoms that are dirty, so the cost of
+// keeping the hash table up to date is proportional to the number of geoms
+// that have moved rather than to the number of geoms in the space.
 
 struct dxHashSpace : public dxSpace {
   int global_minlevel;	// smallest hash table level to put AABBs in
   int global_maxlevel;	// objects that need a level larger than this will be
 			// put in a "big objects" list instead of a hash table
 
+  dxAABB **aabbs;	// the AABBs of all geoms, indexed by dxAABB::index
+  int num_aabbs;	// number of AABBs, the same as the number of geoms
+  int aabbs_size;	// allocated size of aabbs
+
+  dxAABB **lookup;	// open addressing geom -> AABB table
+  int lookup_size;	// allocated size of lookup, a power of two
+
+  Node **table;		// hash table of the cells occupied by all AABBs
+  int table_prime;	// index of the table size in prime[], -1 if no table
+  int num_nodes;	// number of nodes in the hash table
+
+  dxAABB *big_boxes;	// list of AABBs too big for hash table
+  int *level_count;	// number of AABBs at each level, from global_minlevel
+  int rebucket_all;	// 1 if all AABBs must be re-bucketed on the next clean
+
   dxHashSpace (dSpaceID _space);
+  ~dxHashSpace();
   void setLevels (int minlevel, int maxlevel);
   void getLevels (int *minlevel, int *maxlevel);
+  void add (dxGeom *);
+  void remove (dxGeom *);
   void cleanGeoms();
   void collide (void *data, dNearCallback *callback);
   void collide2 (void *data, dxGeom *geom, dNearCallback *callback);
+
+  dxAABB *findAABB (dxGeom *geom);
+  void insertLookup (dxAABB *aabb);
+  void eraseLookup (dxGeom *geom);
+  void growTable (int nodes);
+  void unbucket (dxAABB *aabb);
+  void bucket (dxAABB *aabb);
+  void unbucketAll();
+  int getMaxLevel();
 };
 
 
@@ -420,14 +527,46 @@ dxHashSpace::dxHashSpace (dSpaceID _space) : dxSpace (_space)
   type = dHashSpaceClass;
   global_minlevel = -3;
   global_maxlevel = 10;
+  aabbs = 0;
+  num_aabbs = 0;
+  aabbs_size = 0;
+  lookup = 0;
+  lookup_size = 0;
+  table = 0;
+  table_prime = -1;
+  num_nodes = 0;
+  big_boxes = 0;
+  level_count = (int*) dAlloc ((global_maxlevel-global_minlevel+1)*sizeof(int));
+  memset (level_count,0,(global_maxlevel-global_minlevel+1)*sizeof(int));
+  rebucket_all = 0;
+}
+
+
+dxHashSpace::~dxHashSpace()
+{
+  // the geoms themselves are removed or destroyed by ~dxSpace(), which no
+  // longer sees this class, so all the hash space data is freed here.
+  for (int i=0; i<num_aabbs; i++) delete aabbs[i];
+  if (aabbs) dFree (aabbs,aabbs_size*sizeof(dxAABB*));
+  if (lookup) dFree (lookup,lookup_size*sizeof(dxAABB*));
+  if (table) dFree (table,prime[table_prime]*sizeof(Node*));
+  dFree (level_count,(global_maxlevel-global_minlevel+1)*sizeof(int));
 }
 
 
 void dxHashSpace::setLevels (int minlevel, int maxlevel)
 {
   dAASSERT (minlevel <= maxlevel);
+  CHECK_NOT_LOCKED (this);
+  // the level of every AABB may change, so take them all out of the hash
+  // table and put them back on the next clean
+  unbucketAll();
+  dFree (level_count,(global_maxlevel-global_minlevel+1)*sizeof(int));
   global_minlevel = minlevel;
   global_maxlevel = maxlevel;
+  level_count = (int*) dAlloc ((global_maxlevel-global_minlevel+1)*sizeof(int));
+  memset (level_count,0,(global_maxlevel-global_minlevel+1)*sizeof(int));
+  rebucket_all = 1;
 }
 
 
@@ -438,9 +577,261 @@ void dxHashSpace::getLevels (int *minlevel, int *maxlevel)
 }
 
 
+dxAABB *dxHashSpace::findAABB (dxGeom *geom)
+{
+  dIASSERT (lookup_size > 0);
+  size_t mask = lookup_size - 1;
+  for (size_t i = hashGeom (geom) & mask; lookup[i]; i = (i+1) & mask) {
+    if (lookup[i]->geom == geom) return lookup[i];
+  }
+  return 0;
+}
+
+
+void dxHashSpace::insertLookup (dxAABB *aabb)
+{
+  // keep the lookup table at most half full
+  if ((num_aabbs+1)*2 > lookup_size) {
+    dxAABB **old = lookup;
+    int old_size = lookup_size;
+    lookup_size = old_size ? old_size*2 : 16;
+    lookup = (dxAABB**) dAlloc (lookup_size*sizeof(dxAABB*));
+    memset (lookup,0,lookup_size*sizeof(dxAABB*));
+    if (old) {
+      for (int i=0; i<old_size; i++) {
+	if (old[i]) {
+	  size_t mask = lookup_size - 1;
+	  size_t j = hashGeom (old[i]->geom) & mask;
+	  while (lookup[j]) j = (j+1) & mask;
+	  lookup[j] = old[i];
+	}
+      }
+      dFree (old,old_size*sizeof(dxAABB*));
+    }
+  }
+  size_t mask = lookup_size - 1;
+  size_t i = hashGeom (aabb->geom) & mask;
+  while (lookup[i]) i = (i+1) & mask;
+  lookup[i] = aabb;
+}
+
+
+void dxHashSpace::eraseLookup (dxGeom *geom)
+{
+  size_t mask = lookup_size - 1;
+  size_t i = hashGeom (geom) & mask;
+  while (lookup[i]->geom != geom) i = (i+1) & mask;
+  lookup[i] = 0;
+
+  // shift back any following entries that would no longer be reachable
+  // across the hole we just made (linear probing deletion)
+  size_t j = i;
+  for (;;) {
+    j = (j+1) & mask;
+    if (!lookup[j]) break;
+    size_t k = hashGeom (lookup[j]->geom) & mask;
+    if ((j > i && (k <= i || k > j)) || (j < i && (k <= i && k > j))) {
+      lookup[i] = lookup[j];
+      lookup[j] = 0;
+      i = j;
+    }
+  }
+}
+
+
+void dxHashSpace::add (dxGeom *geom)
+{
+  dxSpace::add (geom);
+
+  dxAABB *aabb = new dxAABB;
+  aabb->next = 0;
+  aabb->tome = 0;
+  aabb->level = 0;
+  aabb->geom = geom;
+  aabb->num_nodes = 0;
+  aabb->idle = 0;
+
+  insertLookup (aabb);
+  if (num_aabbs == aabbs_size) {
+    int size = aabbs_size ? aabbs_size*2 : 16;
+    aabbs = (dxAABB**) dRealloc (aabbs,aabbs_size*sizeof(dxAABB*),
+				 size*sizeof(dxAABB*));
+    aabbs_size = size;
+  }
+  aabb->index = num_aabbs;
+  aabbs[num_aabbs++] = aabb;
+
+  // the geom is dirty, so it will be put in the hash table on the next clean
+}
+
+
+void dxHashSpace::remove (dxGeom *geom)
+{
+  CHECK_NOT_LOCKED (this);
+  dxAABB *aabb = findAABB (geom);
+  dUASSERT (aabb,"object is not in this space");
+
+  unbucket (aabb);
+  eraseLookup (geom);
+  num_aabbs--;
+  if (aabb->index != num_aabbs) {
+    aabbs[aabb->index] = aabbs[num_aabbs];
+    aabbs[aabb->index]->index = aabb->index;
+  }
+  delete aabb;
+
+  dxSpace::remove (geom);
+}
+
+
+// make sure the hash table is big enough to hold `nodes' nodes. like the old
+// per-collide table, it is kept at least as big as the number of nodes to
+// keep the chains short.
+
+void dxHashSpace::growTable (int nodes)
+{
+  if (table_prime >= 0 &&
+      (nodes <= prime[table_prime] || table_prime == NUM_PRIMES-1)) return;
+
+  int i;
+  for (i=table_prime+1; i<NUM_PRIMES-1; i++) {
+    if (prime[i] >= 2*nodes) break;
+  }
+  if (table) dFree (table,prime[table_prime]*sizeof(Node*));
+  table_prime = i;
+  int sz = prime[i];
+  table = (Node**) dAlloc (sz*sizeof(Node*));
+  for (i=0; i<sz; i++) table[i] = 0;
+
+  // re-insert the nodes of all AABBs that are in the hash table
+  for (i=0; i<num_aabbs; i++) {
+    dxAABB *aabb = aabbs[i];
+    for (int j=0; j<aabb->num_nodes; j++) {
+      Node *node = aabb->node + j;
+      unsigned long hi = getVirtualAddress (aabb->level,node->x,node->y,
+					    node->z) % sz;
+      node->next = table[hi];
+      node->tome = table + hi;
+      if (table[hi]) table[hi]->tome = &node->next;
+      table[hi] = node;
+    }
+  }
+}
+
+
+// take an AABB out of the hash table or the big boxes list
+
+void dxHashSpace::unbucket (dxAABB *aabb)
+{
+  if (aabb->num_nodes) {
+    for (int i=0; i<aabb->num_nodes; i++) {
+      Node *node = aabb->node + i;
+      if (node->next) node->next->tome = node->tome;
+      *node->tome = node->next;
+    }
+    num_nodes -= aabb->num_nodes;
+    aabb->num_nodes = 0;
+    level_count[aabb->level - global_minlevel]--;
+  }
+  else if (aabb->tome) {
+    if (aabb->next) aabb->next->tome = aabb->tome;
+    *aabb->tome = aabb->next;
+    aabb->next = 0;
+    aabb->tome = 0;
+  }
+}
+
+
+void dxHashSpace::unbucketAll()
+{
+  for (int i=0; i<num_aabbs; i++) unbucket (aabbs[i]);
+}
+
+
+// put an AABB into the cells its geom's AABB currently occupies, or into the
+// big boxes list. if the occupied cells have not changed then nothing is done.
+
+void dxHashSpace::bucket (dxAABB *aabb)
+{
+  int i,db[6];
+  dxGeom *geom = aabb->geom;
+
+  // compute level, but prevent cells from getting too small
+  int level = findLevel (geom->aabb);
+  if (level < global_minlevel) level = global_minlevel;
+  int cells = MAX_CELLS+1;
+  if (level <= global_maxlevel) {
+    // cellsize = 2^level
+    dReal cellsize = (dReal) ldexp (1.0,level);
+    // discretize AABB position to cell size
+    for (i=0; i < 6; i++) db[i] = (int) floor (geom->aabb[i]/cellsize);
+    cells = (db[1]-db[0]+1) * (db[3]-db[2]+1) * (db[5]-db[4]+1);
+  }
+
+  if (cells > MAX_CELLS) {
+    // aabb is too big, put it in the big_boxes list. we don't care about
+    // setting level or dbounds.
+    if (aabb->tome) return;
+    unbucket (aabb);
+    aabb->next = big_boxes;
+    aabb->tome = &big_boxes;
+    if (big_boxes) big_boxes->tome = &aabb->next;
+    big_boxes = aabb;
+    return;
+  }
+
+  if (aabb->num_nodes && aabb->level == level &&
+      memcmp (aabb->dbounds,db,sizeof(db)) == 0) return;
+
+  unbucket (aabb);
+  aabb->level = level;
+  memcpy (aabb->dbounds,db,sizeof(db));
+  level_count[level - global_minlevel]++;
+  growTable (num_nodes + cells);
+  int sz = prime[table_prime];
+
+  // add the AABB to the hash table (may need to add it to up to 8 cells)
+  Node *node = aabb->node;
+  for (int xi = db[0]; xi <= db[1]; xi++) {
+    for (int yi = db[2]; yi <= db[3]; yi++) {
+      for (int zi = db[4]; zi <= db[5]; zi++) {
+	// get the hash index
+	unsigned long hi = getVirtualAddress (level,xi,yi,zi) % sz;
+	// add a new node to the hash table
+	node->x = xi;
+	node->y = yi;
+	node->z = zi;
+	node->aabb = aabb;
+	node->next = table[hi];
+	node->tome = table + hi;
+	if (table[hi]) table[hi]->tome = &node->next;
+	table[hi] = node;
+	node++;
+      }
+    }
+  }
+  aabb->num_nodes = cells;
+  num_nodes += cells;
+}
+
+
+// return the largest level used by any AABB in the hash table, or
+// global_minlevel-1 if the table is empty
+
+int dxHashSpace::getMaxLevel()
+{
+  int level;
+  for (level = global_maxlevel; level >= global_minlevel; level--) {
+    if (level_count[level - global_minlevel]) break;
+  }
+  return level;
+}
+
+
 void dxHashSpace::cleanGeoms()
 {
-  // compute the AABBs of all dirty geoms, and clear the dirty flags
+  // compute the AABBs of all dirty geoms, clear the dirty flags and move
+  // the geoms to the hash table cells they now occupy
   lock_count++;
   for (dxGeom *g=first; g && (g->gflags & GEOM_DIRTY); g=g->next) {
     if (IS_SPACE(g)) {
@@ -448,6 +839,11 @@ void dxHashSpace::cleanGeoms()
     }
     g->recomputeAABB();
     g->gflags &= (~(GEOM_DIRTY|GEOM_AABB_BAD));
+    if (!rebucket_all) bucket (findAABB (g));
+  }
+  if (rebucket_all) {
+    for (int i=0; i<num_aabbs; i++) bucket (aabbs[i]);
+    rebucket_all = 0;
   }
   lock_count--;
 }
@@ -456,9 +852,8 @@ void dxHashSpace::cleanGeoms()
 void dxHashSpace::collide (void *data, dNearCallback *callback)
 {
   dAASSERT(this && callback);
-  dxGeom *geom;
   dxAABB *aabb;
-  int i,maxlevel;
+  int i;
 
   // 0 or 1 geoms can't collide with anything
   if (count < 2) return;
@@ -466,98 +861,52 @@ void dxHashSpace::collide (void *data, dNearCallback *callback)
   lock_count++;
   cleanGeoms();
 
-  // create a list of auxiliary information for all geom axis aligned bounding
-  // boxes. set the level for all AABBs. put AABBs larger than the space's
-  // global_maxlevel in the big_boxes list, check everything else against
-  // that list at the end. for AABBs that are not too big, record the maximum
-  // level that we need.
-
-  int n = 0;			// number of AABBs in main list
-  dxAABB *first_aabb = 0;	// list of AABBs in hash table
-  dxAABB *big_boxes = 0;	// list of AABBs too big for hash table
-  maxlevel = global_minlevel - 1;
-  for (geom = first; geom; geom=geom->next) {
-    if (!GEOM_ENABLED(geom)){
-      continue;
+  // the AABBs of all geoms are now in the hash table or the big_boxes
+  // list. AABBs in the big_boxes list are checked against everything else at
+  // the end. disabled geoms stay in the hash table, they are just skipped.
+
+  int n = num_aabbs;
+  int maxlevel = getMaxLevel();
+  int sz = table_prime >= 0 ? prime[table_prime] : 0;
+
+  // if idle pairs are ignored, find the idle AABBs and the highest level of
+  // the hashed AABBs that are not. an idle AABB only meets AABBs at its own
+  // level or above in the loop below, so above that level it has nothing to
+  // look for.
+  const int skip_idle = ignore_idle;
+  int awake_level = -MAXINT;
+  if (skip_idle) {
+    int num_awake = 0;
+    for (int j=0; j<n; j++) {
+      aabb = aabbs[j];
+      aabb->idle = geomIsIdle (aabb->geom);
+      if (aabb->idle || !GEOM_ENABLED(aabb->geom)) continue;
+      num_awake++;
+      if (aabb->num_nodes && aabb->level > awake_level)
+	awake_level = aabb->level;
     }
-    dxAABB *aabb = (dxAABB*) ALLOCA (sizeof(dxAABB));
-    aabb->geom = geom;
-    // compute level, but prevent cells from getting too small
-    int level = findLevel (geom->aabb);
-    if (level < global_minlevel) level = global_minlevel;
-    if (level <= global_maxlevel) {
-      // aabb goes in main list
-      aabb->next = first_aabb;
-      first_aabb = aabb;
-      aabb->level = level;
-      if (level > maxlevel) maxlevel = level;
-      // cellsize = 2^level
-      dReal cellsize = (dReal) ldexp (1.0,level);
-      // discretize AABB position to cell size
-      for (i=0; i < 6; i++) aabb->dbounds[i] = (int)
-			      floor (geom->aabb[i]/cellsize);
-      // set AABB index
-      aabb->index = n;
-      n++;
-    }
-    else {
-      // aabb is too big, put it in the big_boxes list. we don't care about
-      // setting level, dbounds, index, or the maxlevel
-      aabb->next = big_boxes;
-      big_boxes = aabb;
+    if (num_awake == 0) {
+      lock_count--;
+      return;
     }
   }
 
-  // for `n' objects, an n*n array of bits is used to record if those objects
-  // have been intersection-tested against each other yet. this array can
-  // grow large with high n, but oh well...
-  int tested_rowsize = (n+7) >> 3;	// number of bytes needed for n bits
-  unsigned char *tested = (unsigned char *) ALLOCA (n * tested_rowsize);
-  memset (tested,0,n * tested_rowsize);
-
-  // create a hash table to store all AABBs. each AABB may take up to 8 cells.
-  // we use chaining to resolve collisions, but we use a relatively large table
-  // to reduce the chance of collisions.
-
-  // compute hash table size sz to be a prime > 8*n
-  for (i=0; i<NUM_PRIMES; i++) {
-    if (prime[i] >= (8*n)) break;
-  }
-  if (i >= NUM_PRIMES) i = NUM_PRIMES-1;	// probably pointless
-  int sz = prime[i];
-
-  // allocate and initialize hash table node pointers
-  Node **table = (Node **) ALLOCA (sizeof(Node*) * sz);
-  for (i=0; i<sz; i++) table[i] = 0;
-
-  // add each AABB to the hash table (may need to add it to up to 8 cells)
-  for (aabb=first_aabb; aabb; aabb=aabb->next) {
-    int *dbounds = aabb->dbounds;
-    for (int xi = dbounds[0]; xi <= dbounds[1]; xi++) {
-      for (int yi = dbounds[2]; yi <= dbounds[3]; yi++) {
-	for (int zi = dbounds[4]; zi <= dbounds[5]; zi++) {
-	  // get the hash index
-	  unsigned long hi = getVirtualAddress (aabb->level,xi,yi,zi) % sz;
-	  // add a new node to the hash table
-	  Node *node = (Node*) ALLOCA (sizeof (Node));
-	  node->x = xi;
-	  node->y = yi;
-	  node->z = zi;
-	  node->aabb = aabb;
-	  node->next = table[hi];
-	  table[hi] = node;
-	}
-      }
-    }
-  }
-
-  // now that all AABBs are loaded into the hash table, we do the actual
-  // collision detection. for all AABBs, check for other AABBs in the
-  // same cells for collisions, and then check for other AABBs in all
-  // intersecting higher level cells.
+  // for all AABBs, check for other AABBs in the same cells for collisions,
+  // and then check for other AABBs in all intersecting higher level cells.
+  //
+  // two AABBs can share more than one cell, and two AABBs at the same level
+  // both find each other. so a pair is only reported from the shared cell
+  // with the smallest coordinates, and at the same level only by the AABB
+  // that comes first in `aabbs'. that is where the loops below meet the pair
+  // first, so the pairs are reported in the same order as if every pair
+  // were remembered once it had been tested.
 
   int db[6];			// discrete bounds at current level
-  for (aabb=first_aabb; aabb; aabb=aabb->next) {
+  for (int j=0; j<n; j++) {
+    aabb = aabbs[j];
+    if (aabb->num_nodes == 0 || !GEOM_ENABLED(aabb->geom)) continue;
+    const int query_idle = skip_idle && aabb->idle;
+    if (query_idle && aabb->level > awake_level) continue;
     // we are searching for collisions with aabb
     for (i=0; i<6; i++) db[i] = aabb->dbounds[i];
     for (int level = aabb->level; level <= maxlevel; level++) {
@@ -573,22 +922,15 @@ void dxHashSpace::collide (void *data, dNearCallback *callback)
 	      if (node->aabb == aabb) continue;
 	      if (node->aabb->level == level &&
 		  node->x == xi && node->y == yi && node->z == zi) {
-		// see if aabb and node->aabb have already been tested
-		// against each other
-		unsigned char mask;
-		if (aabb->index <= node->aabb->index) {
-		  i = (aabb->index * tested_rowsize)+(node->aabb->index >> 3);
-		  mask = 1 << (node->aabb->index & 7);
-		}
-		else {
-		  i = (node->aabb->index * tested_rowsize)+(aabb->index >> 3);
-		  mask = 1 << (aabb->index & 7);
-		}
-		dIASSERT (i >= 0 && i < (tested_rowsize*n));
-		if ((tested[i] & mask)==0) {
-		  collideAABBs (aabb->geom,node->aabb->geom,data,callback);
-		}
-		tested[i] |= mask;
+		dxAABB *other = node->aabb;
+		if (!GEOM_ENABLED(other->geom)) continue;
+		if (query_idle && other->idle) continue;
+		if (other->level == aabb->level && other->index < aabb->index)
+		  continue;
+		if ((xi > db[0] && xi > other->dbounds[0]) ||
+		    (yi > db[2] && yi > other->dbounds[2]) ||
+		    (zi > db[4] && zi > other->dbounds[4])) continue;
+		collideAABBs (aabb->geom,other->geom,data,callback);
 	      }
 	    }
 	  }
@@ -602,16 +944,25 @@ void dxHashSpace::collide (void *data, dNearCallback *callback)
   // every AABB in the normal list must now be intersected against every
   // AABB in the big_boxes list. so let's hope there are not too many objects
   // in the big_boxes list.
-  for (aabb=first_aabb; aabb; aabb=aabb->next) {
-    for (dxAABB *aabb2=big_boxes; aabb2; aabb2=aabb2->next) {
-      collideAABBs (aabb->geom,aabb2->geom,data,callback);
+  for (aabb=big_boxes; aabb; aabb=aabb->next) {
+    if (!GEOM_ENABLED(aabb->geom)) continue;
+    for (int j=0; j<n; j++) {
+      dxAABB *aabb2 = aabbs[j];
+      if (aabb2->num_nodes && GEOM_ENABLED(aabb2->geom)) {
+	if (skip_idle && aabb->idle && aabb2->idle) continue;
+	collideAABBs (aabb2->geom,aabb->geom,data,callback);
+      }
     }
   }
 
   // intersected all AABBs in the big_boxes list together
   for (aabb=big_boxes; aabb; aabb=aabb->next) {
+    if (!GEOM_ENABLED(aabb->geom)) continue;
     for (dxAABB *aabb2=aabb->next; aabb2; aabb2=aabb2->next) {
-      collideAABBs (aabb->geom,aabb2->geom,data,callback);
+      if (GEOM_ENABLED(aabb2->geom)) {
+	if (skip_idle && aabb->idle && aabb2->idle) continue;
+	collideAABBs (aabb->geom,aabb2->geom,data,callback);
+      }
     }
   }
 
@@ -623,19 +974,74 @@ void dxHashSpace::collide2 (void *data, dxGeom *geom,
 			    dNearCallback *callback)
 {
   dAASSERT (geom && callback);
-  
-  // this could take advantage of the hash structure to avoid
-  // O(n2) complexity, but it does not yet.
-  
+  dxAABB *aabb;
+  int i,level;
+
   lock_count++;
   cleanGeoms();
   geom->recomputeAABB();
-  
-  // intersect bounding boxes
-  for (dxGeom *g=first; g; g=g->next) {
-    if (GEOM_ENABLED(g)) collideAABBs (g,geom,data,callback);
+
+  // count the cells that the query AABB covers at each level in use. if
+  // that is more than the number of AABBs in the space (e.g. a long ray in
+  // a space of small geoms) then just test all of them.
+  int maxlevel = getMaxLevel();
+  double cells = 0;
+  if (findLevel (geom->aabb) == MAXINT) cells = dInfinity;
+  for (level = global_minlevel; level <= maxlevel && cells <= num_aabbs;
+       level++) {
+    if (level_count[level - global_minlevel] == 0) continue;
+    dReal cellsize = (dReal) ldexp (1.0,level);
+    double c = 1;
+    for (i=0; i<6; i+=2) {
+      c *= floor (geom->aabb[i+1]/cellsize) - floor (geom->aabb[i]/cellsize)
+	+ 1;
+    }
+    cells += c;
   }
-  
+
+  if (cells > num_aabbs) {
+    // intersect bounding boxes
+    for (dxGeom *g=first; g; g=g->next) {
+      if (GEOM_ENABLED(g)) collideAABBs (g,geom,data,callback);
+    }
+    lock_count--;
+    return;
+  }
+
+  // look up the AABBs in all cells the query AABB covers. an AABB may share
+  // more than one of those cells with it, so it is only reported from the
+  // shared cell with the smallest coordinates.
+  int sz = table_prime >= 0 ? prime[table_prime] : 0;
+  int db[6];
+  for (level = global_minlevel; level <= maxlevel; level++) {
+    if (level_count[level - global_minlevel] == 0) continue;
+    dReal cellsize = (dReal) ldexp (1.0,level);
+    for (i=0; i < 6; i++) db[i] = (int) floor (geom->aabb[i]/cellsize);
+    for (int xi = db[0]; xi <= db[1]; xi++) {
+      for (int yi = db[2]; yi <= db[3]; yi++) {
+	for (int zi = db[4]; zi <= db[5]; zi++) {
+	  unsigned long hi = getVirtualAddress (level,xi,yi,zi) % sz;
+	  for (Node *node = table[hi]; node; node=node->next) {
+	    aabb = node->aabb;
+	    if (aabb->level != level ||
+		node->x != xi || node->y != yi || node->z != zi) continue;
+	    if ((xi > db[0] && xi > aabb->dbounds[0]) ||
+		(yi > db[2] && yi > aabb->dbounds[2]) ||
+		(zi > db[4] && zi > aabb->dbounds[4])) continue;
+	    if (GEOM_ENABLED(aabb->geom)) {
+	      collideAABBs (aabb->geom,geom,data,callback);
+	    }
+	  }
+	}
+      }
+    }
+  }
+
+  // the big boxes are not in the hash table
+  for (aabb=big_boxes; aabb; aabb=aabb->next) {
+    if (GEOM_ENABLED(aabb->geom)) collideAABBs (aabb->geom,geom,data,callback);
+  }
+
   lock_count--;
 }
 
@@ -713,6 +1119,22 @@ int dSpaceGetSublevel (dSpaceID space)
 }
 
 
+void dSpaceSetIgnoreIdlePairs (dSpaceID space, int ignore)
+{
+  dAASSERT (space);
+  dUASSERT (dGeomIsSpace(space),"argument not a space");
+  space->ignore_idle = (ignore != 0);
+}
+
+
+int dSpaceGetIgnoreIdlePairs (dSpaceID space)
+{
+  dAASSERT (space);
+  dUASSERT (dGeomIsSpace(space),"argument not a space");
+  return space->ignore_idle;
+}
+
+
 void dSpaceAdd (dxSpace *space, dxGeom *g)
 {
   dAASSERT (space);
@@ -768,10 +1190,20 @@ int dSpaceGetClass (dxSpace *space)
 }
 
 
+// profile of the world that a space reports its collisions to, or 0
+
+static dxProfile *spaceProfile (dxSpace *space)
+{
+  if (space && space->profile_world) return space->profile_world->profile;
+  return 0;
+}
+
+
 void dSpaceCollide (dxSpace *space, void *data, dNearCallback *callback)
 {
   dAASSERT (space && callback);
   dUASSERT (dGeomIsSpace(space),"argument not a space");
+  dxProfileCollision profile (spaceProfile (space));
   space->collide (data,callback);
 }
 
@@ -798,6 +1230,10 @@ void dSpaceCollide2 (dxGeom *g1, dxGeom *g2, void *data,
 	if (IS_SPACE(g1)) s1 = (dxSpace*) g1; else s1 = 0;
 	if (IS_SPACE(g2)) s2 = (dxSpace*) g2; else s2 = 0;
 
+	dxProfile *profile = spaceProfile (s1);
+	if (!profile) profile = spaceProfile (s2);
+	dxProfileCollision profile_collision (profile);
+
 	if (s1 && s2) {
 		int l1 = s1->getSublevel();
 		int l2 = s2->getSublevel();
@@ -81,4 +81,16 @@ static void collideAABBs (dxGeom *g1, dxGeom *g2,
   callback (data,g1,g2);
 }
 
+
+// a geom is idle if nothing can move it: it has no body, or its body is
+// disabled. a space is never idle, as it may contain geoms that are not.
+// spaces that ignore idle pairs (see dSpaceSetIgnoreIdlePairs) skip every
+// pair of two idle geoms.
+
+static inline int geomIsIdle (const dxGeom *g)
+{
+  if (g->body) return (g->body->flags & dxBodyDisabled) != 0;
+  return !IS_SPACE(g);
+}
+
 #endif
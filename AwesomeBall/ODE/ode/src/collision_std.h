@@ -94,6 +94,16 @@ int dCollideRayConvex (dxGeom *o1, dxGeom *o2, int flags,
 int dCollideHeightfield( dxGeom *o1, dxGeom *o2, 
 						 int flags, dContactGeom *contact, int skip );
 
+// batched versions of dCollideSpherePlane() and dCollideSphereSphere() for
+// n pairs of geoms, given as two arrays of the specified types. they write at
+// most one contact per pair into `contact' and set count[i] to the number of
+// contacts of pair i. the total is returned. see sphere.cpp.
+int dCollideSpherePlaneBatch (dxGeom * const *spheres,
+			      dxGeom * const *planes, int n,
+			      dContactGeom *contact, int *count);
+int dCollideSphereSphereBatch (dxGeom * const *s1, dxGeom * const *s2, int n,
+			       dContactGeom *contact, int *count);
+
 //****************************************************************************
 // the basic geometry objects
 
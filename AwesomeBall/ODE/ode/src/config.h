@@ -271,6 +271,9 @@
 /* Thread Local Storage API of OU is enabled */
 /* #undef dTLS_ENABLED */
 
+/* Worker thread pool (pthreads) is enabled */
+#define dTHREADS_ENABLED 1
+
 /* Use an alternative trimesh-trimesh collider which should yield better
    results */
 /* #undef dTRIMESH_OPCODE_USE_NEW_TRIMESH_TRIMESH_COLLIDER */
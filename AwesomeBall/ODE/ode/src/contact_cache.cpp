@@ -0,0 +1,214 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+#include <ode/common.h>
+#include <ode/matrix.h>
+#include "contact_cache.h"
+#include "collision_kernel.h"
+#include "array.h"
+#include "joints/joint.h"
+#include "joints/contact.h"
+
+//****************************************************************************
+// a contact is identified by its (ordered) geom pair and the features on both
+// geoms. geoms are identified by their serial numbers, because the geom pools
+// give the address of a destroyed geom to the next new one. many contacts can
+// share this key (e.g. the corners of a box resting on a plane all have
+// side -1), so among those the one closest to the new contact position is
+// picked, as long as it is within the world's warm start tolerance.
+
+struct dxCachedContact {
+  unsigned long g1,g2;	// geom pair serial numbers, in increasing order
+  int side1,side2;	// features on g1 and g2
+  int reversed;		// 1 if the joint had the geoms the other way around
+  int m;		// number of constraint rows of the joint
+  dVector3 pos;		// contact position
+  dReal lambda[3];	// lambda of the joint rows
+  int next;		// next contact in the same hash bucket, -1 if none
+};
+
+
+struct dxContactCache : public dBase {
+  dArray<dxCachedContact> contacts;
+  dArray<int> buckets;		// power of two sized hash table
+  dArray<char> used;		// contacts already given to a joint this step
+};
+
+
+void dxContactCacheDestroy (dxContactCache *cache)
+{
+  delete cache;
+}
+
+
+// get the key of a contact joint, with the geoms in increasing serial order
+
+static void getContactKey (dxJointContact *joint,
+			   unsigned long *g1, unsigned long *g2,
+			   int *side1, int *side2, int *reversed)
+{
+  const dContactGeom &cg = joint->contact.geom;
+  const unsigned long s1 = cg.g1 ? cg.g1->serial : 0;
+  const unsigned long s2 = cg.g2 ? cg.g2->serial : 0;
+  if (s1 <= s2) {
+    *g1 = s1;
+    *g2 = s2;
+    *side1 = cg.side1;
+    *side2 = cg.side2;
+    *reversed = 0;
+  }
+  else {
+    *g1 = s2;
+    *g2 = s1;
+    *side1 = cg.side2;
+    *side2 = cg.side1;
+    *reversed = 1;
+  }
+  // the body order of the joint also flips the friction directions
+  if (joint->flags & dJOINT_REVERSE) *reversed ^= 1;
+}
+
+
+static unsigned int hashContactKey (unsigned long g1, unsigned long g2,
+				    int side1, int side2)
+{
+  size_t h = (size_t) g1 * 2654435761UL;
+  h ^= (size_t) g2 * 2246822519UL;
+  h ^= (size_t) side1 * 3266489917UL;
+  h ^= (size_t) side2 * 668265263UL;
+  return (unsigned int) (h ^ (h >> 16));
+}
+
+
+// give a contact joint the lambdas of the closest matching cached contact
+
+static void loadContact (dxContactCache *cache, dxJointContact *joint,
+			 dReal tol2)
+{
+  dxCachedContact *contacts = cache->contacts.data();
+  unsigned int mask = cache->buckets.size() - 1;
+
+  unsigned long g1,g2;
+  int side1,side2,reversed;
+  getContactKey (joint,&g1,&g2,&side1,&side2,&reversed);
+
+  // find the closest unused cached contact with the same key
+  const dReal *pos = joint->contact.geom.pos;
+  int best = -1;
+  dReal best_dist = tol2;
+  int i = cache->buckets[hashContactKey (g1,g2,side1,side2) & mask];
+  for (; i >= 0; i = contacts[i].next) {
+    dxCachedContact *c = contacts + i;
+    if (c->g1 != g1 || c->g2 != g2 || c->side1 != side1 ||
+	c->side2 != side2 || cache->used[i]) continue;
+    dReal dx = c->pos[0] - pos[0];
+    dReal dy = c->pos[1] - pos[1];
+    dReal dz = c->pos[2] - pos[2];
+    dReal dist = dx*dx + dy*dy + dz*dz;
+    if (dist <= best_dist) {
+      best = i;
+      best_dist = dist;
+    }
+  }
+
+  dSetZero (joint->lambda,6);
+  if (best < 0) return;
+  cache->used[best] = 1;
+
+  // the normal row is the same whichever way around the geoms are. the
+  // friction rows are only reused if their directions still match.
+  dxCachedContact *c = contacts + best;
+  dxJoint::Info1 info;
+  joint->getInfo1 (&info);
+  joint->lambda[0] = c->lambda[0];
+  if (c->reversed == reversed && c->m == info.m) {
+    for (int k=1; k<c->m; k++) joint->lambda[k] = c->lambda[k];
+  }
+}
+
+
+void dxContactCacheLoad (dxWorld *world)
+{
+  dxContactCache *cache = world->contact_cache;
+  if (!cache || cache->contacts.size() == 0) return;
+
+  int n = cache->contacts.size();
+  cache->used.setSize (n);
+  memset (cache->used.data(),0,n);
+  dReal tol2 = world->qs.warm_start_tolerance * world->qs.warm_start_tolerance;
+
+  for (dxJoint *j=world->firstjoint; j; j=(dxJoint*)j->next) {
+    if (j->type() != dJointTypeContact) continue;
+    loadContact (cache,(dxJointContact*) j,tol2);
+  }
+  for (int i=0; i<world->contact_slabs.size(); i++) {
+    dxContactSlab *slab = world->contact_slabs[i];
+    for (int k=0; k<slab->count; k++) loadContact (cache,slab->get (k),tol2);
+  }
+}
+
+
+static void saveContact (dxContactCache *cache, dxJointContact *joint)
+{
+  dxCachedContact c;
+  getContactKey (joint,&c.g1,&c.g2,&c.side1,&c.side2,&c.reversed);
+  c.m = joint->the_m;
+  c.pos[0] = joint->contact.geom.pos[0];
+  c.pos[1] = joint->contact.geom.pos[1];
+  c.pos[2] = joint->contact.geom.pos[2];
+  c.lambda[0] = joint->lambda[0];
+  c.lambda[1] = joint->lambda[1];
+  c.lambda[2] = joint->lambda[2];
+  cache->contacts.push (c);
+}
+
+
+void dxContactCacheSave (dxWorld *world)
+{
+  dxContactCache *cache = world->contact_cache;
+  if (!cache) cache = world->contact_cache = new dxContactCache;
+
+  cache->contacts.setSize (0);
+  for (dxJoint *j=world->firstjoint; j; j=(dxJoint*)j->next) {
+    if (j->type() != dJointTypeContact) continue;
+    saveContact (cache,(dxJointContact*) j);
+  }
+  for (int i=0; i<world->contact_slabs.size(); i++) {
+    dxContactSlab *slab = world->contact_slabs[i];
+    for (int k=0; k<slab->count; k++) saveContact (cache,slab->get (k));
+  }
+
+  // rebuild the hash table, keeping it at most half full
+  int n = cache->contacts.size();
+  int size = 16;
+  while (size < 2*n) size *= 2;
+  cache->buckets.setSize (size);
+  int *buckets = cache->buckets.data();
+  for (int i=0; i<size; i++) buckets[i] = -1;
+  dxCachedContact *contacts = cache->contacts.data();
+  for (int i=0; i<n; i++) {
+    dxCachedContact *c = contacts + i;
+    unsigned int h = hashContactKey (c->g1,c->g2,c->side1,c->side2) & (size-1);
+    c->next = buckets[h];
+    buckets[h] = i;
+  }
+}
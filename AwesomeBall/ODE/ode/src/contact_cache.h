@@ -0,0 +1,55 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+/*
+
+contact cache for warm starting the QuickStep solver.
+
+contact joints are normally thrown away and recreated every step, so the
+lambda they end a step with is lost. when warm starting is on, the lambda of
+every contact joint is saved at the end of dWorldQuickStep(), keyed by geom
+pair and contact features, and is loaded into the matching contact joint of
+the next step before the solver runs.
+
+*/
+
+#ifndef _ODE_CONTACT_CACHE_H_
+#define _ODE_CONTACT_CACHE_H_
+
+#include <ode/common.h>
+#include "objects.h"
+
+
+struct dxContactCache;
+
+void dxContactCacheDestroy (dxContactCache *cache);
+
+// copy the cached lambda into every contact joint of the world that matches
+// a contact of the previous step. call this before the islands are stepped.
+void dxContactCacheLoad (dxWorld *world);
+
+// replace the cache contents with the lambda of all contact joints of the
+// world. call this after the islands are stepped.
+void dxContactCacheSave (dxWorld *world);
+
+
+#endif
@@ -29,9 +29,39 @@
 //****************************************************************************
 // contact
 
-dxJointContact::dxJointContact( dxWorld *w ) :
-        dxJoint( w )
+// the surface modes that have a getInfo2() of their own. for these, every
+// test of the mode is resolved at compile time.
+#define FAST_MODES ( dContactBounce | dContactSoftERP | dContactSoftCFM | \
+                     dContactApprox1 )
+
+// the mode of fast variant `i', i = 0..15
+template <int i> struct FastMode
+{
+    enum { mode = ( ( i & 1 ) ? dContactBounce : 0 ) |
+                  ( ( i & 2 ) ? dContactSoftERP : 0 ) |
+                  ( ( i & 4 ) ? dContactSoftCFM : 0 ) |
+                  ( ( i & 8 ) ? dContactApprox1 : 0 ) };
+};
+
+
+dxJointContact::dxJointContact( dxWorld *w, bool listed ) :
+        dxJoint( w, listed )
+{
+    the_m = 0;
+    fast = -1;
+}
+
+
+dxJointContact *
+dxContactSlab::create()
 {
+    if ( count == blocks.size() * dCONTACT_SLAB_BLOCK )
+        blocks.push( ( dxJointContact* ) dAlloc( dCONTACT_SLAB_BLOCK *
+                                                 sizeof( dxJointContact ) ) );
+    dxJointContact *j = new( get( count ) ) dxJointContact( world, false );
+    count++;
+    j->flags |= dJOINT_INGROUP | dJOINT_INSLAB;
+    return j;
 }
 
 
@@ -59,18 +89,45 @@ dxJointContact::getInfo1( dxJoint::Info1 *info )
     the_m = m;
     info->m = m;
     info->nub = nub;
+
+    // pick the getInfo2() variant here, as the mode can change between steps.
+    // the approximation has to be the same for both friction directions.
+    const int mode = contact.surface.mode;
+    const int approx = mode & dContactApprox1;
+    if ( ( mode & ~FAST_MODES ) == 0 &&
+            ( approx == 0 || approx == dContactApprox1 ) )
+    {
+        fast = ( ( mode & dContactBounce ) ? 1 : 0 ) |
+               ( ( mode & dContactSoftERP ) ? 2 : 0 ) |
+               ( ( mode & dContactSoftCFM ) ? 4 : 0 ) |
+               ( approx ? 8 : 0 );
+    }
+    else fast = -1;
 }
 
 
-void
-dxJointContact::getInfo2( dxJoint::Info2 *info )
+// test a mode flag. flags in `known' are taken from `mode', the others from
+// the contact.
+template <int known, int mode>
+static inline bool
+hasMode( const dxJointContact *j, int flag )
 {
+    if ( ( known & flag ) == flag ) return ( mode & flag ) != 0;
+    return ( j->contact.surface.mode & flag ) != 0;
+}
+
+
+template <int known, int mode>
+static void
+contactInfo2( dxJointContact *j, dxJoint::Info2 *info )
+{
+    const dContact &contact = j->contact;
     int s = info->rowskip;
     int s2 = 2 * s;
 
     // get normal, with sign adjusted for body1/body2 polarity
     dVector3 normal;
-    if ( flags & dJOINT_REVERSE )
+    if ( j->flags & dJOINT_REVERSE )
     {
         normal[0] = - contact.geom.normal[0];
         normal[1] = - contact.geom.normal[1];
@@ -85,21 +142,23 @@ dxJointContact::getInfo2( dxJoint::Info2 *info )
     normal[3] = 0; // @@@ hmmm
 
     // c1,c2 = contact points with respect to body PORs
+    dxBody *b1 = j->node[0].body;
+    dxBody *b2 = j->node[1].body;
     dVector3 c1, c2 = {0,0,0};
-    c1[0] = contact.geom.pos[0] - node[0].body->posr.pos[0];
-    c1[1] = contact.geom.pos[1] - node[0].body->posr.pos[1];
-    c1[2] = contact.geom.pos[2] - node[0].body->posr.pos[2];
+    c1[0] = contact.geom.pos[0] - b1->posr.pos[0];
+    c1[1] = contact.geom.pos[1] - b1->posr.pos[1];
+    c1[2] = contact.geom.pos[2] - b1->posr.pos[2];
 
     // set jacobian for normal
     info->J1l[0] = normal[0];
     info->J1l[1] = normal[1];
     info->J1l[2] = normal[2];
     dCROSS( info->J1a, = , c1, normal );
-    if ( node[1].body )
+    if ( b2 )
     {
-        c2[0] = contact.geom.pos[0] - node[1].body->posr.pos[0];
-        c2[1] = contact.geom.pos[1] - node[1].body->posr.pos[1];
-        c2[2] = contact.geom.pos[2] - node[1].body->posr.pos[2];
+        c2[0] = contact.geom.pos[0] - b2->posr.pos[0];
+        c2[1] = contact.geom.pos[1] - b2->posr.pos[1];
+        c2[2] = contact.geom.pos[2] - b2->posr.pos[2];
         info->J2l[0] = -normal[0];
         info->J2l[1] = -normal[1];
         info->J2l[2] = -normal[2];
@@ -108,38 +167,38 @@ dxJointContact::getInfo2( dxJoint::Info2 *info )
 
     // set right hand side and cfm value for normal
     dReal erp = info->erp;
-    if ( contact.surface.mode & dContactSoftERP )
+    if ( hasMode<known,mode>( j, dContactSoftERP ) )
         erp = contact.surface.soft_erp;
     dReal k = info->fps * erp;
-    dReal depth = contact.geom.depth - world->contactp.min_depth;
+    dReal depth = contact.geom.depth - j->world->contactp.min_depth;
     if ( depth < 0 ) depth = 0;
 
-    if ( contact.surface.mode & dContactSoftCFM )
+    if ( hasMode<known,mode>( j, dContactSoftCFM ) )
         info->cfm[0] = contact.surface.soft_cfm;
 
 
     dReal motionN = 0;
-    if ( contact.surface.mode & dContactMotionN )
+    if ( hasMode<known,mode>( j, dContactMotionN ) )
         motionN = contact.surface.motionN;
 
     const dReal pushout = k * depth + motionN;
     info->c[0] = pushout;
 
     // note: this cap should not limit bounce velocity
-    const dReal maxvel = world->contactp.max_vel;
+    const dReal maxvel = j->world->contactp.max_vel;
     if ( info->c[0] > maxvel )
         info->c[0] = maxvel;
 
     // deal with bounce
-    if ( contact.surface.mode & dContactBounce )
+    if ( hasMode<known,mode>( j, dContactBounce ) )
     {
         // calculate outgoing velocity (-ve for incoming contact)
-        dReal outgoing = dDOT( info->J1l, node[0].body->lvel )
-                         + dDOT( info->J1a, node[0].body->avel );
-        if ( node[1].body )
+        dReal outgoing = dDOT( info->J1l, b1->lvel )
+                         + dDOT( info->J1a, b1->avel );
+        if ( b2 )
         {
-            outgoing += dDOT( info->J2l, node[1].body->lvel )
-                        + dDOT( info->J2a, node[1].body->avel );
+            outgoing += dDOT( info->J2l, b2->lvel )
+                        + dDOT( info->J2a, b2->avel );
         }
         outgoing -= motionN;
         // only apply bounce if the outgoing velocity is greater than the
@@ -160,9 +219,9 @@ dxJointContact::getInfo2( dxJoint::Info2 *info )
     dVector3 t1, t2; // two vectors tangential to normal
 
     // first friction direction
-    if ( the_m >= 2 )
+    if ( j->the_m >= 2 )
     {
-        if ( contact.surface.mode & dContactFDir1 )   // use fdir1 ?
+        if ( hasMode<known,mode>( j, dContactFDir1 ) )   // use fdir1 ?
         {
             t1[0] = contact.fdir1[0];
             t1[1] = contact.fdir1[1];
@@ -177,7 +236,7 @@ dxJointContact::getInfo2( dxJoint::Info2 *info )
         info->J1l[s+1] = t1[1];
         info->J1l[s+2] = t1[2];
         dCROSS( info->J1a + s, = , c1, t1 );
-        if ( node[1].body )
+        if ( b2 )
         {
             info->J2l[s+0] = -t1[0];
             info->J2l[s+1] = -t1[1];
@@ -185,7 +244,7 @@ dxJointContact::getInfo2( dxJoint::Info2 *info )
             dCROSS( info->J2a + s, = -, c2, t1 );
         }
         // set right hand side
-        if ( contact.surface.mode & dContactMotion1 )
+        if ( hasMode<known,mode>( j, dContactMotion1 ) )
         {
             info->c[1] = contact.surface.motion1;
         }
@@ -193,22 +252,22 @@ dxJointContact::getInfo2( dxJoint::Info2 *info )
         // mode
         info->lo[1] = -contact.surface.mu;
         info->hi[1] = contact.surface.mu;
-        if ( contact.surface.mode & dContactApprox1_1 )
+        if ( hasMode<known,mode>( j, dContactApprox1_1 ) )
             info->findex[1] = 0;
 
         // set slip (constraint force mixing)
-        if ( contact.surface.mode & dContactSlip1 )
+        if ( hasMode<known,mode>( j, dContactSlip1 ) )
             info->cfm[1] = contact.surface.slip1;
     }
 
     // second friction direction
-    if ( the_m >= 3 )
+    if ( j->the_m >= 3 )
     {
         info->J1l[s2+0] = t2[0];
         info->J1l[s2+1] = t2[1];
         info->J1l[s2+2] = t2[2];
         dCROSS( info->J1a + s2, = , c1, t2 );
-        if ( node[1].body )
+        if ( b2 )
         {
             info->J2l[s2+0] = -t2[0];
             info->J2l[s2+1] = -t2[1];
@@ -216,13 +275,13 @@ dxJointContact::getInfo2( dxJoint::Info2 *info )
             dCROSS( info->J2a + s2, = -, c2, t2 );
         }
         // set right hand side
-        if ( contact.surface.mode & dContactMotion2 )
+        if ( hasMode<known,mode>( j, dContactMotion2 ) )
         {
             info->c[2] = contact.surface.motion2;
         }
         // set LCP bounds and friction index. this depends on the approximation
         // mode
-        if ( contact.surface.mode & dContactMu2 )
+        if ( hasMode<known,mode>( j, dContactMu2 ) )
         {
             info->lo[2] = -contact.surface.mu2;
             info->hi[2] = contact.surface.mu2;
@@ -232,15 +291,43 @@ dxJointContact::getInfo2( dxJoint::Info2 *info )
             info->lo[2] = -contact.surface.mu;
             info->hi[2] = contact.surface.mu;
         }
-        if ( contact.surface.mode & dContactApprox1_2 )
+        if ( hasMode<known,mode>( j, dContactApprox1_2 ) )
             info->findex[2] = 0;
 
         // set slip (constraint force mixing)
-        if ( contact.surface.mode & dContactSlip2 )
+        if ( hasMode<known,mode>( j, dContactSlip2 ) )
             info->cfm[2] = contact.surface.slip2;
     }
 }
 
+
+// every flag of the surface mode, for the fast variants
+#define ALL_MODES ( dContactMu2 | dContactFDir1 | dContactBounce | \
+                    dContactSoftERP | dContactSoftCFM | dContactMotion1 | \
+                    dContactMotion2 | dContactMotionN | dContactSlip1 | \
+                    dContactSlip2 | dContactApprox1 )
+
+#define FAST_CASE(i) \
+    case i: contactInfo2< ALL_MODES, FastMode<i>::mode >( this, info ); break;
+
+void
+dxJointContact::getInfo2( dxJoint::Info2 *info )
+{
+    switch ( fast )
+    {
+        FAST_CASE(0)  FAST_CASE(1)  FAST_CASE(2)  FAST_CASE(3)
+        FAST_CASE(4)  FAST_CASE(5)  FAST_CASE(6)  FAST_CASE(7)
+        FAST_CASE(8)  FAST_CASE(9)  FAST_CASE(10) FAST_CASE(11)
+        FAST_CASE(12) FAST_CASE(13) FAST_CASE(14) FAST_CASE(15)
+    default:
+        contactInfo2< 0, 0 >( this, info );
+        break;
+    }
+}
+
+#undef FAST_CASE
+
+
 dJointType
 dxJointContact::type() const
 {
@@ -30,9 +30,10 @@
 struct dxJointContact : public dxJoint
 {
     int the_m;   // number of rows computed by getInfo1
+    int fast;    // getInfo2 variant picked by getInfo1, -1 = general case
     dContact contact;
 
-    dxJointContact( dxWorld* w );
+    dxJointContact( dxWorld* w, bool listed = true );
     virtual void getInfo1( Info1* info );
     virtual void getInfo2( Info2* info );
     virtual dJointType type() const;
@@ -40,5 +41,26 @@ struct dxJointContact : public dxJoint
 };
 
 
+// the storage of a contact group. the contacts are kept in blocks that are
+// never moved, so their ids stay valid until the group is emptied, and the
+// blocks are kept for reuse after that. the contacts have no destructors to
+// call, so emptying the group only resets the count.
+
+#define dCONTACT_SLAB_BLOCK 256
+
+struct dxContactSlab : public dBase
+{
+    dxWorld *world;     // 0 once the world has been destroyed
+    dArray<dxJointContact*> blocks;
+    int count;          // contacts in use, from the start of the blocks
+
+    dxJointContact *get( int i )
+    {
+        return blocks[i / dCONTACT_SLAB_BLOCK] + i % dCONTACT_SLAB_BLOCK;
+    }
+    dxJointContact *create();
+};
+
+
 #endif
 
@@ -38,7 +38,7 @@ transform is the identity.
 
 extern void addObjectToList( dObject *obj, dObject **first );
 
-dxJoint::dxJoint( dxWorld *w ) :
+dxJoint::dxJoint( dxWorld *w, bool listed ) :
         dObject( w )
 {
     //printf("constructing %p\n", this);
@@ -52,9 +52,11 @@ dxJoint::dxJoint( dxWorld *w ) :
     node[1].next = 0;
     dSetZero( lambda, 6 );
 
-    addObjectToList( this, ( dObject ** ) &w->firstjoint );
-
-    w->nj++;
+    if ( listed )
+    {
+        addObjectToList( this, ( dObject ** ) &w->firstjoint );
+        w->nj++;
+    }
     feedback = 0;
 }
 
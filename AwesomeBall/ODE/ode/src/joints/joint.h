@@ -45,7 +45,12 @@ enum
     // it must have either zero or two bodies attached.
     dJOINT_TWOBODIES = 4,
 
-    dJOINT_DISABLED = 8
+    dJOINT_DISABLED = 8,
+
+    // if this flag is set, the joint is a contact in a contact group (see
+    // dContactGroupCreate). it is not in the world's joint list, and is only
+    // in its bodies' joint lists while the world is stepped.
+    dJOINT_INSLAB = 16
 };
 
 
@@ -117,7 +122,9 @@ struct dxJoint : public dObject
     dReal lambda[6];            // lambda generated by last step
 
 
-    dxJoint( dxWorld *w );
+    // joints that are not `listed' are not put in the world's joint list and
+    // are not counted in world->nj.
+    dxJoint( dxWorld *w, bool listed = true );
     virtual ~dxJoint();
 
     virtual void getInfo1( Info1* info ) = 0;
@@ -142,7 +149,9 @@ struct dxJointGroup : public dBase
 {
     int num;        // number of joints on the stack
     dObStack stack; // a stack of (possibly differently sized) dxJoint
-};                  // objects.
+                    // objects.
+    dxContactSlab *slab; // storage of a contact group, 0 for other groups
+};
 
 
 // common limit and motor information for a single joint axis of movement
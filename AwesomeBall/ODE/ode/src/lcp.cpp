@@ -116,6 +116,7 @@ submatrix of A. there are two ways we could arrange the rows/columns in AC.
 #include "mat.h"		// for testing
 #include <ode/timer.h>		// for testing
 #include "util.h"
+#include "arena.h"
 
 //***************************************************************************
 // code generation parameters
@@ -370,7 +371,8 @@ struct dLCP {
   dLCP (int _n, int _nub, dReal *_Adata, dReal *_x, dReal *_b, dReal *_w,
 	dReal *_lo, dReal *_hi, dReal *_L, dReal *_d,
 	dReal *_Dell, dReal *_ell, dReal *_tmp,
-	int *_state, int *_findex, int *_p, int *_C, dReal **Arows);
+	int *_state, int *_findex, int *_p, int *_C, dReal **Arows,
+	dxArena *arena);
   // the constructor is given an initial problem description (A,x,b,w) and
   // space for other working data (which the caller may allocate on the stack).
   // some of this data is specific to the fast dLCP implementation.
@@ -433,7 +435,8 @@ struct dLCP {
 dLCP::dLCP (int _n, int _nub, dReal *_Adata, dReal *_x, dReal *_b, dReal *_w,
 	    dReal *_lo, dReal *_hi, dReal *_L, dReal *_d,
 	    dReal *_Dell, dReal *_ell, dReal *_tmp,
-	    int *_state, int *_findex, int *_p, int *_C, dReal **Arows)
+	    int *_state, int *_findex, int *_p, int *_C, dReal **Arows,
+	    dxArena *arena)
 {
   dUASSERT (_findex==0,"slow dLCP object does not support findex array");
 
@@ -474,7 +477,7 @@ dLCP::dLCP (int _n, int _nub, dReal *_Adata, dReal *_x, dReal *_b, dReal *_w,
   // if nub>0, put all indexes 0..nub-1 into C and solve for x
   if (nub > 0) {
     for (i=0; i<nub; i++) memcpy (_L+i*nskip,AROW(i),(i+1)*sizeof(dReal));
-    dFactorLDLT (_L,_d,nub,nskip);
+    dxFactorLDLT (_L,_d,nub,nskip,arena);
     memcpy (x,b,nub*sizeof(dReal));
     dSolveLDLT (_L,_d,x,nub,nskip);
     dSetZero (_w,nub);
@@ -750,7 +753,8 @@ struct dLCP {
   dLCP (int _n, int _nub, dReal *_Adata, dReal *_x, dReal *_b, dReal *_w,
 	dReal *_lo, dReal *_hi, dReal *_L, dReal *_d,
 	dReal *_Dell, dReal *_ell, dReal *_tmp,
-	int *_state, int *_findex, int *_p, int *_C, dReal **Arows);
+	int *_state, int *_findex, int *_p, int *_C, dReal **Arows,
+	dxArena *arena);
   int getNub() { return nub; }
   void transfer_i_to_C (int i);
   void transfer_i_to_N (int i)
@@ -778,7 +782,8 @@ struct dLCP {
 dLCP::dLCP (int _n, int _nub, dReal *_Adata, dReal *_x, dReal *_b, dReal *_w,
 	    dReal *_lo, dReal *_hi, dReal *_L, dReal *_d,
 	    dReal *_Dell, dReal *_ell, dReal *_tmp,
-	    int *_state, int *_findex, int *_p, int *_C, dReal **Arows)
+	    int *_state, int *_findex, int *_p, int *_C, dReal **Arows,
+	    dxArena *arena)
 {
   n = _n;
   nub = _nub;
@@ -852,7 +857,7 @@ dLCP::dLCP (int _n, int _nub, dReal *_Adata, dReal *_x, dReal *_b, dReal *_w,
   // point and solve for x. this puts all indexes 0..nub-1 into C.
   if (nub > 0) {
     for (k=0; k<nub; k++) memcpy (L+k*nskip,AROW(k),(k+1)*sizeof(dReal));
-    dFactorLDLT (L,d,nub,nskip);
+    dxFactorLDLT (L,d,nub,nskip,arena);
     memcpy (x,b,nub*sizeof(dReal));
     dSolveLDLT (L,d,x,nub,nskip);
     dSetZero (w,nub);
@@ -1192,7 +1197,7 @@ void dSolveLCPBasic (int n, dReal *A, dReal *x, dReal *b,
 #endif
 
 
-  dLCP lcp (n,0,A,x,b,w,tmp,tmp,L,d,Dell,ell,tmp,dummy,dummy,p,C,Arows);
+  dLCP lcp (n,0,A,x,b,w,tmp,tmp,L,d,Dell,ell,tmp,dummy,dummy,p,C,Arows,0);
   nub = lcp.getNub();
 
   for (i=0; i<n; i++) {
@@ -1307,8 +1312,14 @@ void dSolveLCPBasic (int n, dReal *A, dReal *x, dReal *b,
 //***************************************************************************
 // an optimized Dantzig LCP driver routine for the lo-hi LCP problem.
 
+#ifndef dUSE_MALLOC_FOR_ALLOCA
+#undef ALLOCA
+#define ALLOCA(t,v,s) t* v = (t*) (arena ? arena->alloc (s) : dALLOCA16(s))
+#endif
+
 void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
-		dReal *w, int nub, dReal *lo, dReal *hi, int *findex)
+		dReal *w, int nub, dReal *lo, dReal *hi, int *findex,
+		dxArena *arena)
 {
   dAASSERT (n>0 && A && x && b && w && lo && hi && nub >= 0 && nub <= n);
 
@@ -1318,7 +1329,7 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
   // if all the variables are unbounded then we can just factor, solve,
   // and return
   if (nub >= n) {
-    dFactorLDLT (A,w,n,nskip);		// use w for d
+    dxFactorLDLT (A,w,n,nskip,arena);	// use w for d
     dSolveLDLT (A,w,b,n,nskip);
     memcpy (x,b,n*sizeof(dReal));
     dSetZero (w,n);
@@ -1452,8 +1463,9 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
 
   // create LCP object. note that tmp is set to delta_w to save space, this
   // optimization relies on knowledge of how tmp is used, so be careful!
-  dLCP *lcp=new dLCP(n,nub,A,x,b,w,lo,hi,L,d,Dell,ell,delta_w,state,findex,p,C,Arows);
-  nub = lcp->getNub();
+  dLCP lcp (n,nub,A,x,b,w,lo,hi,L,d,Dell,ell,delta_w,state,findex,p,C,Arows,
+	    arena);
+  nub = lcp.getNub();
 
   // loop over all indexes nub..n-1. for index i, if x(i),w(i) satisfy the
   // LCP conditions then i is added to the appropriate index set. otherwise
@@ -1499,7 +1511,7 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
 
     // thus far we have not even been computing the w values for indexes
     // greater than i, so compute w[i] now.
-    w[i] = lcp->AiC_times_qC (i,x) + lcp->AiN_times_qN (i,x) - b[i];
+    w[i] = lcp.AiC_times_qC (i,x) + lcp.AiN_times_qN (i,x) - b[i];
 
     // if lo=hi=0 (which can happen for tangential friction when normals are
     // 0) then the index will be assigned to set N with some state. however,
@@ -1513,11 +1525,11 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
 
     // see if x(i),w(i) is in a valid region
     if (lo[i]==0 && w[i] >= 0) {
-      lcp->transfer_i_to_N (i);
+      lcp.transfer_i_to_N (i);
       state[i] = 0;
     }
     else if (hi[i]==0 && w[i] <= 0) {
-      lcp->transfer_i_to_N (i);
+      lcp.transfer_i_to_N (i);
       state[i] = 1;
     }
     else if (w[i]==0) {
@@ -1525,8 +1537,8 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
       // that lo != 0, which means that lo < 0 as lo is not allowed to be +ve,
       // and similarly that hi > 0. this means that the line segment
       // corresponding to set C is at least finite in extent, and we are on it.
-      // NOTE: we must call lcp->solve1() before lcp->transfer_i_to_C()
-      lcp->solve1 (delta_x,i,0,1);
+      // NOTE: we must call lcp.solve1() before lcp.transfer_i_to_C()
+      lcp.solve1 (delta_x,i,0,1);
 
 #ifdef dUSE_MALLOC_FOR_ALLOCA
       if (dMemoryFlag == d_MEMORY_OUT_OF_MEMORY) {
@@ -1544,7 +1556,7 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
       }
 #endif
 
-      lcp->transfer_i_to_C (i);
+      lcp.transfer_i_to_C (i);
     }
     else {
       // we must push x(i) and w(i)
@@ -1560,7 +1572,7 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
 	}
 
 	// compute: delta_x(C) = -dir*A(C,C)\A(C,i)
-	lcp->solve1 (delta_x,i,dir);
+	lcp.solve1 (delta_x,i,dir);
 
 #ifdef dUSE_MALLOC_FOR_ALLOCA
 	if (dMemoryFlag == d_MEMORY_OUT_OF_MEMORY) {
@@ -1582,9 +1594,9 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
 
 	// compute: delta_w = A*delta_x ... note we only care about
         // delta_w(N) and delta_w(i), the rest is ignored
-	lcp->pN_equals_ANC_times_qC (delta_w,delta_x);
-	lcp->pN_plusequals_ANi (delta_w,i,dir);
-        delta_w[i] = lcp->AiC_times_qC (i,delta_x) + lcp->Aii(i)*dirf;
+	lcp.pN_equals_ANC_times_qC (delta_w,delta_x);
+	lcp.pN_plusequals_ANi (delta_w,i,dir);
+        delta_w[i] = lcp.AiC_times_qC (i,delta_x) + lcp.Aii(i)*dirf;
 
 	// find largest step we can take (size=s), either to drive x(i),w(i)
 	// to the valid LCP region or to drive an already-valid variable
@@ -1612,37 +1624,37 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
 	  }
 	}
 
-	for (k=0; k < lcp->numN(); k++) {
-	  if ((state[lcp->indexN(k)]==0 && delta_w[lcp->indexN(k)] < 0) ||
-	      (state[lcp->indexN(k)]!=0 && delta_w[lcp->indexN(k)] > 0)) {
+	for (k=0; k < lcp.numN(); k++) {
+	  if ((state[lcp.indexN(k)]==0 && delta_w[lcp.indexN(k)] < 0) ||
+	      (state[lcp.indexN(k)]!=0 && delta_w[lcp.indexN(k)] > 0)) {
 	    // don't bother checking if lo=hi=0
-	    if (lo[lcp->indexN(k)] == 0 && hi[lcp->indexN(k)] == 0) continue;
-	    dReal s2 = -w[lcp->indexN(k)] / delta_w[lcp->indexN(k)];
+	    if (lo[lcp.indexN(k)] == 0 && hi[lcp.indexN(k)] == 0) continue;
+	    dReal s2 = -w[lcp.indexN(k)] / delta_w[lcp.indexN(k)];
 	    if (s2 < s) {
 	      s = s2;
 	      cmd = 4;
-	      si = lcp->indexN(k);
+	      si = lcp.indexN(k);
 	    }
 	  }
 	}
 
-	for (k=nub; k < lcp->numC(); k++) {
-	  if (delta_x[lcp->indexC(k)] < 0 && lo[lcp->indexC(k)] > -dInfinity) {
-	    dReal s2 = (lo[lcp->indexC(k)]-x[lcp->indexC(k)]) /
-	      delta_x[lcp->indexC(k)];
+	for (k=nub; k < lcp.numC(); k++) {
+	  if (delta_x[lcp.indexC(k)] < 0 && lo[lcp.indexC(k)] > -dInfinity) {
+	    dReal s2 = (lo[lcp.indexC(k)]-x[lcp.indexC(k)]) /
+	      delta_x[lcp.indexC(k)];
 	    if (s2 < s) {
 	      s = s2;
 	      cmd = 5;
-	      si = lcp->indexC(k);
+	      si = lcp.indexC(k);
 	    }
 	  }
-	  if (delta_x[lcp->indexC(k)] > 0 && hi[lcp->indexC(k)] < dInfinity) {
-	    dReal s2 = (hi[lcp->indexC(k)]-x[lcp->indexC(k)]) /
-	      delta_x[lcp->indexC(k)];
+	  if (delta_x[lcp.indexC(k)] > 0 && hi[lcp.indexC(k)] < dInfinity) {
+	    dReal s2 = (hi[lcp.indexC(k)]-x[lcp.indexC(k)]) /
+	      delta_x[lcp.indexC(k)];
 	    if (s2 < s) {
 	      s = s2;
 	      cmd = 6;
-	      si = lcp->indexC(k);
+	      si = lcp.indexC(k);
 	    }
 	  }
 	}
@@ -1664,42 +1676,42 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
 	}
 
 	// apply x = x + s * delta_x
-	lcp->pC_plusequals_s_times_qC (x,s,delta_x);
+	lcp.pC_plusequals_s_times_qC (x,s,delta_x);
 	x[i] += s * dirf;
 
 	// apply w = w + s * delta_w
-	lcp->pN_plusequals_s_times_qN (w,s,delta_w);
+	lcp.pN_plusequals_s_times_qN (w,s,delta_w);
 	w[i] += s * delta_w[i];
 
 	// switch indexes between sets if necessary
 	switch (cmd) {
 	case 1:		// done
 	  w[i] = 0;
-	  lcp->transfer_i_to_C (i);
+	  lcp.transfer_i_to_C (i);
 	  break;
 	case 2:		// done
 	  x[i] = lo[i];
 	  state[i] = 0;
-	  lcp->transfer_i_to_N (i);
+	  lcp.transfer_i_to_N (i);
 	  break;
 	case 3:		// done
 	  x[i] = hi[i];
 	  state[i] = 1;
-	  lcp->transfer_i_to_N (i);
+	  lcp.transfer_i_to_N (i);
 	  break;
 	case 4:		// keep going
 	  w[si] = 0;
-	  lcp->transfer_i_from_N_to_C (si);
+	  lcp.transfer_i_from_N_to_C (si);
 	  break;
 	case 5:		// keep going
 	  x[si] = lo[si];
 	  state[si] = 0;
-	  lcp->transfer_i_from_C_to_N (si);
+	  lcp.transfer_i_from_C_to_N (si);
 	  break;
 	case 6:		// keep going
 	  x[si] = hi[si];
 	  state[si] = 1;
-	  lcp->transfer_i_from_C_to_N (si);
+	  lcp.transfer_i_from_C_to_N (si);
 	  break;
 	}
 
@@ -1709,8 +1721,7 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
   }
 
  done:
-  lcp->unpermute();
-  delete lcp;
+  lcp.unpermute();
 
   UNALLOCA (L);
   UNALLOCA (d);
@@ -1724,6 +1735,11 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
   UNALLOCA (state);
 }
 
+#ifndef dUSE_MALLOC_FOR_ALLOCA
+#undef ALLOCA
+#define ALLOCA(t,v,s) t* v =(t*)dALLOCA16(s)
+#endif
+
 //***************************************************************************
 // accuracy and timing test
 
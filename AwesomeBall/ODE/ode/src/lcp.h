@@ -51,8 +51,19 @@ to be implemented. the first `nub' variables are assumed to have findex < 0.
 #define _ODE_LCP_H_
 
 
+struct dxArena;
+
+// if `arena' is given the work arrays are taken from it rather than from the
+// stack. they are not released, that is up to the caller.
+
 void dSolveLCP (int n, dReal *A, dReal *x, dReal *b, dReal *w,
-		int nub, dReal *lo, dReal *hi, int *findex);
+		int nub, dReal *lo, dReal *hi, int *findex,
+		dxArena *arena = 0);
+
+// dFactorLDLT(), with the work arrays of the blocked factorization taken
+// from `arena' if it is given and from the heap otherwise.
+
+void dxFactorLDLT (dReal *A, dReal *d, int n, int nskip, dxArena *arena);
 
 
 #endif
@@ -24,6 +24,11 @@
 #include "config.h"
 #include <ode/memory.h>
 #include <ode/error.h>
+#include "objects.h"
+
+#if dTHREADS_ENABLED
+#include <pthread.h>
+#endif
 
 
 static dAllocFunction *allocfn = 0;
@@ -93,3 +98,269 @@ void dFree (void *ptr, size_t size)
   if (!ptr) return;
   if (freefn) freefn (ptr,size); else free (ptr);
 }
+
+//****************************************************************************
+// pools for small objects
+//
+// geoms, bodies, joints and posrs are created and destroyed often, e.g. for
+// every projectile that is fired. their memory comes from free lists of
+// fixed size blocks, one list per size class, so that in a steady state no
+// dAlloc() or dFree() calls are made at all.
+//
+// every thread has its own cache of free lists, so that most allocations
+// take no lock. the caches exchange blocks in batches with a shared depot,
+// which also carves new blocks out of chunks from dAlloc(). blocks may be
+// freed by another thread than the one that allocated them. the chunks are
+// only returned by dCloseODE().
+//
+// define dMEMORY_NO_POOLS to use dAlloc() and dFree() directly.
+
+// blocks of up to this size are pooled, in multiples of dPOOL_GRANULE
+#define dPOOL_MAX_SIZE 1024
+#define dPOOL_GRANULE 16
+#define dPOOL_CLASSES (dPOOL_MAX_SIZE / dPOOL_GRANULE)
+
+// blocks moved between a cache and the depot at once. a cache keeps at
+// most twice this many free blocks of every class.
+#define dPOOL_BATCH 32
+
+// least size of the chunks that blocks are carved from
+#define dPOOL_CHUNK_SIZE 16384
+
+
+#ifndef dMEMORY_NO_POOLS
+
+struct dxPoolBlock {
+  dxPoolBlock *next;
+};
+
+// the header of a chunk, padded so that the blocks after it stay aligned
+struct dxPoolChunk {
+  dxPoolChunk *next;
+  size_t size;			// size of the chunk, header included
+  char pad[dPOOL_GRANULE - (2*sizeof(void*)) % dPOOL_GRANULE];
+};
+
+struct dxPoolCache {
+  dxPoolBlock *free[dPOOL_CLASSES];
+  int count[dPOOL_CLASSES];
+  unsigned generation;		// depot generation the blocks belong to
+};
+
+static struct {
+  dxPoolBlock *free[dPOOL_CLASSES];
+  dxPoolChunk *chunks;
+  unsigned generation;		// incremented when the chunks are freed
+} depot;
+
+
+#if dTHREADS_ENABLED
+
+static pthread_mutex_t depot_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t cache_key;
+static pthread_once_t cache_key_once = PTHREAD_ONCE_INIT;
+
+static void lockDepot() { pthread_mutex_lock (&depot_mutex); }
+static void unlockDepot() { pthread_mutex_unlock (&depot_mutex); }
+
+static void releaseCache (void *cache);
+
+static void createCacheKey()
+{
+  pthread_key_create (&cache_key,releaseCache);
+}
+
+static dxPoolCache *getCacheSlot()
+{
+  pthread_once (&cache_key_once,createCacheKey);
+  return (dxPoolCache*) pthread_getspecific (cache_key);
+}
+
+static void setCacheSlot (dxPoolCache *cache)
+{
+  pthread_setspecific (cache_key,cache);
+}
+
+#else
+
+static dxPoolCache *the_cache = 0;
+
+static void lockDepot() {}
+static void unlockDepot() {}
+static dxPoolCache *getCacheSlot() { return the_cache; }
+static void setCacheSlot (dxPoolCache *cache) { the_cache = cache; }
+
+#endif
+
+
+static dxPoolCache *getCache()
+{
+  dxPoolCache *cache = getCacheSlot();
+  if (!cache) {
+    cache = (dxPoolCache*) dAlloc (sizeof(dxPoolCache));
+    memset (cache,0,sizeof(dxPoolCache));
+    cache->generation = depot.generation;
+    setCacheSlot (cache);
+  }
+  else if (cache->generation != depot.generation) {
+    // the blocks were freed by dCloseODE()
+    memset (cache,0,sizeof(dxPoolCache));
+    cache->generation = depot.generation;
+  }
+  return cache;
+}
+
+
+// give all free blocks of a cache back to the depot and free the cache.
+// this is called when a thread exits.
+
+static void releaseCache (void *ptr)
+{
+  dxPoolCache *cache = (dxPoolCache*) ptr;
+  lockDepot();
+  if (cache->generation == depot.generation) {
+    for (int c=0; c<dPOOL_CLASSES; c++) {
+      dxPoolBlock *block = cache->free[c];
+      while (block) {
+	dxPoolBlock *next = block->next;
+	block->next = depot.free[c];
+	depot.free[c] = block;
+	block = next;
+      }
+    }
+  }
+  unlockDepot();
+  dFree (cache,sizeof(dxPoolCache));
+}
+
+
+// get more free blocks of class `c' from the depot, carving a new chunk if
+// it has none left
+
+static void refillCache (dxPoolCache *cache, int c)
+{
+  const size_t block_size = (c+1) * dPOOL_GRANULE;
+  lockDepot();
+  int n = 0;
+  while (n < dPOOL_BATCH && depot.free[c]) {
+    dxPoolBlock *block = depot.free[c];
+    depot.free[c] = block->next;
+    block->next = cache->free[c];
+    cache->free[c] = block;
+    n++;
+  }
+  if (n == 0) {
+    size_t num_blocks = dPOOL_CHUNK_SIZE / block_size;
+    if (num_blocks < dPOOL_BATCH) num_blocks = dPOOL_BATCH;
+    size_t size = sizeof(dxPoolChunk) + num_blocks*block_size;
+    dxPoolChunk *chunk = (dxPoolChunk*) dAlloc (size);
+    chunk->next = depot.chunks;
+    chunk->size = size;
+    depot.chunks = chunk;
+    char *p = (char*) (chunk+1);
+    for (size_t i=0; i<num_blocks; i++, p += block_size) {
+      dxPoolBlock *block = (dxPoolBlock*) p;
+      block->next = cache->free[c];
+      cache->free[c] = block;
+    }
+    n = (int) num_blocks;
+  }
+  unlockDepot();
+  cache->count[c] += n;
+}
+
+
+// give a batch of free blocks of class `c' back to the depot
+
+static void drainCache (dxPoolCache *cache, int c)
+{
+  lockDepot();
+  for (int i=0; i<dPOOL_BATCH; i++) {
+    dxPoolBlock *block = cache->free[c];
+    cache->free[c] = block->next;
+    block->next = depot.free[c];
+    depot.free[c] = block;
+  }
+  unlockDepot();
+  cache->count[c] -= dPOOL_BATCH;
+}
+
+
+void *dxPoolAlloc (size_t size)
+{
+  if (size == 0 || size > dPOOL_MAX_SIZE) return dAlloc (size);
+  const int c = (int) ((size-1) / dPOOL_GRANULE);
+  dxPoolCache *cache = getCache();
+  if (!cache->free[c]) refillCache (cache,c);
+  dxPoolBlock *block = cache->free[c];
+  cache->free[c] = block->next;
+  cache->count[c]--;
+  return block;
+}
+
+
+void dxPoolFree (void *ptr, size_t size)
+{
+  if (!ptr) return;
+  if (size == 0 || size > dPOOL_MAX_SIZE) {
+    dFree (ptr,size);
+    return;
+  }
+  const int c = (int) ((size-1) / dPOOL_GRANULE);
+  dxPoolCache *cache = getCache();
+  dxPoolBlock *block = (dxPoolBlock*) ptr;
+  block->next = cache->free[c];
+  cache->free[c] = block;
+  if (++cache->count[c] > 2*dPOOL_BATCH) drainCache (cache,c);
+}
+
+
+void dxPoolCleanupThread()
+{
+  dxPoolCache *cache = getCacheSlot();
+  if (cache) {
+    setCacheSlot (0);
+    releaseCache (cache);
+  }
+}
+
+
+void dxPoolFinalize()
+{
+  // no thread may use ODE any more, so the blocks in all caches are free
+  dxPoolCleanupThread();
+  lockDepot();
+  while (depot.chunks) {
+    dxPoolChunk *chunk = depot.chunks;
+    depot.chunks = chunk->next;
+    dFree (chunk,chunk->size);
+  }
+  memset (depot.free,0,sizeof(depot.free));
+  depot.generation++;
+  unlockDepot();
+}
+
+#else
+
+void *dxPoolAlloc (size_t size)
+{
+  return dAlloc (size);
+}
+
+
+void dxPoolFree (void *ptr, size_t size)
+{
+  dFree (ptr,size);
+}
+
+
+void dxPoolCleanupThread()
+{
+}
+
+
+void dxPoolFinalize()
+{
+}
+
+#endif
@@ -31,6 +31,13 @@
 #include <ode/mass.h>
 #include "array.h"
 
+struct dxThreadPool;
+struct dxContactCache;
+struct dxArena;
+struct dxProfile;
+struct dxMaterialTable;
+struct dxContactSlab;
+
 
 // some body flags
 
@@ -58,9 +65,28 @@ struct dBase {
 };
 
 
+// pools of small blocks for objects that are created and destroyed often,
+// see memory.cpp. blocks may be freed on another thread than they were
+// allocated on, but must be freed with the size they were allocated with.
+
+void *dxPoolAlloc (size_t size);
+void dxPoolFree (void *ptr, size_t size);
+void dxPoolCleanupThread();	// give this thread's free blocks back
+void dxPoolFinalize();		// free all pools, for dCloseODE()
+
+
+// base class for objects that are allocated from the pools
+
+struct dPooledBase : public dBase {
+  void *operator new (size_t size) { return dxPoolAlloc (size); }
+  void *operator new (size_t, void *p) { return p; }
+  void operator delete (void *ptr, size_t size) { dxPoolFree (ptr,size); }
+};
+
+
 // base class for bodies and joints
 
-struct dObject : public dBase {
+struct dObject : public dPooledBase {
   dxWorld *world;		// world this object is in
   dObject *next;		// next object of this type in list
   dObject **tome;		// pointer to previous object's next ptr
@@ -94,6 +120,15 @@ struct dxDampingParameters {
 struct dxQuickStepParameters {
   int num_iterations;		// number of SOR iterations to perform
   dReal w;			// the SOR over-relaxation parameter
+  dReal warm_start;		// scale for last step's lambda, 0 = no warm start
+  dReal warm_start_tolerance;	// max distance to match up contacts
+};
+
+
+// parameters for picking the solver of every island in dWorldAutoStep()
+struct dxAutoStepParameters {
+  int max_dense_bodies;		// islands up to this size can use dWorldStep's
+  int max_dense_rows;		// ...LCP solver, if they have this few rows
 };
 
 
@@ -153,9 +188,19 @@ struct dxWorld : public dBase {
   dxAutoDisable adis;		// auto-disable parameters
   int body_flags;               // flags for new bodies
   dxQuickStepParameters qs;
+  dxAutoStepParameters autostep;
   dxContactParameters contactp;
   dxDampingParameters dampingp; // damping parameters
   dReal max_angular_speed;      // limit the angular velocity to this magnitude
+  int island_threads;		// max number of threads used to step islands
+  dxThreadPool *island_pool;	// created on demand if island_threads > 1
+  dArray<dxArena*> step_arenas;	// temporaries of the steppers, one per thread
+  unsigned long dense_islands;	// islands stepped with the dense LCP solver
+  unsigned long quick_islands;	// islands stepped with QuickStep
+  dxContactCache *contact_cache;// contact lambdas kept for warm starting
+  dxProfile *profile;		// 0 unless the world is being profiled
+  dxMaterialTable *materials;	// surfaces of contacts between materials
+  dArray<dxContactSlab*> contact_slabs; // storage of the contact groups
 };
 
 
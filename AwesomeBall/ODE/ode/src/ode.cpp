@@ -35,6 +35,11 @@
 #include "step.h"
 #include "quickstep.h"
 #include "util.h"
+#include "threading.h"
+#include "contact_cache.h"
+#include "arena.h"
+#include "profile.h"
+#include "batch.h"
 #include <ode/memory.h>
 #include <ode/error.h>
 
@@ -317,6 +322,21 @@ void dBodyDestroy (dxBody *b)
     removeJointReferencesFromAttachedBodies (n->joint);
     n = next;
   }
+
+  // the contacts of contact groups are not in the body's joint list, so they
+  // have to be looked for.
+  dxWorld *w = b->world;
+  for (int i=0; i<w->contact_slabs.size(); i++) {
+    dxContactSlab *slab = w->contact_slabs[i];
+    for (int k=0; k<slab->count; k++) {
+      dxJointContact *j = slab->get (k);
+      if (j->node[0].body == b || j->node[1].body == b) {
+	j->node[0].body = 0;
+	j->node[1].body = 0;
+      }
+    }
+  }
+
   removeObjectFromList (b);
   b->world->nb--;
 
@@ -1160,12 +1180,13 @@ void dBodySetGyroscopicMode(dBodyID b, int enabled)
 template<class T>
 dxJoint* createJoint(dWorldID w, dJointGroupID group)
 {
+    dUASSERT (!group || !group->slab,"only contacts can be put in a contact group");
     dxJoint *j;
     if (group) {
         j = (dxJoint*) group->stack.alloc(sizeof(T));
         group->num++;
     } else
-        j = (dxJoint*) dAlloc(sizeof(T));
+        j = (dxJoint*) dxPoolAlloc(sizeof(T));
     
     new(j) T(w);
     if (group)
@@ -1175,6 +1196,19 @@ dxJoint* createJoint(dWorldID w, dJointGroupID group)
 }
 
 
+// create a contact joint, in the slab of a contact group if it has one
+
+static inline dxJointContact *createContact (dWorldID w, dJointGroupID group)
+{
+    if (group && group->slab) {
+        dUASSERT (group->slab->world == w,"contact group is of another world");
+        group->num++;
+        return group->slab->create();
+    }
+    return (dxJointContact *) createJoint<dxJointContact> (w,group);
+}
+
+
 dxJoint * dJointCreateBall (dWorldID w, dJointGroupID group)
 {
     dAASSERT (w);
@@ -1200,13 +1234,47 @@ dxJoint * dJointCreateContact (dWorldID w, dJointGroupID group,
 			       const dContact *c)
 {
     dAASSERT (w && c);
-    dxJointContact *j = (dxJointContact *)
-        createJoint<dxJointContact> (w,group);
+    dxJointContact *j = createContact (w,group);
     j->contact = *c;
     return j;
 }
 
 
+int dJointCreateContacts (dWorldID w, dJointGroupID group,
+			  dContactBatchID batch, dMaterialTableID materials)
+{
+    dAASSERT (w && batch);
+    if (!materials) materials = w->materials;
+    dSurfaceParameters default_surface;
+    memset (&default_surface,0,sizeof(default_surface));
+    default_surface.mu = dInfinity;
+
+    const dContactBatchPair *pair = batch->pairs.data();
+    const dContactGeom *contact = batch->contacts.data();
+    const int num_pairs = batch->pairs.size();
+    for (int i=0; i<num_pairs; i++) {
+        // everything that is the same for the contacts of a pair is looked
+        // up once
+        const dSurfaceParameters *surface = &default_surface;
+        if (materials)
+            surface = materials->get (dGeomGetMaterial (pair[i].g1),
+                                      dGeomGetMaterial (pair[i].g2));
+        dxBody *b1 = dGeomGetBody (pair[i].g1);
+        dxBody *b2 = dGeomGetBody (pair[i].g2);
+
+        const dContactGeom *c = contact + pair[i].first;
+        for (int k=0; k<pair[i].count; k++) {
+            dxJointContact *j = createContact (w,group);
+            j->contact.surface = *surface;
+            j->contact.geom = c[k];
+            dSetZero (j->contact.fdir1,4);
+            dJointAttach (j,b1,b2);
+        }
+    }
+    return batch->contacts.size();
+}
+
+
 dxJoint * dJointCreateHinge2 (dWorldID w, dJointGroupID group)
 {
     dAASSERT (w);
@@ -1279,7 +1347,7 @@ void dJointDestroy (dxJoint *j)
     removeObjectFromList (j);
     j->world->nj--;
     j->~dxJoint();
-    dFree (j, sz);
+    dxPoolFree (j, sz);
 }
 
 
@@ -1288,6 +1356,20 @@ dJointGroupID dJointGroupCreate (int max_size)
     // not any more ... dUASSERT (max_size > 0,"max size must be > 0");
     dxJointGroup *group = new dxJointGroup;
     group->num = 0;
+    group->slab = 0;
+    return group;
+}
+
+
+dJointGroupID dContactGroupCreate (dWorldID w)
+{
+    dAASSERT (w);
+    dxJointGroup *group = new dxJointGroup;
+    group->num = 0;
+    group->slab = new dxContactSlab;
+    group->slab->world = w;
+    group->slab->count = 0;
+    w->contact_slabs.push (group->slab);
     return group;
 }
 
@@ -1296,6 +1378,22 @@ void dJointGroupDestroy (dJointGroupID group)
 {
     dAASSERT (group);
     dJointGroupEmpty (group);
+    dxContactSlab *slab = group->slab;
+    if (slab) {
+        if (slab->world) {
+            dArray<dxContactSlab*> &slabs = slab->world->contact_slabs;
+            for (int i=0; i<slabs.size(); i++) {
+                if (slabs[i] == slab) {
+                    slabs[i] = slabs[slabs.size()-1];
+                    slabs.setSize (slabs.size()-1);
+                    break;
+                }
+            }
+        }
+        for (int i=0; i<slab->blocks.size(); i++)
+            dFree (slab->blocks[i],dCONTACT_SLAB_BLOCK*sizeof(dxJointContact));
+        delete slab;
+    }
     delete group;
 }
 
@@ -1310,6 +1408,15 @@ void dJointGroupEmpty (dJointGroupID group)
     // previously destroyed. no special handling is required for these joints.
     
     dAASSERT (group);
+
+    // the contacts of a contact group are in no lists and have nothing to
+    // destruct, so their memory is just reused.
+    if (group->slab) {
+        group->slab->count = 0;
+        group->num = 0;
+        return;
+    }
+
     int i;
     dxJoint **jlist = (dxJoint**) ALLOCA (group->num * sizeof(dxJoint*));
     dxJoint *j = (dxJoint*) group->stack.rewind();
@@ -1358,8 +1465,10 @@ void dJointAttach (dxJoint *joint, dxBody *body1, dxBody *body2)
 	      ((body1 != 0) ^ (body2 != 0))),
 	    "joint can not be attached to just one body");
 
-  // remove any existing body attachments
-  if (joint->node[0].body || joint->node[1].body) {
+  // remove any existing body attachments. the contacts of contact groups are
+  // only in their bodies' lists while the world is stepped.
+  const bool listed = !(joint->flags & dJOINT_INSLAB);
+  if (listed && (joint->node[0].body || joint->node[1].body)) {
     removeJointReferencesFromAttachedBodies (joint);
   }
 
@@ -1376,12 +1485,12 @@ void dJointAttach (dxJoint *joint, dxBody *body1, dxBody *body2)
   // attach to new bodies
   joint->node[0].body = body1;
   joint->node[1].body = body2;
-  if (body1) {
+  if (body1 && listed) {
     joint->node[1].next = body1->firstjoint;
     body1->firstjoint = &joint->node[1];
   }
   else joint->node[1].next = 0;
-  if (body2) {
+  if (body2 && listed) {
     joint->node[0].next = body2->firstjoint;
     body2->firstjoint = &joint->node[0];
   }
@@ -1564,6 +1673,11 @@ dxWorld * dWorldCreate()
 
   w->qs.num_iterations = 20;
   w->qs.w = REAL(1.3);
+  w->qs.warm_start = 0;
+  w->qs.warm_start_tolerance = REAL(0.05);
+
+  w->autostep.max_dense_bodies = 8;
+  w->autostep.max_dense_rows = 32;
 
   w->contactp.max_vel = dInfinity;
   w->contactp.min_depth = 0;
@@ -1574,6 +1688,14 @@ dxWorld * dWorldCreate()
   w->dampingp.angular_threshold = REAL(0.01) * REAL(0.01);  
   w->max_angular_speed = dInfinity;
 
+  w->island_threads = 1;
+  w->island_pool = 0;
+  w->contact_cache = 0;
+  w->dense_islands = 0;
+  w->quick_islands = 0;
+  w->profile = 0;
+  w->materials = 0;
+
   return w;
 }
 
@@ -1614,10 +1736,19 @@ void dWorldDestroy (dxWorld *w)
     else {
         size_t sz = j->size();
         j->~dxJoint();
-        dFree (j,sz);
+        dxPoolFree (j,sz);
     }
     j = nextj;
   }
+  // contact groups outlive the world, so they are only cut off from it
+  for (int i=0; i<w->contact_slabs.size(); i++) {
+    w->contact_slabs[i]->world = 0;
+    w->contact_slabs[i]->count = 0;
+  }
+  if (w->island_pool) delete w->island_pool;
+  if (w->contact_cache) dxContactCacheDestroy (w->contact_cache);
+  for (int i=0; i<w->step_arenas.size(); i++) delete w->step_arenas[i];
+  if (w->profile) delete w->profile;
   delete w;
 }
 
@@ -1668,11 +1799,57 @@ dReal dWorldGetCFM (dWorldID w)
 }
 
 
+// the island steppers of dWorldStep(), dWorldQuickStep() and
+// dWorldAutoStep(). they count the islands that were stepped with each
+// solver. islands may be stepped on several threads at once.
+
+static void denseStepIsland (dxWorld *world, dxBody * const *body, int nb,
+			     dxJoint * const *joint, int nj, dReal stepsize,
+			     dxArena *arena)
+{
+  dxAtomicIncrement (&world->dense_islands);
+  dInternalStepIsland (world,body,nb,joint,nj,stepsize,arena);
+}
+
+
+static void quickStepIsland (dxWorld *world, dxBody * const *body, int nb,
+			     dxJoint * const *joint, int nj, dReal stepsize,
+			     dxArena *arena)
+{
+  dxAtomicIncrement (&world->quick_islands);
+  dxQuickStepper (world,body,nb,joint,nj,stepsize,arena);
+}
+
+
+static void autoStepIsland (dxWorld *world, dxBody * const *body, int nb,
+			    dxJoint * const *joint, int nj, dReal stepsize,
+			    dxArena *arena)
+{
+  // the dense solver is O(m^3) in the number of constraint rows m, so it
+  // is only used for small islands. the rows are counted the same way the
+  // steppers count them.
+  int dense = (nb <= world->autostep.max_dense_bodies);
+  if (dense) {
+    int m = 0;
+    for (int i=0; i<nj; i++) {
+      dxJoint::Info1 info;
+      joint[i]->getInfo1 (&info);
+      m += info.m;
+    }
+    dense = (m <= world->autostep.max_dense_rows);
+  }
+
+  if (dense) denseStepIsland (world,body,nb,joint,nj,stepsize,arena);
+  else quickStepIsland (world,body,nb,joint,nj,stepsize,arena);
+}
+
+
 void dWorldStep (dWorldID w, dReal stepsize)
 {
   dUASSERT (w,"bad world argument");
   dUASSERT (stepsize > 0,"stepsize must be > 0");
-  dxProcessIslands (w,stepsize,&dInternalStepIsland);
+  dxProcessIslands (w,stepsize,&denseStepIsland);
+  if (w->profile) w->profile->endFrame();
 }
 
 
@@ -1680,7 +1857,21 @@ void dWorldQuickStep (dWorldID w, dReal stepsize)
 {
   dUASSERT (w,"bad world argument");
   dUASSERT (stepsize > 0,"stepsize must be > 0");
-  dxProcessIslands (w,stepsize,&dxQuickStepper);
+  if (w->qs.warm_start > 0) dxContactCacheLoad (w);
+  dxProcessIslands (w,stepsize,&quickStepIsland);
+  if (w->qs.warm_start > 0) dxContactCacheSave (w);
+  if (w->profile) w->profile->endFrame();
+}
+
+
+void dWorldAutoStep (dWorldID w, dReal stepsize)
+{
+  dUASSERT (w,"bad world argument");
+  dUASSERT (stepsize > 0,"stepsize must be > 0");
+  if (w->qs.warm_start > 0) dxContactCacheLoad (w);
+  dxProcessIslands (w,stepsize,&autoStepIsland);
+  if (w->qs.warm_start > 0) dxContactCacheSave (w);
+  if (w->profile) w->profile->endFrame();
 }
 
 
@@ -1896,6 +2087,233 @@ dReal dWorldGetQuickStepW (dWorldID w)
 }
 
 
+void dWorldSetQuickStepWarmStarting (dWorldID w, dReal factor)
+{
+	dAASSERT(w);
+	dUASSERT (factor >= 0 && factor <= 1,"warm start factor must be in [0,1]");
+	w->qs.warm_start = factor;
+	// forget the cached contacts, they may be stale by the time warm
+	// starting is turned back on
+	if (factor == 0 && w->contact_cache) {
+		dxContactCacheDestroy (w->contact_cache);
+		w->contact_cache = 0;
+	}
+}
+
+
+dReal dWorldGetQuickStepWarmStarting (dWorldID w)
+{
+	dAASSERT(w);
+	return w->qs.warm_start;
+}
+
+
+void dWorldSetQuickStepWarmStartTolerance (dWorldID w, dReal distance)
+{
+	dAASSERT(w);
+	dUASSERT (distance >= 0,"warm start tolerance must be >= 0");
+	w->qs.warm_start_tolerance = distance;
+}
+
+
+dReal dWorldGetQuickStepWarmStartTolerance (dWorldID w)
+{
+	dAASSERT(w);
+	return w->qs.warm_start_tolerance;
+}
+
+
+void dWorldSetStepIslandsProcessingMaxThreadCount (dWorldID w, int count)
+{
+	dAASSERT(w);
+	dUASSERT (count >= 1,"thread count must be >= 1");
+	if (count == w->island_threads) return;
+	w->island_threads = count;
+	// the pool is recreated with the new size on the next step
+	if (w->island_pool) {
+		delete w->island_pool;
+		w->island_pool = 0;
+	}
+	// drop the arenas of threads that are gone
+	while (w->step_arenas.size() > count) {
+		delete w->step_arenas[w->step_arenas.size()-1];
+		w->step_arenas.setSize (w->step_arenas.size()-1);
+	}
+}
+
+
+int dWorldGetStepIslandsProcessingMaxThreadCount (dWorldID w)
+{
+	dAASSERT(w);
+	return w->island_threads;
+}
+
+
+void dWorldSetAutoStepThresholds (dWorldID w, int max_dense_bodies,
+				  int max_dense_rows)
+{
+	dAASSERT(w);
+	w->autostep.max_dense_bodies = max_dense_bodies;
+	w->autostep.max_dense_rows = max_dense_rows;
+}
+
+
+void dWorldGetAutoStepThresholds (dWorldID w, int *max_dense_bodies,
+				  int *max_dense_rows)
+{
+	dAASSERT(w);
+	if (max_dense_bodies) *max_dense_bodies = w->autostep.max_dense_bodies;
+	if (max_dense_rows) *max_dense_rows = w->autostep.max_dense_rows;
+}
+
+
+void dWorldGetSolverIslandCounts (dWorldID w, unsigned long *dense,
+				  unsigned long *quick)
+{
+	dAASSERT(w);
+	if (dense) *dense = w->dense_islands;
+	if (quick) *quick = w->quick_islands;
+}
+
+
+void dWorldResetSolverIslandCounts (dWorldID w)
+{
+	dAASSERT(w);
+	w->dense_islands = 0;
+	w->quick_islands = 0;
+}
+
+
+void dWorldGetStepMemoryStats (dWorldID w, dWorldStepMemoryStats *stats)
+{
+	dAASSERT(w && stats);
+	stats->peak = 0;
+	stats->reserved = 0;
+	stats->heap_allocations = 0;
+	for (int i=0; i<w->step_arenas.size(); i++) {
+		dxArena *arena = w->step_arenas[i];
+		stats->peak += arena->peak;
+		stats->reserved += arena->reserved;
+		stats->heap_allocations += arena->heap_allocations;
+	}
+}
+
+
+// the value of body `i' in a state buffer, see dBodyStateBuffers
+
+static inline dReal *bodyStateValue (dReal *base, int stride, int n, int i)
+{
+	if (stride == 0) stride = n * sizeof(dReal);
+	return (dReal*) ((char*) base + (size_t) i * stride);
+}
+
+
+void dWorldGetBodyStates (dWorldID w, const dBodyID *bodies, int count,
+			  const dBodyStateBuffers *buffers)
+{
+	dAASSERT(w && (bodies || count == 0) && buffers);
+	const dBodyStateBuffers &buf = *buffers;
+	for (int i=0; i<count; i++) {
+		const dxBody *b = bodies[i];
+		dUASSERT (b && b->world == w,"body is not in this world");
+		if (buf.pos) {
+			dReal *p = bodyStateValue (buf.pos,buf.pos_stride,3,i);
+			p[0] = b->posr.pos[0];
+			p[1] = b->posr.pos[1];
+			p[2] = b->posr.pos[2];
+		}
+		if (buf.quat) {
+			dReal *q = bodyStateValue (buf.quat,buf.quat_stride,4,i);
+			q[0] = b->q[0];
+			q[1] = b->q[1];
+			q[2] = b->q[2];
+			q[3] = b->q[3];
+		}
+		if (buf.matrix) {
+			// column-major, as GL wants: the upper 3x3 is R, the last column is pos
+			dReal *m = bodyStateValue (buf.matrix,buf.matrix_stride,16,i);
+			const dReal *R = b->posr.R;
+			m[0] = R[0]; m[4] = R[1]; m[8] = R[2];  m[12] = b->posr.pos[0];
+			m[1] = R[4]; m[5] = R[5]; m[9] = R[6];  m[13] = b->posr.pos[1];
+			m[2] = R[8]; m[6] = R[9]; m[10] = R[10]; m[14] = b->posr.pos[2];
+			m[3] = 0;    m[7] = 0;    m[11] = 0;     m[15] = 1;
+		}
+		if (buf.lvel) {
+			dReal *v = bodyStateValue (buf.lvel,buf.lvel_stride,3,i);
+			v[0] = b->lvel[0];
+			v[1] = b->lvel[1];
+			v[2] = b->lvel[2];
+		}
+		if (buf.avel) {
+			dReal *v = bodyStateValue (buf.avel,buf.avel_stride,3,i);
+			v[0] = b->avel[0];
+			v[1] = b->avel[1];
+			v[2] = b->avel[2];
+		}
+	}
+}
+
+
+void dWorldSetBodyStates (dWorldID w, const dBodyID *bodies, int count,
+			  const dBodyStateBuffers *buffers)
+{
+	dAASSERT(w && (bodies || count == 0) && buffers);
+	const dBodyStateBuffers &buf = *buffers;
+	dUASSERT (!buf.matrix || (!buf.pos && !buf.quat),
+		  "a matrix can not be set together with positions or quaternions");
+	const bool moved = buf.pos || buf.quat || buf.matrix;
+	for (int i=0; i<count; i++) {
+		dxBody *b = bodies[i];
+		dUASSERT (b && b->world == w,"body is not in this world");
+		if (buf.pos) {
+			const dReal *p = bodyStateValue (buf.pos,buf.pos_stride,3,i);
+			b->posr.pos[0] = p[0];
+			b->posr.pos[1] = p[1];
+			b->posr.pos[2] = p[2];
+		}
+		if (buf.quat) {
+			const dReal *q = bodyStateValue (buf.quat,buf.quat_stride,4,i);
+			b->q[0] = q[0];
+			b->q[1] = q[1];
+			b->q[2] = q[2];
+			b->q[3] = q[3];
+			dNormalize4 (b->q);
+			dQtoR (b->q,b->posr.R);
+		}
+		if (buf.matrix) {
+			const dReal *m = bodyStateValue (buf.matrix,buf.matrix_stride,16,i);
+			dReal *R = b->posr.R;
+			R[0] = m[0]; R[1] = m[4]; R[2] = m[8];   R[3] = 0;
+			R[4] = m[1]; R[5] = m[5]; R[6] = m[9];   R[7] = 0;
+			R[8] = m[2]; R[9] = m[6]; R[10] = m[10]; R[11] = 0;
+			dOrthogonalizeR (R);
+			dRtoQ (R,b->q);
+			dNormalize4 (b->q);
+			b->posr.pos[0] = m[12];
+			b->posr.pos[1] = m[13];
+			b->posr.pos[2] = m[14];
+		}
+		if (buf.lvel) {
+			const dReal *v = bodyStateValue (buf.lvel,buf.lvel_stride,3,i);
+			b->lvel[0] = v[0];
+			b->lvel[1] = v[1];
+			b->lvel[2] = v[2];
+		}
+		if (buf.avel) {
+			const dReal *v = bodyStateValue (buf.avel,buf.avel_stride,3,i);
+			b->avel[0] = v[0];
+			b->avel[1] = v[1];
+			b->avel[2] = v[2];
+		}
+		// notify all attached geoms that this body has moved
+		if (moved) {
+			for (dxGeom *geom = b->geom; geom; geom = dGeomGetBodyNext (geom))
+				dGeomMoved (geom);
+		}
+	}
+}
+
+
 void dWorldSetContactMaxCorrectingVel (dWorldID w, dReal vel)
 {
 	dAASSERT(w);
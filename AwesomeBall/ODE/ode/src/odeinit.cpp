@@ -386,6 +386,8 @@ void dCleanupODEAllDataForThread()
 #if dTLS_ENABLED
 	COdeTls::CleanupForThread();
 #endif
+
+	dxPoolCleanupThread();
 }
 
 
@@ -395,7 +397,7 @@ void dCloseODE()
 
 	g_bODEInitialized = false;
 
-	dClearPosrCache();
+	dxPoolFinalize();
 	dFinitUserClasses();
 	dFinitColliders();
 
@@ -0,0 +1,441 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+#include <ode/common.h>
+#include <ode/error.h>
+#include <ode/memory.h>
+#include <ode/profile.h>
+#include "config.h"
+#include "objects.h"
+#include "collision_kernel.h"
+#include "threading.h"
+#include "profile.h"
+#include <string.h>
+
+#if defined(WIN32)
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
+
+#if dTHREADS_ENABLED
+#include <pthread.h>
+#endif
+
+//****************************************************************************
+// clock
+
+#if defined(WIN32)
+
+dxProfileTime dxProfileNow()
+{
+  static double scale = 0;
+  if (scale == 0) {
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency (&freq);
+    scale = 1e9 / double(freq.QuadPart);
+  }
+  LARGE_INTEGER count;
+  QueryPerformanceCounter (&count);
+  return (dxProfileTime) (double(count.QuadPart) * scale);
+}
+
+#elif defined(__APPLE__)
+
+dxProfileTime dxProfileNow()
+{
+  static mach_timebase_info_data_t timebase = {0,0};
+  if (timebase.denom == 0) mach_timebase_info (&timebase);
+  return mach_absolute_time() * timebase.numer / timebase.denom;
+}
+
+#else
+
+dxProfileTime dxProfileNow()
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC,&ts);
+  return dxProfileTime(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+#endif
+
+//****************************************************************************
+// per-thread state
+
+struct dxProfileThread {
+  dxProfile *collision;		// current collision profile
+  dxProfileScope *scope;	// innermost scope that is running
+  int id;			// thread number for the trace
+};
+
+static unsigned long next_thread_id = 0;
+
+
+static dxProfileThread *newProfileThread()
+{
+  dxProfileThread *thread = (dxProfileThread*) dAlloc (sizeof(dxProfileThread));
+  thread->collision = 0;
+  thread->scope = 0;
+  thread->id = (int) dxAtomicAdd (&next_thread_id,1);
+  return thread;
+}
+
+
+#if dTHREADS_ENABLED
+
+static pthread_key_t thread_key;
+static pthread_once_t thread_key_once = PTHREAD_ONCE_INIT;
+
+static void freeProfileThread (void *thread)
+{
+  dFree (thread,sizeof(dxProfileThread));
+}
+
+
+static void createThreadKey()
+{
+  pthread_key_create (&thread_key,&freeProfileThread);
+}
+
+
+static dxProfileThread *getProfileThread()
+{
+  pthread_once (&thread_key_once,createThreadKey);
+  dxProfileThread *thread = (dxProfileThread*) pthread_getspecific (thread_key);
+  if (!thread) {
+    thread = newProfileThread();
+    pthread_setspecific (thread_key,thread);
+  }
+  return thread;
+}
+
+#else
+
+static dxProfileThread *getProfileThread()
+{
+  static dxProfileThread *thread = 0;
+  if (!thread) thread = newProfileThread();
+  return thread;
+}
+
+#endif
+
+//****************************************************************************
+// scopes
+
+void dxProfileScope::begin (int _zone, int _pair)
+{
+  dxProfileThread *thread = getProfileThread();
+  zone = _zone;
+  pair = _pair;
+  children = 0;
+  parent = thread->scope;
+  thread->scope = this;
+  start = dxProfileNow();
+}
+
+
+void dxProfileScope::end()
+{
+  dxProfileTime duration = dxProfileNow() - start;
+  dxProfileThread *thread = getProfileThread();
+  thread->scope = parent;
+  if (parent) parent->children += duration;
+  dxProfileTime exclusive = (duration > children) ? duration - children : 0;
+  profile->record (zone,pair,contacts,thread->id,start,duration,exclusive);
+}
+
+
+unsigned long dxProfileCollisionActive = 0;
+
+
+dxProfileCollision::dxProfileCollision (dxProfile *profile) :
+  saved (0), scope (profile,dProfileBroadphase)
+{
+  if (profile) {
+    dxProfileThread *thread = getProfileThread();
+    saved = thread->collision;
+    thread->collision = profile;
+    dxAtomicIncrement (&dxProfileCollisionActive);
+  }
+}
+
+
+dxProfileCollision::~dxProfileCollision()
+{
+  // a space without a profile leaves the current one in place, see above
+  if (scope.isActive()) {
+    getProfileThread()->collision = saved;
+    dxAtomicAdd (&dxProfileCollisionActive,(unsigned long)(-1L));
+  }
+}
+
+
+dxProfile *dxProfileGetCollision()
+{
+  return getProfileThread()->collision;
+}
+
+//****************************************************************************
+// dxProfile
+
+dxProfile::dxProfile()
+{
+  trace = 0;
+  trace_capacity = 0;
+  reset();
+}
+
+
+dxProfile::~dxProfile()
+{
+  setTrace (0);
+}
+
+
+void dxProfile::reset()
+{
+  memset (frame_time,0,sizeof(frame_time));
+  memset (frame_calls,0,sizeof(frame_calls));
+  memset (stats,0,sizeof(stats));
+  memset (pair_time,0,sizeof(pair_time));
+  memset (pair_calls,0,sizeof(pair_calls));
+  memset (pair_contacts,0,sizeof(pair_contacts));
+  trace_count = 0;
+  trace_origin = dxProfileNow();
+}
+
+
+void dxProfile::setTrace (int max_events)
+{
+  if (trace) dFree (trace,trace_capacity * sizeof(dxProfileEvent));
+  trace = 0;
+  trace_capacity = 0;
+  if (max_events > 0) {
+    trace = (dxProfileEvent*) dAlloc (max_events * sizeof(dxProfileEvent));
+    trace_capacity = max_events;
+  }
+  trace_count = 0;
+  trace_origin = dxProfileNow();
+}
+
+
+void dxProfile::record (int zone, int pair, int contacts, int thread,
+			dxProfileTime start, dxProfileTime duration,
+			dxProfileTime exclusive)
+{
+  dxAtomicAdd (&frame_time[zone],exclusive);
+  dxAtomicIncrement (&frame_calls[zone]);
+  if (pair >= 0) {
+    dxAtomicAdd (&pair_time[pair],exclusive);
+    dxAtomicIncrement (&pair_calls[pair]);
+    dxAtomicAdd (&pair_contacts[pair],(unsigned long) contacts);
+  }
+  if (trace_capacity) {
+    unsigned long i = dxAtomicAdd (&trace_count,1);
+    if (i < trace_capacity) {
+      dxProfileEvent *e = trace + i;
+      e->zone = zone;
+      e->pair = pair;
+      e->thread = thread;
+      e->start = start;
+      e->duration = duration;
+    }
+  }
+}
+
+
+void dxProfile::endFrame()
+{
+  for (int i=0; i<dProfileNumZones; i++) {
+    dProfileZoneStats *s = stats + i;
+    if (frame_calls[i] == 0) {
+      s->last = 0;
+      continue;
+    }
+    double t = double(frame_time[i]) * 1e-9;
+    s->frames++;
+    s->calls += frame_calls[i];
+    s->total += t;
+    s->last = t;
+    if (t > s->max) s->max = t;
+
+    // bucket b >= 1 holds 2^(b-1) <= microseconds < 2^b
+    dxProfileTime us = frame_time[i] / 1000;
+    int b = 0;
+    while (us && b < dPROFILE_HISTOGRAM_BUCKETS-1) {
+      us >>= 1;
+      b++;
+    }
+    s->histogram[b]++;
+
+    frame_time[i] = 0;
+    frame_calls[i] = 0;
+  }
+}
+
+//****************************************************************************
+// API
+
+static const char *geomClassName (int c)
+{
+  switch (c) {
+  case dSphereClass: return "sphere";
+  case dBoxClass: return "box";
+  case dCapsuleClass: return "capsule";
+  case dCylinderClass: return "cylinder";
+  case dPlaneClass: return "plane";
+  case dRayClass: return "ray";
+  case dConvexClass: return "convex";
+  case dGeomTransformClass: return "transform";
+  case dTriMeshClass: return "trimesh";
+  case dHeightfieldClass: return "heightfield";
+  case dSimpleSpaceClass: return "simple space";
+  case dHashSpaceClass: return "hash space";
+  case dSweepAndPruneSpaceClass: return "sap space";
+  case dQuadTreeSpaceClass: return "quadtree space";
+  case dBVHSpaceClass: return "bvh space";
+  }
+  return "user";
+}
+
+
+const char *dProfileZoneName (int zone)
+{
+  static const char *names[dProfileNumZones] = {
+    "broadphase","narrowphase","islands","jacobian","solver","integrate"
+  };
+  dAASSERT (zone >= 0 && zone < dProfileNumZones);
+  return names[zone];
+}
+
+
+void dWorldSetProfiling (dWorldID w, int enable)
+{
+  dAASSERT (w);
+  if (enable && !w->profile) {
+    w->profile = new dxProfile;
+  }
+  else if (!enable && w->profile) {
+    delete w->profile;
+    w->profile = 0;
+  }
+}
+
+
+int dWorldGetProfiling (dWorldID w)
+{
+  dAASSERT (w);
+  return w->profile != 0;
+}
+
+
+void dWorldResetProfile (dWorldID w)
+{
+  dAASSERT (w);
+  if (w->profile) w->profile->reset();
+}
+
+
+void dWorldGetProfileZoneStats (dWorldID w, int zone, dProfileZoneStats *stats)
+{
+  dAASSERT (w && stats);
+  dUASSERT (zone >= 0 && zone < dProfileNumZones,"bad zone");
+  if (w->profile) *stats = w->profile->stats[zone];
+  else memset (stats,0,sizeof(dProfileZoneStats));
+}
+
+
+void dWorldGetProfilePairStats (dWorldID w, int class1, int class2,
+				dProfilePairStats *stats)
+{
+  dAASSERT (w && stats);
+  dUASSERT (class1 >= 0 && class1 < dGeomNumClasses &&
+	    class2 >= 0 && class2 < dGeomNumClasses,"bad class number");
+  dxProfile *p = w->profile;
+  if (!p) {
+    memset (stats,0,sizeof(dProfilePairStats));
+    return;
+  }
+  int pair = class1*dGeomNumClasses + class2;
+  stats->calls = p->pair_calls[pair];
+  stats->contacts = p->pair_contacts[pair];
+  stats->total = double(p->pair_time[pair]) * 1e-9;
+}
+
+
+void dSpaceSetProfilingWorld (dSpaceID space, dWorldID w)
+{
+  dAASSERT (space);
+  dUASSERT (dGeomIsSpace (space),"argument not a space");
+  space->profile_world = w;
+}
+
+
+dWorldID dSpaceGetProfilingWorld (dSpaceID space)
+{
+  dAASSERT (space);
+  dUASSERT (dGeomIsSpace (space),"argument not a space");
+  return space->profile_world;
+}
+
+
+void dWorldSetProfileTrace (dWorldID w, int max_events)
+{
+  dAASSERT (w);
+  if (w->profile) w->profile->setTrace (max_events);
+}
+
+
+int dWorldWriteProfileTrace (dWorldID w, FILE *f)
+{
+  dAASSERT (w && f);
+  dxProfile *p = w->profile;
+  unsigned long count = 0;
+  if (p) count = (p->trace_count < p->trace_capacity) ?
+	   p->trace_count : p->trace_capacity;
+
+  // times are in microseconds since the trace was started
+  fprintf (f,"{\"traceEvents\":[");
+  for (unsigned long i=0; i<count; i++) {
+    dxProfileEvent *e = p->trace + i;
+    // a zone that was entered before the trace started
+    dxProfileTime start = (e->start > p->trace_origin) ?
+      e->start - p->trace_origin : 0;
+    fprintf (f,"%s\n{\"name\":\"%s\",\"cat\":\"ode\",\"ph\":\"X\","
+	     "\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f",
+	     i ? "," : "",dProfileZoneName (e->zone),e->thread,
+	     double(start) * 1e-3,
+	     double(e->duration) * 1e-3);
+    if (e->pair >= 0) {
+      fprintf (f,",\"args\":{\"class1\":\"%s\",\"class2\":\"%s\"}",
+	       geomClassName (e->pair / dGeomNumClasses),
+	       geomClassName (e->pair % dGeomNumClasses));
+    }
+    fprintf (f,"}");
+  }
+  fprintf (f,"\n],\"displayTimeUnit\":\"ms\"}\n");
+  return (int) count;
+}
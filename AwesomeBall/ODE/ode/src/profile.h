@@ -0,0 +1,146 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+/*
+
+per-world profiling, see include/ode/profile.h.
+
+code that belongs to a zone puts a dxProfileScope on the stack for it. the
+scopes of a thread form a stack, so that the time of a scope can be taken
+out of the scope it runs in (times are exclusive). a stepper goes through
+several zones one after another with dxProfileScope::next().
+
+collision functions do not know the world, so dSpaceCollide() and
+dSpaceCollide2() make the profile of the space's world the current
+collision profile of the thread (dxProfileCollision), and dCollide() reports
+to that.
+
+*/
+
+#ifndef _ODE_PROFILE_INTERNAL_H_
+#define _ODE_PROFILE_INTERNAL_H_
+
+#include <ode/common.h>
+#include <ode/profile.h>
+#include <ode/collision.h>
+#include "objects.h"
+
+
+typedef unsigned long long dxProfileTime;	// nanoseconds
+
+// a monotonic clock
+dxProfileTime dxProfileNow();
+
+
+// an entered zone, as recorded for the trace
+
+struct dxProfileEvent {
+  int zone;
+  int pair;			// class1*dGeomNumClasses+class2, or -1
+  int thread;			// small number that identifies the thread
+  dxProfileTime start, duration;
+};
+
+
+struct dxProfile : public dBase {
+  // the current frame. these are updated by all threads.
+  dxProfileTime frame_time[dProfileNumZones];
+  unsigned long frame_calls[dProfileNumZones];
+
+  dProfileZoneStats stats[dProfileNumZones];
+
+  // narrowphase, by pair of geom classes
+  dxProfileTime pair_time[dGeomNumClasses*dGeomNumClasses];
+  unsigned long pair_calls[dGeomNumClasses*dGeomNumClasses];
+  unsigned long pair_contacts[dGeomNumClasses*dGeomNumClasses];
+
+  // the trace. events are only added while trace_count < trace_capacity.
+  dxProfileEvent *trace;
+  unsigned long trace_capacity;
+  unsigned long trace_count;
+  dxProfileTime trace_origin;	// time the trace was started
+
+  dxProfile();
+  ~dxProfile();
+
+  void reset();
+  void setTrace (int max_events);
+
+  // add the time of a scope
+  void record (int zone, int pair, int contacts, int thread,
+	       dxProfileTime start, dxProfileTime duration,
+	       dxProfileTime exclusive);
+
+  // move the current frame into the statistics. this is called by the
+  // world step functions, on the calling thread, when no zone is running.
+  void endFrame();
+};
+
+
+class dxProfileScope {
+public:
+  // `profile' can be 0, in which case the scope does nothing.
+  dxProfileScope (dxProfile *profile, int zone, int pair = -1)
+    : profile (profile), contacts (0)
+    { if (profile) begin (zone,pair); }
+  ~dxProfileScope() { if (profile) end(); }
+
+  // leave the current zone and enter another one
+  void next (int z) { if (profile && z != zone) { end(); begin (z,-1); } }
+
+  void setContacts (int count) { contacts = count; }
+  int isActive() const { return profile != 0; }
+
+private:
+  void begin (int zone, int pair);
+  void end();
+
+  dxProfile *profile;
+  int zone, pair, contacts;
+  dxProfileTime start;
+  dxProfileTime children;	// time of the scopes that ran inside this one
+  dxProfileScope *parent;
+};
+
+
+// makes the profile of a space's world the current collision profile of
+// the thread while a space collides, and puts the time in the broadphase.
+
+class dxProfileCollision {
+public:
+  dxProfileCollision (dxProfile *profile);
+  ~dxProfileCollision();
+
+private:
+  dxProfile *saved;
+  dxProfileScope scope;
+};
+
+// nonzero while some thread is in a dxProfileCollision. dCollide() only
+// looks for the current collision profile then.
+extern unsigned long dxProfileCollisionActive;
+
+// the current collision profile of the thread, or 0
+dxProfile *dxProfileGetCollision();
+
+
+#endif
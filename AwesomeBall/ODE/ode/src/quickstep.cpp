@@ -32,8 +32,12 @@
 #include <ode/misc.h>
 #include "lcp.h"
 #include "util.h"
+#include "arena.h"
+#include "profile.h"
 
-#define ALLOCA dALLOCA16
+// all temporaries come from the stepper arena, which must be in scope as
+// `arena'. they are released by dxProcessIslands() after the step.
+#define ALLOCA(n) (arena->alloc (n))
 
 typedef const dReal *dRealPtr;
 typedef dReal *dRealMutablePtr;
@@ -42,10 +46,9 @@ typedef dReal *dRealMutablePtr;
 //***************************************************************************
 // configuration
 
-// for the SOR and CG methods:
-// uncomment the following line to use warm starting. this definitely
-// help for motor-driven joints. unfortunately it appears to hurt
-// with high-friction contacts using the SOR method. use with care
+// for the CG method:
+// uncomment the following line to use warm starting. the SOR method warm
+// starts at run time instead, see dWorldSetQuickStepWarmStarting().
 
 //#define WARM_STARTING 1
 
@@ -66,6 +69,118 @@ typedef dReal *dRealMutablePtr;
 
 #define RANDOMLY_REORDER_CONSTRAINTS 1
 
+// for the SOR method:
+// in single precision, the inner loop uses AVX, SSE or NEON if the compiler
+// targets one of them (chosen at build time). the jacobian rows and body
+// forces are then packed into padded blocks of 8 floats, one block per body.
+// the sums are done in a different order than the plain C loop, so results
+// differ from it in the last bits, but for a given instruction set they are
+// always the same. define dSOR_NO_SIMD to always use the plain C loop.
+
+#if defined(dSINGLE) && !defined(dSOR_NO_SIMD)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SOR_SIMD_AVX 1
+#elif defined(__SSE__) || defined(_M_IX86_FP) || defined(_M_X64)
+#include <xmmintrin.h>
+#define SOR_SIMD_SSE 1
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SOR_SIMD_NEON 1
+#endif
+#endif
+
+#if defined(SOR_SIMD_AVX) || defined(SOR_SIMD_SSE) || defined(SOR_SIMD_NEON)
+#define SOR_SIMD 1
+#endif
+
+#ifdef SOR_SIMD
+//****************************************************************************
+// SIMD kernels for the SOR inner loop. a block is 8 floats holding a 6-vector
+// as (x y z 0 x y z 0), 16 byte aligned.
+
+#define SOR_BLOCK 8
+
+// return a1.b1 + a2.b2 for two blocks each, or just a1.b1 if a2 is 0
+
+static inline float sorDot2 (const float *a1, const float *b1,
+			     const float *a2, const float *b2)
+{
+#if defined(SOR_SIMD_AVX)
+	__m256 p = _mm256_mul_ps (_mm256_loadu_ps (a1),_mm256_loadu_ps (b1));
+	if (a2) p = _mm256_add_ps (p,_mm256_mul_ps (_mm256_loadu_ps (a2),
+						    _mm256_loadu_ps (b2)));
+	__m128 q = _mm_add_ps (_mm256_castps256_ps128 (p),
+			       _mm256_extractf128_ps (p,1));
+	q = _mm_add_ps (q,_mm_movehl_ps (q,q));
+	q = _mm_add_ss (q,_mm_shuffle_ps (q,q,1));
+	return _mm_cvtss_f32 (q);
+#elif defined(SOR_SIMD_SSE)
+	__m128 q = _mm_add_ps (_mm_mul_ps (_mm_load_ps (a1),_mm_load_ps (b1)),
+			       _mm_mul_ps (_mm_load_ps (a1+4),_mm_load_ps (b1+4)));
+	if (a2) {
+		q = _mm_add_ps (q,_mm_mul_ps (_mm_load_ps (a2),_mm_load_ps (b2)));
+		q = _mm_add_ps (q,_mm_mul_ps (_mm_load_ps (a2+4),_mm_load_ps (b2+4)));
+	}
+	q = _mm_add_ps (q,_mm_movehl_ps (q,q));
+	q = _mm_add_ss (q,_mm_shuffle_ps (q,q,1));
+	float result;
+	_mm_store_ss (&result,q);
+	return result;
+#elif defined(SOR_SIMD_NEON)
+	float32x4_t q = vmulq_f32 (vld1q_f32 (a1),vld1q_f32 (b1));
+	q = vaddq_f32 (q,vmulq_f32 (vld1q_f32 (a1+4),vld1q_f32 (b1+4)));
+	if (a2) {
+		q = vaddq_f32 (q,vmulq_f32 (vld1q_f32 (a2),vld1q_f32 (b2)));
+		q = vaddq_f32 (q,vmulq_f32 (vld1q_f32 (a2+4),vld1q_f32 (b2+4)));
+	}
+	float32x2_t h = vadd_f32 (vget_low_f32 (q),vget_high_f32 (q));
+	return vget_lane_f32 (vpadd_f32 (h,h),0);
+#endif
+}
+
+
+// y += s*x for one block
+
+static inline void sorAxpy (float *y, float s, const float *x)
+{
+#if defined(SOR_SIMD_AVX)
+	_mm256_storeu_ps (y,_mm256_add_ps (_mm256_loadu_ps (y),
+		_mm256_mul_ps (_mm256_set1_ps (s),_mm256_loadu_ps (x))));
+#elif defined(SOR_SIMD_SSE)
+	__m128 sv = _mm_set1_ps (s);
+	_mm_store_ps (y,_mm_add_ps (_mm_load_ps (y),_mm_mul_ps (sv,_mm_load_ps (x))));
+	_mm_store_ps (y+4,_mm_add_ps (_mm_load_ps (y+4),
+				      _mm_mul_ps (sv,_mm_load_ps (x+4))));
+#elif defined(SOR_SIMD_NEON)
+	float32x4_t sv = vdupq_n_f32 (s);
+	vst1q_f32 (y,vaddq_f32 (vld1q_f32 (y),vmulq_f32 (sv,vld1q_f32 (x))));
+	vst1q_f32 (y+4,vaddq_f32 (vld1q_f32 (y+4),vmulq_f32 (sv,vld1q_f32 (x+4))));
+#endif
+}
+
+
+// copy n 6-vectors into blocks, or back
+
+static void sorPack (int n, dRealPtr in, float *out)
+{
+	for (int i=0; i<n; i++, in += 6, out += SOR_BLOCK) {
+		out[0] = in[0]; out[1] = in[1]; out[2] = in[2]; out[3] = 0;
+		out[4] = in[3]; out[5] = in[4]; out[6] = in[5]; out[7] = 0;
+	}
+}
+
+
+static void sorUnpack (int n, const float *in, dRealMutablePtr out)
+{
+	for (int i=0; i<n; i++, in += SOR_BLOCK, out += 6) {
+		out[0] = in[0]; out[1] = in[1]; out[2] = in[2];
+		out[3] = in[4]; out[4] = in[5]; out[5] = in[6];
+	}
+}
+
+#endif
+
 //****************************************************************************
 // special matrix multipliers
 
@@ -142,7 +257,7 @@ static void compute_invM_JT (int m, dRealMutablePtr J, dRealMutablePtr iMJ, int
 
 
 // compute out = inv(M)*J'*in.
-#if 0
+
 static void multiply_invM_JT (int m, int nb, dRealMutablePtr iMJ, int *jb,
 	dRealMutablePtr in, dRealMutablePtr out)
 {
@@ -162,7 +277,6 @@ static void multiply_invM_JT (int m, int nb, dRealMutablePtr iMJ, int *jb,
 		iMJ_ptr += 6;
 	}
 }
-#endif
 
 // compute out = J*in.
 
@@ -229,7 +343,7 @@ static inline void add (int n, dRealMutablePtr x, dRealPtr y, dRealPtr z, dReal
 static void CG_LCP (int m, int nb, dRealMutablePtr J, int *jb, dxBody * const *body,
 	dRealPtr invI, dRealMutablePtr lambda, dRealMutablePtr fc, dRealMutablePtr b,
 	dRealMutablePtr lo, dRealMutablePtr hi, dRealPtr cfm, int *findex,
-	dxQuickStepParameters *qs)
+	dxQuickStepParameters *qs, dxArena *arena)
 {
 	int i,j;
 	const int num_iterations = qs->num_iterations;
@@ -350,20 +464,22 @@ static int compare_index_error (const void *a, const void *b)
 static void SOR_LCP (int m, int nb, dRealMutablePtr J, int *jb, dxBody * const *body,
 	dRealPtr invI, dRealMutablePtr lambda, dRealMutablePtr fc, dRealMutablePtr b,
 	dRealMutablePtr lo, dRealMutablePtr hi, dRealPtr cfm, int *findex,
-	dxQuickStepParameters *qs)
+	dxQuickStepParameters *qs, dxArena *arena)
 {
 	const int num_iterations = qs->num_iterations;
 	const dReal sor_w = qs->w;		// SOR over-relaxation parameter
 
 	int i,j;
 
-#ifdef WARM_STARTING
-	// for warm starting, this seems to be necessary to prevent
-	// jerkiness in motor-driven joints. i have no idea why this works.
-	for (i=0; i<m; i++) lambda[i] *= 0.9;
-#else
-	dSetZero (lambda,m);
-#endif
+	// for warm starting, scaling down the old lambda seems to be necessary
+	// to prevent jerkiness in motor-driven joints (0.9 was found to work).
+	const dReal warm_start = qs->warm_start;
+	if (warm_start > 0) {
+		for (i=0; i<m; i++) lambda[i] *= warm_start;
+	}
+	else {
+		dSetZero (lambda,m);
+	}
 
 #ifdef REORDER_CONSTRAINTS
 	// the lambda computed at the previous iteration.
@@ -381,11 +497,12 @@ static void SOR_LCP (int m, int nb, dRealMutablePtr J, int *jb, dxBody * const *
 
 	// compute fc=(inv(M)*J')*lambda. we will incrementally maintain fc
 	// as we change lambda.
-#ifdef WARM_STARTING
-	multiply_invM_JT (m,nb,iMJ,jb,lambda,fc);
-#else
-	dSetZero (fc,nb*6);
-#endif
+	if (warm_start > 0) {
+		multiply_invM_JT (m,nb,iMJ,jb,lambda,fc);
+	}
+	else {
+		dSetZero (fc,nb*6);
+	}
 
 	// precompute 1 / diagonals of A
 	dRealAllocaArray (Ad,m);
@@ -415,6 +532,17 @@ static void SOR_LCP (int m, int nb, dRealMutablePtr J, int *jb, dxBody * const *
 		Ad[i] *= cfm[i];
 	}
 
+#ifdef SOR_SIMD
+	// pack J, iMJ and fc into blocks, two per row (one for each body) and
+	// one per body. fc is unpacked again at the end.
+	float *Jp = (float*) ALLOCA (m*2*SOR_BLOCK*sizeof(float));
+	float *iMJp = (float*) ALLOCA (m*2*SOR_BLOCK*sizeof(float));
+	float *fcp = (float*) ALLOCA (nb*SOR_BLOCK*sizeof(float));
+	sorPack (m*2,J,Jp);
+	sorPack (m*2,iMJ,iMJp);
+	sorPack (nb,fc,fcp);
+#endif
+
 	// order to solve constraint rows in
 	IndexError *order = (IndexError*) ALLOCA (m*sizeof(IndexError));
 
@@ -475,7 +603,7 @@ static void SOR_LCP (int m, int nb, dRealMutablePtr J, int *jb, dxBody * const *
 		if ((iteration & 7) == 0) {
 			for (i=1; i<m; ++i) {
 				IndexError tmp = order[i];
-				int swapi = dRandInt(i+1);
+				int swapi = dxStepperRandInt(i+1);
 				order[i] = order[swapi];
 				order[swapi] = tmp;
 			}
@@ -489,8 +617,10 @@ static void SOR_LCP (int m, int nb, dRealMutablePtr J, int *jb, dxBody * const *
 			//     access pattern.
 
 			int index = order[i].index;
+#ifndef SOR_SIMD
 			J_ptr = J + index*12;
 			iMJ_ptr = iMJ + index*12;
+#endif
 
 			// set the limits for this constraint. note that 'hicopy' is used.
 			// this is the place where the QuickStep method differs from the
@@ -507,9 +637,15 @@ static void SOR_LCP (int m, int nb, dRealMutablePtr J, int *jb, dxBody * const *
 			int b1 = jb[index*2];
 			int b2 = jb[index*2+1];
 			dReal delta = b[index] - lambda[index]*Ad[index];
+#ifdef SOR_SIMD
+			const float *Jp_ptr = Jp + index*2*SOR_BLOCK;
+			const float *iMJp_ptr = iMJp + index*2*SOR_BLOCK;
+			float *fc1 = fcp + b1*SOR_BLOCK;
+			float *fc2 = (b2 >= 0) ? fcp + b2*SOR_BLOCK : 0;
+			delta -= sorDot2 (fc1,Jp_ptr,fc2,Jp_ptr+SOR_BLOCK);
+#else
 			dRealMutablePtr fc_ptr = fc + 6*b1;
 
-			// @@@ potential optimization: SIMD-ize this and the b2 >= 0 case
 			delta -=fc_ptr[0] * J_ptr[0] + fc_ptr[1] * J_ptr[1] +
 				fc_ptr[2] * J_ptr[2] + fc_ptr[3] * J_ptr[3] +
 				fc_ptr[4] * J_ptr[4] + fc_ptr[5] * J_ptr[5];
@@ -521,6 +657,7 @@ static void SOR_LCP (int m, int nb, dRealMutablePtr J, int *jb, dxBody * const *
 					fc_ptr[2] * J_ptr[8] + fc_ptr[3] * J_ptr[9] +
 					fc_ptr[4] * J_ptr[10] + fc_ptr[5] * J_ptr[11];
 			}
+#endif
 
 			// compute lambda and clamp it to [lo,hi].
 			// @@@ potential optimization: does SSE have clamping instructions
@@ -543,7 +680,10 @@ static void SOR_LCP (int m, int nb, dRealMutablePtr J, int *jb, dxBody * const *
 			//delta *= ramp;
 
 			// update fc.
-			// @@@ potential optimization: SIMD for this and the b2 >= 0 case
+#ifdef SOR_SIMD
+			sorAxpy (fc1,delta,iMJp_ptr);
+			if (fc2) sorAxpy (fc2,delta,iMJp_ptr+SOR_BLOCK);
+#else
 			fc_ptr = fc + 6*b1;
 			fc_ptr[0] += delta * iMJ_ptr[0];
 			fc_ptr[1] += delta * iMJ_ptr[1];
@@ -562,15 +702,22 @@ static void SOR_LCP (int m, int nb, dRealMutablePtr J, int *jb, dxBody * const *
 				fc_ptr[4] += delta * iMJ_ptr[10];
 				fc_ptr[5] += delta * iMJ_ptr[11];
 			}
+#endif
 		}
 	}
+
+#ifdef SOR_SIMD
+	sorUnpack (nb,fcp,fc);
+#endif
 }
 
 
 void dxQuickStepper (dxWorld *world, dxBody * const *body, int nb,
-		     dxJoint * const *_joint, int nj, dReal stepsize)
+		     dxJoint * const *_joint, int nj, dReal stepsize,
+		     dxArena *arena)
 {
 	int i,j;
+	dxProfileScope profile (world->profile,dProfileJacobian);
 	IFTIMING(dTimerStart("preprocessing");)
 
 	dReal stepsize1 = dRecip(stepsize);
@@ -748,26 +895,28 @@ void dxQuickStepper (dxWorld *world, dxBody * const *body, int nb,
 
 		// load lambda from the value saved on the previous iteration
 		dRealAllocaArray (lambda,m);
-#ifdef WARM_STARTING
-		dSetZero (lambda,m);	//@@@ shouldn't be necessary
-		for (i=0; i<nj; i++) {
-			memcpy (lambda+ofs[i],joint[i]->lambda,info[i].m * sizeof(dReal));
+		if (world->qs.warm_start > 0) {
+			for (i=0; i<nj; i++) {
+				memcpy (lambda+ofs[i],joint[i]->lambda,info[i].m * sizeof(dReal));
+			}
 		}
-#endif
 
 		// solve the LCP problem and get lambda and invM*constraint_force
 		IFTIMING (dTimerNow ("solving LCP problem");)
+		profile.next (dProfileSolver);
 		dRealAllocaArray (cforce,nb*6);
-		SOR_LCP (m,nb,J,jb,body,invI,lambda,cforce,rhs,lo,hi,cfm,findex,&world->qs);
-
-#ifdef WARM_STARTING
-		// save lambda for the next iteration
-		//@@@ note that this doesn't work for contact joints yet, as they are
-		// recreated every iteration
-		for (i=0; i<nj; i++) {
-			memcpy (joint[i]->lambda,lambda+ofs[i],info[i].m * sizeof(dReal));
+		SOR_LCP (m,nb,J,jb,body,invI,lambda,cforce,rhs,lo,hi,cfm,findex,&world->qs,
+			 arena);
+		profile.next (dProfileIntegrate);
+
+		// save lambda for the next step. contact joints are recreated every
+		// step, so dWorldQuickStep() keeps their lambda in the world's
+		// contact cache.
+		if (world->qs.warm_start > 0) {
+			for (i=0; i<nj; i++) {
+				memcpy (joint[i]->lambda,lambda+ofs[i],info[i].m * sizeof(dReal));
+			}
 		}
-#endif
 
 		// note that the SOR method overwrites rhs and J at this point, so
 		// they should not be used again.
@@ -815,6 +964,7 @@ void dxQuickStepper (dxWorld *world, dxBody * const *body, int nb,
 	// add stepsize * invM * fe to the body velocity
 
 	IFTIMING (dTimerNow ("compute velocity update");)
+	profile.next (dProfileIntegrate);
 	for (i=0; i<nb; i++) {
 		dReal body_invMass = body[i]->invMass;
 		for (j=0; j<3; j++) body[i]->lvel[j] += stepsize * body_invMass * body[i]->facc[j];
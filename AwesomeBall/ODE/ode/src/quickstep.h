@@ -25,9 +25,12 @@
 
 #include <ode/common.h>
 
+struct dxArena;
+
 
 void dxQuickStepper (dxWorld *world, dxBody * const *body, int nb,
-		     dxJoint * const *_joint, int nj, dReal stepsize);
+		     dxJoint * const *_joint, int nj, dReal stepsize,
+		     dxArena *arena);
 
 
 #endif
@@ -248,3 +248,212 @@ int dCollideSpherePlane (dxGeom *o1, dxGeom *o2, int flags,
   }
   else return 0;
 }
+
+
+
+//****************************************************************************
+// batched sphere colliders
+
+// these collide n pairs of geoms at a time, given as two arrays with the
+// sphere first. they write at most one contact per pair, one after the other
+// into `contact', and set count[i] to the number of contacts of pair i. the
+// geoms' final_posr must be up to date, and pairs that dCollide() would skip
+// (geoms on the same body) must not be passed.
+//
+// in single precision they test four pairs at a time with SSE or NEON if the
+// compiler targets one of them. define dCOLLIDE_NO_SIMD to always use the
+// plain C loop. the sphere-sphere test only decides which pairs go to
+// dCollideSpheres(), so those contacts are the same as the pairwise ones.
+// the sphere-plane depth is computed in the same order as in
+// dCollideSpherePlane(), but where the compiler fuses multiply-adds in the
+// scalar code (as it may on ARM) and not in the vector lanes, the depths
+// can differ from the pairwise ones in the last bits.
+
+#if defined(dSINGLE) && !defined(dCOLLIDE_NO_SIMD)
+#if defined(__SSE__) || defined(_M_IX86_FP) || defined(_M_X64)
+#include <xmmintrin.h>
+#define BATCH_SIMD_SSE 1
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define BATCH_SIMD_NEON 1
+#endif
+#endif
+
+#define LANES 4
+
+// the sphere-sphere test is a little generous, so rounding in a different
+// order never drops a contact that dCollideSpheres() would find
+#define SLACK REAL(1e-5)
+
+
+// LANES pairs, one array per coordinate
+
+struct dxBatchLanes {
+  dReal a[8][LANES];
+};
+
+
+static inline void gatherSphere (dxBatchLanes &l, int first, int lane,
+				 dxGeom *g)
+{
+  dIASSERT (g->type == dSphereClass);
+  const dReal *pos = g->final_posr->pos;
+  l.a[first][lane] = pos[0];
+  l.a[first+1][lane] = pos[1];
+  l.a[first+2][lane] = pos[2];
+  l.a[first+3][lane] = ((dxSphere*)g)->radius;
+}
+
+
+// depth[i] for sphere-plane lanes. a = sphere x,y,z,radius and plane a,b,c,d.
+
+static void spherePlaneDepths (const dxBatchLanes &l, dReal *depth)
+{
+#if defined(BATCH_SIMD_SSE)
+  __m128 k = _mm_add_ps (_mm_add_ps (_mm_mul_ps (_mm_loadu_ps (l.a[0]),
+						 _mm_loadu_ps (l.a[4])),
+				     _mm_mul_ps (_mm_loadu_ps (l.a[1]),
+						 _mm_loadu_ps (l.a[5]))),
+			 _mm_mul_ps (_mm_loadu_ps (l.a[2]),_mm_loadu_ps (l.a[6])));
+  _mm_storeu_ps (depth,_mm_add_ps (_mm_sub_ps (_mm_loadu_ps (l.a[7]),k),
+				   _mm_loadu_ps (l.a[3])));
+#elif defined(BATCH_SIMD_NEON)
+  float32x4_t k = vaddq_f32 (vaddq_f32 (vmulq_f32 (vld1q_f32 (l.a[0]),
+						   vld1q_f32 (l.a[4])),
+				        vmulq_f32 (vld1q_f32 (l.a[1]),
+						   vld1q_f32 (l.a[5]))),
+			     vmulq_f32 (vld1q_f32 (l.a[2]),vld1q_f32 (l.a[6])));
+  vst1q_f32 (depth,vaddq_f32 (vsubq_f32 (vld1q_f32 (l.a[7]),k),
+			      vld1q_f32 (l.a[3])));
+#else
+  for (int i=0; i<LANES; i++) {
+    dReal k = l.a[0][i]*l.a[4][i] + l.a[1][i]*l.a[5][i] + l.a[2][i]*l.a[6][i];
+    depth[i] = l.a[7][i] - k + l.a[3][i];
+  }
+#endif
+}
+
+
+// hit[i] for sphere-sphere lanes. a = sphere 1 x,y,z,radius and sphere 2
+// x,y,z,radius.  |p1-p2|^2 <= (r1+r2)^2 * (1+SLACK)
+
+static void sphereSphereHits (const dxBatchLanes &l, int *hit)
+{
+#if defined(BATCH_SIMD_SSE)
+  __m128 dx = _mm_sub_ps (_mm_loadu_ps (l.a[0]),_mm_loadu_ps (l.a[4]));
+  __m128 dy = _mm_sub_ps (_mm_loadu_ps (l.a[1]),_mm_loadu_ps (l.a[5]));
+  __m128 dz = _mm_sub_ps (_mm_loadu_ps (l.a[2]),_mm_loadu_ps (l.a[6]));
+  __m128 rr = _mm_add_ps (_mm_loadu_ps (l.a[3]),_mm_loadu_ps (l.a[7]));
+  __m128 d2 = _mm_add_ps (_mm_add_ps (_mm_mul_ps (dx,dx),_mm_mul_ps (dy,dy)),
+			  _mm_mul_ps (dz,dz));
+  __m128 r2 = _mm_mul_ps (_mm_mul_ps (rr,rr),_mm_set1_ps (1 + SLACK));
+  int mask = _mm_movemask_ps (_mm_cmple_ps (d2,r2));
+  for (int i=0; i<LANES; i++) hit[i] = (mask >> i) & 1;
+#elif defined(BATCH_SIMD_NEON)
+  float32x4_t dx = vsubq_f32 (vld1q_f32 (l.a[0]),vld1q_f32 (l.a[4]));
+  float32x4_t dy = vsubq_f32 (vld1q_f32 (l.a[1]),vld1q_f32 (l.a[5]));
+  float32x4_t dz = vsubq_f32 (vld1q_f32 (l.a[2]),vld1q_f32 (l.a[6]));
+  float32x4_t rr = vaddq_f32 (vld1q_f32 (l.a[3]),vld1q_f32 (l.a[7]));
+  float32x4_t d2 = vaddq_f32 (vaddq_f32 (vmulq_f32 (dx,dx),vmulq_f32 (dy,dy)),
+			      vmulq_f32 (dz,dz));
+  float32x4_t r2 = vmulq_f32 (vmulq_f32 (rr,rr),vdupq_n_f32 (1 + SLACK));
+  uint32_t mask[LANES];
+  vst1q_u32 (mask,vcleq_f32 (d2,r2));
+  for (int i=0; i<LANES; i++) hit[i] = mask[i] != 0;
+#else
+  for (int i=0; i<LANES; i++) {
+    dReal dx = l.a[0][i] - l.a[4][i];
+    dReal dy = l.a[1][i] - l.a[5][i];
+    dReal dz = l.a[2][i] - l.a[6][i];
+    dReal rr = l.a[3][i] + l.a[7][i];
+    hit[i] = dx*dx + dy*dy + dz*dz <= rr*rr*(1 + SLACK);
+  }
+#endif
+}
+
+
+int dCollideSpherePlaneBatch (dxGeom * const *spheres,
+			      dxGeom * const *planes, int n,
+			      dContactGeom *contact, int *count)
+{
+  dxBatchLanes l;
+  dReal depth[LANES];
+  int num = 0;
+  for (int i=0; i<n; i+=LANES) {
+    // pad the last group with copies of its first pair
+    for (int j=0; j<LANES; j++) {
+      int p = (i+j < n) ? i+j : i;
+      gatherSphere (l,0,j,spheres[p]);
+      dIASSERT (planes[p]->type == dPlaneClass);
+      const dReal *plane = ((dxPlane*)planes[p])->p;
+      l.a[4][j] = plane[0];
+      l.a[5][j] = plane[1];
+      l.a[6][j] = plane[2];
+      l.a[7][j] = plane[3];
+    }
+    spherePlaneDepths (l,depth);
+
+    for (int j=0; j<LANES && i+j<n; j++) {
+      if (depth[j] >= 0) {
+	dxGeom *o1 = spheres[i+j];
+	dxGeom *o2 = planes[i+j];
+	const dReal *pos = o1->final_posr->pos;
+	const dReal *p = ((dxPlane*)o2)->p;
+	const dReal radius = ((dxSphere*)o1)->radius;
+	dContactGeom *c = contact + num;
+	c->g1 = o1;
+	c->g2 = o2;
+	c->side1 = -1;
+	c->side2 = -1;
+	c->normal[0] = p[0];
+	c->normal[1] = p[1];
+	c->normal[2] = p[2];
+	c->pos[0] = pos[0] - p[0] * radius;
+	c->pos[1] = pos[1] - p[1] * radius;
+	c->pos[2] = pos[2] - p[2] * radius;
+	c->depth = depth[j];
+	count[i+j] = 1;
+	num++;
+      }
+      else count[i+j] = 0;
+    }
+  }
+  return num;
+}
+
+
+int dCollideSphereSphereBatch (dxGeom * const *s1, dxGeom * const *s2, int n,
+			       dContactGeom *contact, int *count)
+{
+  dxBatchLanes l;
+  int hit[LANES];
+  int num = 0;
+  for (int i=0; i<n; i+=LANES) {
+    for (int j=0; j<LANES; j++) {
+      int p = (i+j < n) ? i+j : i;
+      gatherSphere (l,0,j,s1[p]);
+      gatherSphere (l,4,j,s2[p]);
+    }
+    sphereSphereHits (l,hit);
+
+    for (int j=0; j<LANES && i+j<n; j++) {
+      count[i+j] = 0;
+      if (!hit[j]) continue;
+      dxGeom *o1 = s1[i+j];
+      dxGeom *o2 = s2[i+j];
+      dContactGeom *c = contact + num;
+      c->g1 = o1;
+      c->g2 = o2;
+      c->side1 = -1;
+      c->side2 = -1;
+      count[i+j] = dCollideSpheres (o1->final_posr->pos,((dxSphere*)o1)->radius,
+				    o2->final_posr->pos,((dxSphere*)o2)->radius,
+				    c);
+      num += count[i+j];
+    }
+  }
+  return num;
+}
+
+#undef LANES
+#undef SLACK
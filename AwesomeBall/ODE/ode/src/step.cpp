@@ -31,6 +31,8 @@
 #include <ode/matrix.h>
 #include "lcp.h"
 #include "util.h"
+#include "arena.h"
+#include "profile.h"
 
 //****************************************************************************
 // misc defines
@@ -53,10 +55,10 @@ unsigned int dMemoryFlag;
   Auto<t> v(malloc(s));                         \
   CHECK(v)
 
-#else // use alloca()
+#else // use the stepper arena
 
 #define ALLOCA(t,v,s)                           \
-  Auto<t> v( dALLOCA16(s) );
+  Auto<t> v( arena->alloc (s) );
 
 #endif
 
@@ -274,7 +276,8 @@ static void Multiply1_8q1 (dReal *A, dReal *B, dReal *C, int q)
 // `_joint' is the body array, `nj' is the size of the array.
 
 void dInternalStepIsland_x1 (dxWorld *world, dxBody * const *body, int nb,
-			     dxJoint * const *_joint, int nj, dReal stepsize)
+			     dxJoint * const *_joint, int nj, dReal stepsize,
+			     dxArena *arena)
 {
   int i,j,k;
   int n6 = 6*nb;
@@ -499,7 +502,7 @@ void dInternalStepIsland_x1 (dxWorld *world, dxBody * const *body, int nb,
 #   endif
     ALLOCA(dReal,lambda,m*sizeof(dReal));
     ALLOCA(dReal,residual,m*sizeof(dReal));
-    dSolveLCP (m,A,lambda,rhs,residual,nub,lo,hi,findex);
+    dSolveLCP (m,A,lambda,rhs,residual,nub,lo,hi,findex,arena);
 
 #ifdef dUSE_MALLOC_FOR_ALLOCA
     if (dMemoryFlag == d_MEMORY_OUT_OF_MEMORY)
@@ -609,9 +612,11 @@ void dInternalStepIsland_x1 (dxWorld *world, dxBody * const *body, int nb,
 // an optimized version of dInternalStepIsland1()
 
 void dInternalStepIsland_x2 (dxWorld *world, dxBody * const *body, int nb,
-			     dxJoint * const *_joint, int nj, dReal stepsize)
+			     dxJoint * const *_joint, int nj, dReal stepsize,
+			     dxArena *arena)
 {
   int i,j,k;
+  dxProfileScope profile (world->profile,dProfileJacobian);
 #ifdef TIMING
   dTimerStart("preprocessing");
 #endif
@@ -921,9 +926,10 @@ void dInternalStepIsland_x2 (dxWorld *world, dxBody * const *body, int nb,
 #   ifdef TIMING
     dTimerNow ("solving LCP problem");
 #   endif
+    profile.next (dProfileSolver);
     ALLOCA(dReal,lambda,m*sizeof(dReal));
     ALLOCA(dReal,residual,m*sizeof(dReal));
-    dSolveLCP (m,A,lambda,rhs,residual,nub,lo,hi,findex);
+    dSolveLCP (m,A,lambda,rhs,residual,nub,lo,hi,findex,arena);
 
 #ifdef dUSE_MALLOC_FOR_ALLOCA
     if (dMemoryFlag == d_MEMORY_OUT_OF_MEMORY)
@@ -1009,6 +1015,7 @@ void dInternalStepIsland_x2 (dxWorld *world, dxBody * const *body, int nb,
 #ifdef TIMING
   dTimerNow ("compute velocity update");
 #endif
+  profile.next (dProfileIntegrate);
 
   // add fe to cforce
   for (i=0; i<nb; i++) {
@@ -1067,7 +1074,8 @@ void dInternalStepIsland_x2 (dxWorld *world, dxBody * const *body, int nb,
 //****************************************************************************
 
 void dInternalStepIsland (dxWorld *world, dxBody * const *body, int nb,
-			  dxJoint * const *joint, int nj, dReal stepsize)
+			  dxJoint * const *joint, int nj, dReal stepsize,
+			  dxArena *arena)
 {
 
 #ifdef dUSE_MALLOC_FOR_ALLOCA
@@ -1075,7 +1083,7 @@ void dInternalStepIsland (dxWorld *world, dxBody * const *body, int nb,
 #endif
 
 #ifndef COMPARE_METHODS
-  dInternalStepIsland_x2 (world,body,nb,joint,nj,stepsize);
+  dInternalStepIsland_x2 (world,body,nb,joint,nj,stepsize,arena);
 
 #ifdef dUSE_MALLOC_FOR_ALLOCA
     if (dMemoryFlag == d_MEMORY_OUT_OF_MEMORY) {
@@ -1096,7 +1104,7 @@ void dInternalStepIsland (dxWorld *world, dxBody * const *body, int nb,
 
   // take slow step
   comparator.reset();
-  dInternalStepIsland_x1 (world,body,nb,joint,nj,stepsize);
+  dInternalStepIsland_x1 (world,body,nb,joint,nj,stepsize,arena);
   comparator.end();
 #ifdef dUSE_MALLOC_FOR_ALLOCA
   if (dMemoryFlag == d_MEMORY_OUT_OF_MEMORY) {
@@ -1109,7 +1117,7 @@ void dInternalStepIsland (dxWorld *world, dxBody * const *body, int nb,
   for (i=0; i<nb; i++) memcpy (body[i],state+i,sizeof(dxBody));
 
   // take fast step
-  dInternalStepIsland_x2 (world,body,nb,joint,nj,stepsize);
+  dInternalStepIsland_x2 (world,body,nb,joint,nj,stepsize,arena);
   comparator.end();
 #ifdef dUSE_MALLOC_FOR_ALLOCA
     if (dMemoryFlag == d_MEMORY_OUT_OF_MEMORY) {
@@ -25,11 +25,13 @@
 
 #include <ode/common.h>
 
+struct dxArena;
+
 
 void dInternalStepIsland (dxWorld *world,
 			  dxBody * const *body, int nb,
 			  dxJoint * const *joint, int nj,
-			  dReal stepsize);
+			  dReal stepsize, dxArena *arena);
 
 
 
@@ -42,6 +42,7 @@
 #include "lcp.h"
 #include "step.h"
 #include "util.h"
+#include "profile.h"
 
 
 // misc defines
@@ -1140,4 +1141,5 @@ void dWorldStepFast1 (dWorldID w, dReal stepsize, int maxiterations)
 	dUASSERT (w, "bad world argument");
 	dUASSERT (stepsize > 0, "stepsize must be > 0");
 	processIslandsFast (w, stepsize, maxiterations);
+	if (w->profile) w->profile->endFrame();
 }
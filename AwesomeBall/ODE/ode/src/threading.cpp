@@ -0,0 +1,293 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+#include <ode/common.h>
+#include <ode/error.h>
+#include <ode/memory.h>
+#include "threading.h"
+
+#if dTHREADS_ENABLED
+#include <pthread.h>
+#endif
+
+//****************************************************************************
+// thread context
+
+#if dTHREADS_ENABLED
+
+static pthread_key_t context_key;
+static pthread_once_t context_key_once = PTHREAD_ONCE_INIT;
+
+static void createContextKey()
+{
+  pthread_key_create (&context_key,0);
+}
+
+
+void *dxThreadGetContext()
+{
+  pthread_once (&context_key_once,createContextKey);
+  return pthread_getspecific (context_key);
+}
+
+
+void dxThreadSetContext (void *context)
+{
+  pthread_once (&context_key_once,createContextKey);
+  pthread_setspecific (context_key,context);
+}
+
+#else
+
+static void *thread_context = 0;
+
+void *dxThreadGetContext()
+{
+  return thread_context;
+}
+
+
+void dxThreadSetContext (void *context)
+{
+  thread_context = context;
+}
+
+#endif
+
+
+void dxAtomicIncrement (unsigned long *counter)
+{
+#if dTHREADS_ENABLED
+  __sync_fetch_and_add (counter,1UL);
+#else
+  (*counter)++;
+#endif
+}
+
+
+unsigned long dxAtomicAdd (unsigned long *counter, unsigned long amount)
+{
+#if dTHREADS_ENABLED
+  return __sync_fetch_and_add (counter,amount);
+#else
+  unsigned long old = *counter;
+  *counter += amount;
+  return old;
+#endif
+}
+
+
+unsigned long long dxAtomicAdd (unsigned long long *counter,
+				unsigned long long amount)
+{
+#if dTHREADS_ENABLED
+  return __sync_fetch_and_add (counter,amount);
+#else
+  unsigned long long old = *counter;
+  *counter += amount;
+  return old;
+#endif
+}
+
+//****************************************************************************
+// thread pool
+
+#if dTHREADS_ENABLED
+
+// the pool threads sleep on `wake' until a new generation of work is
+// posted. every thread (including the caller) then takes indexes from
+// `next_index' until they run out, and the last thread to finish a call
+// signals `done'.
+
+struct dxThreadPoolImpl {
+  pthread_mutex_t mutex;
+  pthread_cond_t wake;
+  pthread_cond_t done;
+  pthread_t *threads;
+  int num_workers;		// number of threads in `threads'
+
+  unsigned generation;		// incremented for every run()
+  int quit;			// set when the pool is destroyed
+
+  dxThreadTask *task;
+  void *data;
+  int count;			// number of indexes in the current run
+  int next_index;		// next index to hand out
+  int remaining;		// number of indexes not yet finished
+};
+
+
+struct WorkerArgs {
+  dxThreadPoolImpl *impl;
+  int thread;
+};
+
+
+static void processIndexes (dxThreadPoolImpl *impl, int thread)
+{
+  pthread_mutex_lock (&impl->mutex);
+  while (impl->next_index < impl->count) {
+    int index = impl->next_index++;
+    pthread_mutex_unlock (&impl->mutex);
+
+    impl->task (impl->data,index,thread);
+
+    pthread_mutex_lock (&impl->mutex);
+    if (--impl->remaining == 0) pthread_cond_signal (&impl->done);
+  }
+  pthread_mutex_unlock (&impl->mutex);
+}
+
+
+static void *workerMain (void *arg)
+{
+  WorkerArgs args = *(WorkerArgs*) arg;
+  dFree (arg,sizeof(WorkerArgs));
+  dxThreadPoolImpl *impl = args.impl;
+
+  unsigned seen = 0;
+  for (;;) {
+    pthread_mutex_lock (&impl->mutex);
+    while (!impl->quit && impl->generation == seen)
+      pthread_cond_wait (&impl->wake,&impl->mutex);
+    if (impl->quit) {
+      pthread_mutex_unlock (&impl->mutex);
+      break;
+    }
+    seen = impl->generation;
+    pthread_mutex_unlock (&impl->mutex);
+
+    processIndexes (impl,args.thread);
+  }
+  return 0;
+}
+
+
+dxThreadPool::dxThreadPool (int threads)
+{
+  dAASSERT (threads >= 1);
+  impl = (dxThreadPoolImpl*) dAlloc (sizeof(dxThreadPoolImpl));
+  pthread_mutex_init (&impl->mutex,0);
+  pthread_cond_init (&impl->wake,0);
+  pthread_cond_init (&impl->done,0);
+  impl->generation = 0;
+  impl->quit = 0;
+  impl->task = 0;
+  impl->data = 0;
+  impl->count = 0;
+  impl->next_index = 0;
+  impl->remaining = 0;
+
+  impl->num_workers = 0;
+  impl->threads = (pthread_t*) dAlloc ((threads-1) * sizeof(pthread_t));
+
+  pthread_attr_t attr;
+  pthread_attr_init (&attr);
+  pthread_attr_setstacksize (&attr,dTHREAD_STACK_SIZE);
+  for (int i=1; i<threads; i++) {
+    WorkerArgs *args = (WorkerArgs*) dAlloc (sizeof(WorkerArgs));
+    args->impl = impl;
+    args->thread = i;
+    if (pthread_create (impl->threads + impl->num_workers,&attr,
+			workerMain,args) != 0) {
+      // carry on with the threads we have got
+      dFree (args,sizeof(WorkerArgs));
+      dMessage (0,"thread pool: could only create %d of %d threads",
+		impl->num_workers+1,threads);
+      break;
+    }
+    impl->num_workers++;
+  }
+  pthread_attr_destroy (&attr);
+
+  num_threads = impl->num_workers + 1;
+}
+
+
+dxThreadPool::~dxThreadPool()
+{
+  pthread_mutex_lock (&impl->mutex);
+  impl->quit = 1;
+  pthread_cond_broadcast (&impl->wake);
+  pthread_mutex_unlock (&impl->mutex);
+  for (int i=0; i<impl->num_workers; i++) pthread_join (impl->threads[i],0);
+
+  pthread_cond_destroy (&impl->done);
+  pthread_cond_destroy (&impl->wake);
+  pthread_mutex_destroy (&impl->mutex);
+  dFree (impl->threads,(num_threads-1) * sizeof(pthread_t));
+  dFree (impl,sizeof(dxThreadPoolImpl));
+}
+
+
+void dxThreadPool::run (int count, dxThreadTask *task, void *data)
+{
+  if (count <= 0) return;
+
+  // not worth waking anybody up for a single index
+  if (impl->num_workers == 0 || count == 1) {
+    for (int i=0; i<count; i++) task (data,i,0);
+    return;
+  }
+
+  pthread_mutex_lock (&impl->mutex);
+  impl->task = task;
+  impl->data = data;
+  impl->count = count;
+  impl->next_index = 0;
+  impl->remaining = count;
+  impl->generation++;
+  pthread_cond_broadcast (&impl->wake);
+  pthread_mutex_unlock (&impl->mutex);
+
+  processIndexes (impl,0);
+
+  pthread_mutex_lock (&impl->mutex);
+  while (impl->remaining > 0) pthread_cond_wait (&impl->done,&impl->mutex);
+  impl->task = 0;
+  impl->data = 0;
+  pthread_mutex_unlock (&impl->mutex);
+}
+
+#else
+
+// without thread support the pool degenerates to a loop on the calling
+// thread.
+
+dxThreadPool::dxThreadPool (int threads)
+{
+  impl = 0;
+  num_threads = 1;
+}
+
+
+dxThreadPool::~dxThreadPool()
+{
+}
+
+
+void dxThreadPool::run (int count, dxThreadTask *task, void *data)
+{
+  for (int i=0; i<count; i++) task (data,i,0);
+}
+
+#endif
@@ -0,0 +1,89 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+/*
+
+a minimal worker thread pool, used to spread independent pieces of work
+(e.g. the islands of a world step) over several threads.
+
+*/
+
+#ifndef _ODE_THREADING_H_
+#define _ODE_THREADING_H_
+
+#include <ode/common.h>
+#include "config.h"
+#include "objects.h"
+
+
+// stack size of every pool thread. the island steppers take their big
+// temporaries from the world's arenas, so this does not depend on the size
+// of the islands.
+#ifndef dTHREAD_STACK_SIZE
+#define dTHREAD_STACK_SIZE (1024*1024)
+#endif
+
+
+// a task is called once for each index in 0..count-1.
+typedef void dxThreadTask (void *data, int index, int thread);
+
+
+struct dxThreadPoolImpl;
+
+struct dxThreadPool : public dBase {
+  dxThreadPoolImpl *impl;
+  int num_threads;		// number of threads including the calling thread
+
+  dxThreadPool (int threads);
+  ~dxThreadPool();
+
+  int getThreadCount() const { return num_threads; }
+
+  void run (int count, dxThreadTask *task, void *data);
+  // call task(data,i,thread) for all i in 0..count-1. the calls are spread
+  // over the pool threads and the calling thread (which is thread 0), and
+  // the indexes are handed out in increasing order. this returns when all
+  // calls have finished. the pool is not reentrant: a task must not call
+  // run() on the same pool.
+};
+
+
+// every thread has one context pointer that the code running on that thread
+// can use to find per-thread state. it is 0 unless someone has set it.
+
+void *dxThreadGetContext();
+void dxThreadSetContext (void *context);
+
+
+// add 1 to a counter that may be updated by several threads at once.
+
+void dxAtomicIncrement (unsigned long *counter);
+
+// add `amount' to a counter that may be updated by several threads at once,
+// and return the value it had before.
+
+unsigned long dxAtomicAdd (unsigned long *counter, unsigned long amount);
+unsigned long long dxAtomicAdd (unsigned long long *counter,
+				unsigned long long amount);
+
+
+#endif
@@ -23,9 +23,14 @@
 #include "ode/ode.h"
 #include "objects.h"
 #include "joints/joint.h"
+#include "joints/contact.h"
 #include "util.h"
+#include "threading.h"
+#include "arena.h"
+#include "profile.h"
 
-#define ALLOCA dALLOCA16
+// temporaries come from the stepper arena, which must be in scope as `arena'
+#define ALLOCA(n) (arena->alloc (n))
 
 //****************************************************************************
 // Auto disabling
@@ -267,13 +272,16 @@ void dxStepBody (dxBody *b, dReal h)
   dNormalize4 (b->q);
   dQtoR (b->q,b->posr.R);
 
-  // notify all attached geoms that this body has moved
-  for (dxGeom *geom = b->geom; geom; geom = dGeomGetBodyNext (geom))
-    dGeomMoved (geom);
+  // notify all attached geoms that this body has moved, and notify the
+  // user. when islands are stepped in parallel this would touch shared
+  // space data, so it is left to dxProcessIslands() instead.
+  if (!dxThreadGetContext()) {
+    for (dxGeom *geom = b->geom; geom; geom = dGeomGetBodyNext (geom))
+      dGeomMoved (geom);
 
-  // notify the user
-  if (b->moved_callback)
-    b->moved_callback(b);
+    if (b->moved_callback)
+      b->moved_callback(b);
+  }
 
 
   // damping
@@ -299,6 +307,289 @@ void dxStepBody (dxBody *b, dReal h)
 //****************************************************************************
 // island processing
 
+// a disabled body that was stepped because it is connected to an enabled
+// one (e.g. touched by it) wakes up as if by dBodyEnable(), so it gets the
+// full idle time before it can be disabled again. meanwhile its own contacts
+// can wake its neighbours, also in spaces that ignore idle pairs.
+
+static inline void wakeSteppedBody (dxBody *b)
+{
+  if (b->flags & dxBodyDisabled) {
+    b->flags &= ~dxBodyDisabled;
+    b->adis_stepsleft = b->adis.idle_steps;
+    b->adis_timeleft = b->adis.idle_time;
+  }
+}
+
+
+// if debugging, check that all objects (except for disabled bodies,
+// unconnected joints, and joints that are connected to disabled bodies)
+// were tagged.
+
+static void checkIslandTags (dxWorld *world)
+{
+# ifndef dNODEBUG
+  dxBody *b;
+  dxJoint *j;
+  for (b=world->firstbody; b; b=(dxBody*)b->next) {
+    if (b->flags & dxBodyDisabled) {
+      if (b->tag) dDebug (0,"disabled body tagged");
+    }
+    else {
+      if (!b->tag) dDebug (0,"enabled body not tagged");
+    }
+  }
+  for (j=world->firstjoint; j; j=(dxJoint*)j->next) {
+    if ( (( j->node[0].body && (j->node[0].body->flags & dxBodyDisabled)==0 ) ||
+          (j->node[1].body && (j->node[1].body->flags & dxBodyDisabled)==0) )
+         && 
+         j->isEnabled() ) {
+      if (!j->tag) dDebug (0,"attached enabled joint not tagged");
+    }
+    else {
+      if (j->tag) dDebug (0,"unattached or disabled joint tagged");
+    }
+  }
+# endif
+}
+
+
+// the contacts of contact groups are only put in their bodies' joint lists
+// for the island search, in the same way as dJointAttach() would have put
+// them there. this returns the number of contacts.
+
+static int linkContactGroups (dxWorld *world)
+{
+  int count = 0;
+  for (int i=0; i<world->contact_slabs.size(); i++) {
+    dxContactSlab *slab = world->contact_slabs[i];
+    for (int k=0; k<slab->count; k++) {
+      dxJointContact *j = slab->get (k);
+      j->tag = 0;
+      dxBody *body1 = j->node[0].body;
+      dxBody *body2 = j->node[1].body;
+      if (body1) {
+	j->node[1].next = body1->firstjoint;
+	body1->firstjoint = &j->node[1];
+      }
+      if (body2) {
+	j->node[0].next = body2->firstjoint;
+	body2->firstjoint = &j->node[0];
+      }
+    }
+    count += slab->count;
+  }
+  return count;
+}
+
+
+// take a node out of a body's joint list. the contacts of the contact groups
+// are normally at the front, unless a moved callback attached more joints.
+
+static inline void unlinkNode (dxBody *body, dxJointNode *node)
+{
+  dxJointNode **n = &body->firstjoint;
+  while (*n != node) n = &(*n)->next;
+  *n = node->next;
+  node->next = 0;
+}
+
+
+// take the contacts of the contact groups out of the joint lists again, most
+// recently linked first.
+
+static void unlinkContactGroups (dxWorld *world)
+{
+  for (int i=world->contact_slabs.size()-1; i>=0; i--) {
+    dxContactSlab *slab = world->contact_slabs[i];
+    for (int k=slab->count-1; k>=0; k--) {
+      dxJointContact *j = slab->get (k);
+      if (j->node[1].body) unlinkNode (j->node[1].body,&j->node[0]);
+      if (j->node[0].body) unlinkNode (j->node[0].body,&j->node[1]);
+    }
+  }
+}
+
+
+// state of the island that is being stepped on the current thread. this
+// is only set while islands are stepped in parallel.
+
+struct dxIslandContext {
+  unsigned long seed;		// random sequence for this island
+};
+
+
+int dxStepperRandInt (int n)
+{
+  dxIslandContext *context = (dxIslandContext*) dxThreadGetContext();
+  if (!context) return dRandInt (n);
+
+  // same generator as dRand(), xor-folded like dRandInt()
+  context->seed = (1664525L*context->seed + 1013904223L) & 0xffffffff;
+  unsigned long r = context->seed;
+  r ^= (r >> 16);
+  return (int) (r % (unsigned long) n);
+}
+
+
+// release the temporaries of a step. this also merges the blocks of the
+// arenas that had to grow, so that the next step can be done in one block.
+
+static void resetStepArenas (dxWorld *world)
+{
+  for (int i=0; i<world->step_arenas.size(); i++)
+    world->step_arenas[i]->reset();
+}
+
+
+// an island in the arrays that are handed to the pool threads
+
+struct dxIsland {
+  int body_start, bcount;	// range in dxIslandsJob::body
+  int joint_start, jcount;	// range in dxIslandsJob::joint
+  unsigned long seed;		// seed for dxStepperRandInt()
+};
+
+
+struct dxIslandsJob {
+  dxWorld *world;
+  dReal stepsize;
+  dstepper_fn_t stepper;
+  dxBody **body;		// the bodies of all islands, one after another
+  dxJoint **joint;		// the joints of all islands, one after another
+  dxIsland *island;
+  dxArena **arenas;		// arena of every pool thread
+};
+
+
+static void stepIslandTask (void *data, int index, int thread)
+{
+  dxIslandsJob *job = (dxIslandsJob*) data;
+  dxIsland *island = job->island + index;
+
+  dxIslandContext context;
+  context.seed = island->seed;
+  dxThreadSetContext (&context);
+  dxArena *arena = job->arenas[thread];
+  dxArena::Marker marker = arena->mark();
+  job->stepper (job->world, job->body + island->body_start, island->bcount,
+		job->joint + island->joint_start, island->jcount,
+		job->stepsize, arena);
+  arena->release (marker);
+  dxThreadSetContext (0);
+}
+
+
+// hand out the biggest islands first, so that a big island that is
+// picked up last does not leave the other threads idle.
+
+static int compareIslandSize (const void *a, const void *b)
+{
+  const dxIsland *i1 = (const dxIsland*) a;
+  const dxIsland *i2 = (const dxIsland*) b;
+  int s1 = i1->bcount + i1->jcount;
+  int s2 = i2->bcount + i2->jcount;
+  if (s1 != s2) return (s1 > s2) ? -1 : 1;
+  return i1->body_start - i2->body_start;
+}
+
+
+// like the serial loop in dxProcessIslands(), but all islands are found
+// first and then stepped together on the world's thread pool. the steppers
+// only touch the bodies and joints of their own island, except for the
+// geom and moved-callback notifications in dxStepBody(), which are
+// deferred and issued here afterwards in the same order as serial stepping
+// would have issued them.
+
+static void processIslandsThreaded (dxWorld *world, dReal stepsize,
+				    dstepper_fn_t stepper, int nj)
+{
+  dxBody *b,*bb;
+  dxJoint *j;
+
+  if (!world->island_pool)
+    world->island_pool = new dxThreadPool (world->island_threads);
+
+  // the calling thread is thread 0 of the pool, so this shares its arena
+  // with the islands that are stepped on it.
+  dxArena *arena = world->step_arenas[0];
+
+  dxBody **body = (dxBody**) ALLOCA (world->nb * sizeof(dxBody*));
+  dxJoint **joint = (dxJoint**) ALLOCA (nj * sizeof(dxJoint*));
+  dxIsland *island = (dxIsland*) ALLOCA (world->nb * sizeof(dxIsland));
+  int bcount = 0;	// number of bodies in `body'
+  int jcount = 0;	// number of joints in `joint'
+  int icount = 0;	// number of islands in `island'
+
+  // set all body/joint tags to 0
+  for (b=world->firstbody; b; b=(dxBody*)b->next) b->tag = 0;
+  for (j=world->firstjoint; j; j=(dxJoint*)j->next) j->tag = 0;
+
+  // stack of unvisited bodies, see dxProcessIslands(). here the first body
+  // of an island goes on the stack too, so it needs one more entry.
+  int stackalloc = ((nj < world->nb) ? nj : world->nb) + 1;
+  dxBody **stack = (dxBody**) ALLOCA (stackalloc * sizeof(dxBody*));
+
+  // the traversal is the same as in dxProcessIslands(), so the bodies and
+  // joints of every island come out in the same order.
+  for (bb=world->firstbody; bb; bb=(dxBody*)bb->next) {
+    if (bb->tag || (bb->flags & dxBodyDisabled)) continue;
+    bb->tag = 1;
+
+    dxIsland *isl = island + icount++;
+    isl->body_start = bcount;
+    isl->joint_start = jcount;
+    isl->seed = dRand();
+
+    int stacksize = 0;
+    stack[stacksize++] = bb;
+    while (stacksize > 0) {
+      b = stack[--stacksize];
+      body[bcount++] = b;
+      for (dxJointNode *n=b->firstjoint; n; n=n->next) {
+	if (!n->joint->tag && n->joint->isEnabled()) {
+	  n->joint->tag = 1;
+	  joint[jcount++] = n->joint;
+	  if (n->body && !n->body->tag) {
+	    n->body->tag = 1;
+	    stack[stacksize++] = n->body;
+	  }
+	}
+      }
+      dIASSERT(stacksize <= stackalloc);
+    }
+
+    isl->bcount = bcount - isl->body_start;
+    isl->jcount = jcount - isl->joint_start;
+  }
+
+  qsort (island,icount,sizeof(dxIsland),&compareIslandSize);
+
+  dxIslandsJob job;
+  job.world = world;
+  job.stepsize = stepsize;
+  job.stepper = stepper;
+  job.body = body;
+  job.joint = joint;
+  job.island = island;
+  job.arenas = world->step_arenas.data();
+  world->island_pool->run (icount,&stepIslandTask,&job);
+
+  // issue the deferred notifications, and make sure the tags are nonzero
+  // and all stepped bodies are in the enabled state.
+  for (int i=0; i<bcount; i++) {
+    b = body[i];
+    for (dxGeom *geom = b->geom; geom; geom = dGeomGetBodyNext (geom))
+      dGeomMoved (geom);
+    if (b->moved_callback)
+      b->moved_callback(b);
+    b->tag = 1;
+    wakeSteppedBody (b);
+  }
+  for (int i=0; i<jcount; i++) joint[i]->tag = 1;
+}
+
+
 // this groups all joints and bodies in a world into islands. all objects
 // in an island are reachable by going through connected bodies and joints.
 // each island can be simulated separately.
@@ -309,6 +600,10 @@ void dxStepBody (dxBody *b, dReal h)
 // never start a new islands from a disabled body. thus islands of disabled
 // bodies will not be included in the simulation. disabled bodies are
 // re-enabled if they are found to be part of an active island.
+//
+// with more than one island thread, processIslandsThreaded() finds all
+// islands first, in the same way and the same order, and then steps them
+// in parallel. disabled bodies in them are re-enabled afterwards.
 
 void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
 {
@@ -318,12 +613,32 @@ void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
   // nothing to do if no bodies
   if (world->nb <= 0) return;
 
+  // the steppers report their own zones, which are taken out of this one
+  dxProfileScope profile (world->profile,dProfileIslands);
+
+  // every joint that can be in an island, with the contact groups linked in
+  const int nj = world->nj + linkContactGroups (world);
+
   // handle auto-disabling of bodies
   dInternalHandleAutoDisabling (world,stepsize);
 
+  // every thread that steps islands needs an arena
+  while (world->step_arenas.size() < world->island_threads)
+    world->step_arenas.push (new dxArena);
+
+  if (world->island_threads > 1) {
+    processIslandsThreaded (world,stepsize,stepper,nj);
+    checkIslandTags (world);
+    unlinkContactGroups (world);
+    resetStepArenas (world);
+    return;
+  }
+
+  dxArena *arena = world->step_arenas[0];
+
   // make arrays for body and joint lists (for a single island) to go into
   body = (dxBody**) ALLOCA (world->nb * sizeof(dxBody*));
-  joint = (dxJoint**) ALLOCA (world->nj * sizeof(dxJoint*));
+  joint = (dxJoint**) ALLOCA (nj * sizeof(dxJoint*));
   int bcount = 0;	// number of bodies in `body'
   int jcount = 0;	// number of joints in `joint'
 
@@ -335,7 +650,7 @@ void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
   // the stack can be the lesser of the number of bodies or joints, because
   // new bodies are only ever added to the stack by going through untagged
   // joints. all the bodies in the stack must be tagged!
-  int stackalloc = (world->nj < world->nb) ? world->nj : world->nb;
+  int stackalloc = (nj < world->nb) ? nj : world->nb;
   dxBody **stack = (dxBody**) ALLOCA (stackalloc * sizeof(dxBody*));
 
   for (bb=world->firstbody; bb; bb=(dxBody*)bb->next) {
@@ -368,11 +683,13 @@ void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
 	}
       }
       dIASSERT(stacksize <= world->nb);
-      dIASSERT(stacksize <= world->nj);
+      dIASSERT(stacksize <= nj);
     }
 
     // now do something with body and joint lists
-    stepper (world,body,bcount,joint,jcount,stepsize);
+    dxArena::Marker marker = arena->mark();
+    stepper (world,body,bcount,joint,jcount,stepsize,arena);
+    arena->release (marker);
 
     // what we've just done may have altered the body/joint tag values.
     // we must make sure that these tags are nonzero.
@@ -380,36 +697,12 @@ void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
     int i;
     for (i=0; i<bcount; i++) {
       body[i]->tag = 1;
-      body[i]->flags &= ~dxBodyDisabled;
+      wakeSteppedBody (body[i]);
     }
     for (i=0; i<jcount; i++) joint[i]->tag = 1;
   }
 
-  // if debugging, check that all objects (except for disabled bodies,
-  // unconnected joints, and joints that are connected to disabled bodies)
-  // were tagged.
-# ifndef dNODEBUG
-  for (b=world->firstbody; b; b=(dxBody*)b->next) {
-    if (b->flags & dxBodyDisabled) {
-      if (b->tag) dDebug (0,"disabled body tagged");
-    }
-    else {
-      if (!b->tag) dDebug (0,"enabled body not tagged");
-    }
-  }
-  for (j=world->firstjoint; j; j=(dxJoint*)j->next) {
-    if ( (( j->node[0].body && (j->node[0].body->flags & dxBodyDisabled)==0 ) ||
-          (j->node[1].body && (j->node[1].body->flags & dxBodyDisabled)==0) )
-         && 
-         j->isEnabled() ) {
-      if (!j->tag) dDebug (0,"attached enabled joint not tagged");
-    }
-    else {
-      if (j->tag) dDebug (0,"unattached or disabled joint tagged");
-    }
-  }
-# endif
+  checkIslandTags (world);
+  unlinkContactGroups (world);
+  resetStepArenas (world);
 }
-
-
-
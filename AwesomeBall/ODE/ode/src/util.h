@@ -61,11 +61,19 @@
 void dInternalHandleAutoDisabling (dxWorld *world, dReal stepsize);
 void dxStepBody (dxBody *b, dReal h);
 
+// a stepper takes all its temporaries from `arena'. they are released when
+// the stepper returns.
+
 typedef void (*dstepper_fn_t) (dxWorld *world, dxBody * const *body, int nb,
-        dxJoint * const *_joint, int nj, dReal stepsize);
+        dxJoint * const *_joint, int nj, dReal stepsize, dxArena *arena);
 
 void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper);
 
+// return a random integer in 0..n-1 for use by the steppers. this is
+// dRandInt() unless islands are being stepped in parallel, in which case
+// every island draws from its own sequence.
+int dxStepperRandInt (int n);
+
 
 
 #endif
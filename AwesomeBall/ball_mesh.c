@@ -0,0 +1,237 @@
+/*
+ *  ball_mesh.c
+ *  AwesomeBall
+ *
+ *  Created by Brian Pratt on 10/17/26.
+ *  Copyright 2009-2013 Jonathan Johnson and Brian Pratt. All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+ *    in the documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ *  BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ *  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ *  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "ball_mesh.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define __glPi 3.14159265358979323846
+
+// Subdivisions used for each level of detail
+static const unsigned int lodSubdivisions[BALL_MESH_NUM_LODS] = {1, 2, 3};
+
+// Largest screen radius (in pixels) each level of detail is used for. The
+// finest level is used for anything bigger.
+static const GLfloat lodMaxScreenRadius[BALL_MESH_NUM_LODS - 1] = {24, 72};
+
+static BallMesh lodMeshes[BALL_MESH_NUM_LODS];
+
+
+// Hash table from an edge (pair of vertex indices) to the vertex at its midpoint
+typedef struct EdgeTable {
+	GLuint * keys;   // (low index << 16 | high index) + 1, 0 = empty slot
+	GLuint * values;
+	GLuint size;     // power of two
+} EdgeTable;
+
+static GLuint edgeMidpoint(EdgeTable *table, GLfloat *positions, GLuint *numPositions, GLuint a, GLuint b) {
+	GLuint lo = a < b ? a : b;
+	GLuint hi = a < b ? b : a;
+	GLuint key = ((lo << 16) | hi) + 1;
+	GLuint slot = (key * 2654435761u) & (table->size - 1);
+	while (table->keys[slot] != 0) {
+		if (table->keys[slot] == key)
+			return table->values[slot];
+		slot = (slot + 1) & (table->size - 1);
+	}
+	
+	// New vertex, pushed out onto the unit sphere
+	GLuint index = (*numPositions)++;
+	GLfloat *p = positions + index * 3;
+	p[0] = positions[a * 3] + positions[b * 3];
+	p[1] = positions[a * 3 + 1] + positions[b * 3 + 1];
+	p[2] = positions[a * 3 + 2] + positions[b * 3 + 2];
+	GLfloat len = sqrtf(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+	p[0] /= len;
+	p[1] /= len;
+	p[2] /= len;
+	
+	table->keys[slot] = key;
+	table->values[slot] = index;
+	return index;
+}
+
+// Texture coordinates of a point on the sphere for one of the two hemispheres
+static void hemisphereTexCoord(const GLfloat *p, int back, GLfloat *texCoord) {
+	if (back) {
+		texCoord[0] = 0.75 - 0.25 * p[0] / (1 - p[2]);
+		texCoord[1] = 0.5 + 0.5 * p[1] / (1 - p[2]);
+	}
+	else {
+		texCoord[0] = 0.25 + 0.25 * p[0] / (1 + p[2]);
+		texCoord[1] = 0.5 + 0.5 * p[1] / (1 + p[2]);
+	}
+}
+
+int ballMeshCreate(BallMesh *mesh, unsigned int subdivisions) {
+	memset(mesh, 0, sizeof(BallMesh));
+	if (subdivisions < 1 || subdivisions > 5)
+		return 0;
+	
+	GLuint maxTriangles = 20 << (2 * subdivisions);
+	GLuint maxPositions = maxTriangles / 2 + 2;
+	GLfloat *positions = malloc(maxPositions * 3 * sizeof(GLfloat));
+	GLuint *triangles = malloc(maxTriangles * 3 * sizeof(GLuint));
+	GLuint *nextTriangles = malloc(maxTriangles * 3 * sizeof(GLuint));
+	EdgeTable table;
+	table.size = 1;
+	while (table.size < maxTriangles)
+		table.size <<= 1;
+	table.keys = malloc(table.size * sizeof(GLuint));
+	table.values = malloc(table.size * sizeof(GLuint));
+	GLint *remap = malloc(maxPositions * 2 * sizeof(GLint));
+	int ok = 0;
+	if (!positions || !triangles || !nextTriangles || !table.keys || !table.values || !remap)
+		goto done;
+	
+	// Icosahedron with a vertex at each pole and two rings of five in between
+	GLuint numPositions = 0;
+	GLfloat ringZ = 1 / sqrtf(5);
+	GLfloat ringR = 2 / sqrtf(5);
+	positions[numPositions * 3] = 0;
+	positions[numPositions * 3 + 1] = 0;
+	positions[numPositions * 3 + 2] = 1;
+	numPositions++;
+	for (int i = 0; i < 5; i++) {
+		GLfloat angle = i * 2 * __glPi / 5;
+		positions[numPositions * 3] = ringR * cosf(angle);
+		positions[numPositions * 3 + 1] = ringR * sinf(angle);
+		positions[numPositions * 3 + 2] = ringZ;
+		numPositions++;
+	}
+	for (int i = 0; i < 5; i++) {
+		GLfloat angle = (i + 0.5) * 2 * __glPi / 5;
+		positions[numPositions * 3] = ringR * cosf(angle);
+		positions[numPositions * 3 + 1] = ringR * sinf(angle);
+		positions[numPositions * 3 + 2] = -ringZ;
+		numPositions++;
+	}
+	positions[numPositions * 3] = 0;
+	positions[numPositions * 3 + 1] = 0;
+	positions[numPositions * 3 + 2] = -1;
+	numPositions++;
+	
+	// Faces, counter-clockwise seen from outside
+	GLuint numTriangles = 0;
+	for (GLuint i = 0; i < 5; i++) {
+		GLuint top = 1 + i, nextTop = 1 + (i + 1) % 5;
+		GLuint bottom = 6 + i, prevBottom = 6 + (i + 4) % 5;
+		GLuint *t = triangles + numTriangles * 3;
+		t[0] = 0; t[1] = top; t[2] = nextTop;
+		t[3] = top; t[4] = bottom; t[5] = nextTop;
+		t[6] = top; t[7] = prevBottom; t[8] = bottom;
+		t[9] = 11; t[10] = 6 + (i + 1) % 5; t[11] = bottom;
+		numTriangles += 4;
+	}
+	
+	// Split every triangle into four, one level at a time. Edges between the
+	// rings are split at the equator, so from the first level on no triangle
+	// crosses it.
+	for (unsigned int level = 0; level < subdivisions; level++) {
+		memset(table.keys, 0, table.size * sizeof(GLuint));
+		GLuint numNext = 0;
+		for (GLuint i = 0; i < numTriangles; i++) {
+			GLuint a = triangles[i * 3], b = triangles[i * 3 + 1], c = triangles[i * 3 + 2];
+			GLuint ab = edgeMidpoint(&table, positions, &numPositions, a, b);
+			GLuint bc = edgeMidpoint(&table, positions, &numPositions, b, c);
+			GLuint ca = edgeMidpoint(&table, positions, &numPositions, c, a);
+			GLuint *t = nextTriangles + numNext * 3;
+			t[0] = a; t[1] = ab; t[2] = ca;
+			t[3] = ab; t[4] = b; t[5] = bc;
+			t[6] = ca; t[7] = bc; t[8] = c;
+			t[9] = ab; t[10] = bc; t[11] = ca;
+			numNext += 4;
+		}
+		GLuint *swap = triangles;
+		triangles = nextTriangles;
+		nextTriangles = swap;
+		numTriangles = numNext;
+	}
+	
+	// Give each hemisphere its own copy of the vertices it uses, so the ones on
+	// the equator get texture coordinates from both halves of the texture
+	mesh->vertices = malloc(numPositions * 2 * sizeof(BallMeshVertex));
+	mesh->indices = malloc(numTriangles * 3 * sizeof(GLushort));
+	if (!mesh->vertices || !mesh->indices)
+		goto done;
+	for (GLuint i = 0; i < numPositions * 2; i++)
+		remap[i] = -1;
+	for (GLuint i = 0; i < numTriangles; i++) {
+		GLuint *t = triangles + i * 3;
+		int back = positions[t[0] * 3 + 2] + positions[t[1] * 3 + 2] + positions[t[2] * 3 + 2] < 0;
+		for (int j = 0; j < 3; j++) {
+			GLuint key = t[j] * 2 + back;
+			if (remap[key] < 0) {
+				const GLfloat *p = positions + t[j] * 3;
+				BallMeshVertex *v = mesh->vertices + mesh->numVertices;
+				memcpy(v->position, p, sizeof(v->position));
+				memcpy(v->normal, p, sizeof(v->normal));
+				hemisphereTexCoord(p, back, v->texCoord);
+				remap[key] = mesh->numVertices++;
+			}
+			mesh->indices[mesh->numIndices++] = remap[key];
+		}
+	}
+	ok = 1;
+	
+done:
+	free(positions);
+	free(triangles);
+	free(nextTriangles);
+	free(table.keys);
+	free(table.values);
+	free(remap);
+	if (!ok)
+		ballMeshDestroy(mesh);
+	return ok;
+}
+
+void ballMeshDestroy(BallMesh *mesh) {
+	free(mesh->vertices);
+	free(mesh->indices);
+	memset(mesh, 0, sizeof(BallMesh));
+}
+
+const BallMesh * ballMeshForLOD(unsigned int lod) {
+	if (lod >= BALL_MESH_NUM_LODS)
+		lod = BALL_MESH_NUM_LODS - 1;
+	if (!lodMeshes[lod].vertices)
+		ballMeshCreate(&lodMeshes[lod], lodSubdivisions[lod]);
+	return &lodMeshes[lod];
+}
+
+GLfloat ballMeshScreenRadius(GLfloat radius, GLfloat distance, GLfloat fovy, GLfloat viewportHeight) {
+	// Eye inside the ball, so it fills the view
+	if (distance <= radius)
+		return viewportHeight;
+	GLfloat tangent = tanf(fovy * __glPi / 360.0);
+	return radius / (distance * tangent) * viewportHeight / 2;
+}
+
+unsigned int ballMeshLODForScreenRadius(GLfloat screenRadius) {
+	unsigned int lod = 0;
+	while (lod < BALL_MESH_NUM_LODS - 1 && screenRadius > lodMaxScreenRadius[lod])
+		lod++;
+	return lod;
+}
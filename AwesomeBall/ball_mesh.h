@@ -0,0 +1,69 @@
+/*
+ *  ball_mesh.h
+ *  AwesomeBall
+ *
+ *  Created by Brian Pratt on 10/17/26.
+ *  Copyright 2009-2013 Jonathan Johnson and Brian Pratt. All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+ *    in the documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ *  BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ *  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ *  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+// Runtime generator for the ball mesh, at several levels of detail. The sphere
+// is a subdivided icosahedron; level 3 has the same 682 vertices and 1280
+// triangles that used to be stored in ball_model.h. Each hemisphere is mapped
+// stereographically onto one half of the ball texture (z >= 0 on the left,
+// z <= 0 on the right), so the vertices on the equator are duplicated.
+
+#ifdef BALL_MESH_NO_GL
+// Headless builds (see ball_mesh_check.c) only need the GL scalar types
+typedef float GLfloat;
+typedef int GLint;
+typedef unsigned int GLuint;
+typedef unsigned short GLushort;
+#else
+#include <OpenGLES/ES1/gl.h>
+#endif
+
+// Number of levels of detail. LOD 0 is the coarsest, BALL_MESH_NUM_LODS-1 the finest.
+#define BALL_MESH_NUM_LODS 3
+
+typedef struct BallMeshVertex {
+	GLfloat position[3];
+	GLfloat normal[3];
+	GLfloat texCoord[2];
+} BallMeshVertex;
+
+typedef struct BallMesh {
+	BallMeshVertex * vertices;
+	GLuint numVertices;
+	GLushort * indices;
+	GLuint numIndices;
+} BallMesh;
+
+// Build a unit sphere by subdividing an icosahedron (subdivisions must be 1-5).
+// Returns 0 if out of memory.
+int ballMeshCreate(BallMesh *mesh, unsigned int subdivisions);
+void ballMeshDestroy(BallMesh *mesh);
+
+// Shared mesh for a level of detail, built the first time it is asked for
+const BallMesh * ballMeshForLOD(unsigned int lod);
+
+// Radius in pixels of a sphere of the given radius seen from distance (from the
+// eye to its center) through a perspective projection with vertical field of
+// view fovy (in degrees) onto a viewport viewportHeight pixels high
+GLfloat ballMeshScreenRadius(GLfloat radius, GLfloat distance, GLfloat fovy, GLfloat viewportHeight);
+
+// Coarsest level of detail that still looks round at the given screen radius
+unsigned int ballMeshLODForScreenRadius(GLfloat screenRadius);
@@ -0,0 +1,135 @@
+/*
+ *  ball_mesh_check.c
+ *  AwesomeBall
+ *
+ *  Created by Brian Pratt on 10/17/26.
+ *  Copyright 2009-2013 Jonathan Johnson and Brian Pratt. All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+ *    in the documentation and/or other materials provided with the distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ *  BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ *  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ *  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+// Headless check of the ball meshes that GLBall uploads into its vertex and
+// index buffers. It needs no GL, so it builds and runs anywhere:
+//
+//   cc -std=c99 -DBALL_MESH_NO_GL ball_mesh_check.c ball_mesh.c -lm -o ball_mesh_check
+//   ./ball_mesh_check
+//
+// It checks that BallMeshVertex has the layout -[GLBall draw] describes with
+// glVertexPointer, glNormalPointer and glTexCoordPointer, and that every
+// level of detail has indices in range and triangles wound counter-clockwise
+// seen from outside. It prints one line per check and exits with 1 if any
+// check fails.
+
+#include "ball_mesh.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+
+static int failures = 0;
+
+static void check(int ok, const char *what) {
+	printf("%s: %s\n", ok ? "ok" : "FAILED", what);
+	if (!ok)
+		failures++;
+}
+
+// -[GLBall draw] passes sizeof(BallMeshVertex) as the stride of all three
+// arrays, 3 GL_FLOATs at offsetof(position) to glVertexPointer, 3 GL_FLOATs at
+// offsetof(normal) to glNormalPointer and 2 GL_FLOATs at offsetof(texCoord) to
+// glTexCoordPointer
+static void checkVertexLayout(void) {
+	const size_t stride = sizeof(BallMeshVertex);
+	const size_t f = sizeof(GLfloat);
+	BallMeshVertex v;
+	check(sizeof(v.position) == 3 * f && sizeof(v.normal) == 3 * f && sizeof(v.texCoord) == 2 * f,
+		  "vertex attributes are 3, 3 and 2 floats");
+	check(offsetof(BallMeshVertex, position) == 0 &&
+		  offsetof(BallMeshVertex, normal) == 3 * f &&
+		  offsetof(BallMeshVertex, texCoord) == 6 * f,
+		  "vertex attributes are interleaved without gaps");
+	check(stride == 8 * f, "vertex stride is 8 floats");
+	check(stride % 4 == 0, "vertex stride is a multiple of 4 bytes");
+}
+
+static void checkMesh(unsigned int lod) {
+	char what[128];
+	const BallMesh *mesh = ballMeshForLOD(lod);
+	
+	snprintf(what, sizeof(what), "LOD %u was built (%u vertices, %u indices)", lod, mesh->numVertices, mesh->numIndices);
+	check(mesh->vertices != NULL && mesh->indices != NULL, what);
+	if (!mesh->vertices || !mesh->indices)
+		return;
+	
+	snprintf(what, sizeof(what), "LOD %u index count is a multiple of 3", lod);
+	check(mesh->numIndices % 3 == 0, what);
+	
+	// The indices are GLushort, so every vertex must be reachable by one
+	snprintf(what, sizeof(what), "LOD %u vertices fit GLushort indices", lod);
+	check(mesh->numVertices <= 65536, what);
+	
+	int inRange = 1;
+	for (GLuint i = 0; i < mesh->numIndices; i++) {
+		if (mesh->indices[i] >= mesh->numVertices)
+			inRange = 0;
+	}
+	snprintf(what, sizeof(what), "LOD %u indices are in range", lod);
+	check(inRange, what);
+	if (!inRange)
+		return;
+	
+	int unit = 1, texture = 1;
+	for (GLuint i = 0; i < mesh->numVertices; i++) {
+		const BallMeshVertex *v = mesh->vertices + i;
+		const GLfloat *p = v->position;
+		if (fabsf(p[0] * p[0] + p[1] * p[1] + p[2] * p[2] - 1) > 1e-5f ||
+			p[0] != v->normal[0] || p[1] != v->normal[1] || p[2] != v->normal[2])
+			unit = 0;
+		if (v->texCoord[0] < 0 || v->texCoord[0] > 1 || v->texCoord[1] < 0 || v->texCoord[1] > 1)
+			texture = 0;
+	}
+	snprintf(what, sizeof(what), "LOD %u vertices are on the unit sphere with matching normals", lod);
+	check(unit, what);
+	snprintf(what, sizeof(what), "LOD %u texture coordinates are in [0,1]", lod);
+	check(texture, what);
+	
+	// Counter-clockwise seen from outside means the face normal points away
+	// from the center
+	int ccw = 1;
+	for (GLuint i = 0; i < mesh->numIndices; i += 3) {
+		const GLfloat *a = mesh->vertices[mesh->indices[i]].position;
+		const GLfloat *b = mesh->vertices[mesh->indices[i + 1]].position;
+		const GLfloat *c = mesh->vertices[mesh->indices[i + 2]].position;
+		GLfloat u[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+		GLfloat w[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+		GLfloat n[3] = {u[1] * w[2] - u[2] * w[1], u[2] * w[0] - u[0] * w[2], u[0] * w[1] - u[1] * w[0]};
+		if (n[0] * (a[0] + b[0] + c[0]) + n[1] * (a[1] + b[1] + c[1]) + n[2] * (a[2] + b[2] + c[2]) <= 0)
+			ccw = 0;
+	}
+	snprintf(what, sizeof(what), "LOD %u triangles are counter-clockwise from outside", lod);
+	check(ccw, what);
+}
+
+int main(void) {
+	checkVertexLayout();
+	for (unsigned int lod = 0; lod < BALL_MESH_NUM_LODS; lod++)
+		checkMesh(lod);
+	
+	// The finest level replaces the old ball_model.h mesh
+	const BallMesh *finest = ballMeshForLOD(BALL_MESH_NUM_LODS - 1);
+	check(finest->numIndices == 1280 * 3, "finest LOD has the 1280 triangles of the old model");
+	
+	return failures ? 1 : 0;
+}
@@ -1,32 +0,0 @@
-/*
- *  ball.h
- *  AwesomeBall
- *
- *  Created by Jonathan Johnson on 2/16/09.
- *  Copyright 2009-2013 Jonathan Johnson and Brian Pratt. All rights reserved.
- *  
- *  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
- *  
- *  - Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
- *  - Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer 
- *    in the documentation and/or other materials provided with the distribution.
- *
- *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, 
- *  BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
- *  SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
- *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
- *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE 
- *  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
- */
-
-GLfloat ballVertices[] = {0.000000, 0.000000, -1.000000, 0.723600, -0.525720, -0.447215, -0.276385, -0.850640, -0.447215, -0.894425, 0.000000, -0.447215, -0.276385, 0.850640, -0.447215, 0.723600, 0.525720, -0.447215, 0.276385, -0.850640, 0.447215, -0.723600, -0.525720, 0.447215, -0.723600, 0.525720, 0.447215, 0.276385, 0.850640, 0.447215, 0.894425, 0.000000, 0.447215, 0.000000, 0.000000, 1.000000, 0.425323, -0.309011, -0.850654, -0.162456, -0.499995, -0.850654, 0.262869, -0.809012, -0.525738, 0.425323, 0.309011, -0.850654, 0.850648, 0.000000, -0.525736, -0.525730, 0.000000, -0.850652, -0.688189, -0.499997, -0.525736, -0.162456, 0.499995, -0.850654, -0.688189, 0.499997, -0.525736, 0.262869, 0.809012, -0.525738, 0.951058, 0.309013, 0.000000, 0.951058, -0.309013, 0.000000, 0.587786, -0.809017, 0.000000, 0.000000, -1.000000, 0.000000, -0.587786, -0.809017, 0.000000, -0.951058, -0.309013, 0.000000, -0.951058, 0.309013, 0.000000, -0.587786, 0.809017, 0.000000, 0.000000, 1.000000, 0.000000, 0.587786, 0.809017, 0.000000, 0.688189, -0.499997, 0.525736, -0.262869, -0.809012, 0.525738, -0.850648, 0.000000, 0.525736, -0.262869, 0.809012, 0.525738, 0.688189, 0.499997, 0.525736, 0.525730, 0.000000, 0.850652, 0.162456, -0.499995, 0.850654, -0.425323, -0.309011, 0.850654, -0.425323, 0.309011, 0.850654, 0.162456, 0.499995, 0.850654, 0.221076, -0.160619, -0.961939, 0.597194, -0.433882, -0.674615, -0.228103, -0.702042, -0.674615, -0.084442, -0.259889, -0.961939, -0.007026, -0.862665, -0.505728, 0.512753, -0.693775, -0.505727, 0.221076, 0.160619, -0.961939, 0.597194, 0.433882, -0.674615, 0.818272, 0.273262, -0.505726, 0.818272, -0.273262, -0.505726, -0.738174, 0.000000, -0.674610, -0.273266, 0.000000, -0.961939, -0.501373, -0.702043, -0.505727, -0.822618, -0.259890, -0.505724, -0.084442, 0.259889, -0.961939, -0.228103, 0.702042, -0.674615, -0.822618, 0.259890, -0.505724, -0.501373, 0.702043, -0.505727, -0.007026, 0.862665, -0.505728, 0.512753, 0.693775, -0.505727, 0.959253, 0.160620, 0.232455, 0.870465, 0.433883, -0.232456, 0.959253, -0.160620, 0.232455, 0.870465, -0.433883, -0.232456, 0.449185, -0.862668, 0.232457, 0.681641, -0.693779, -0.232457, 0.143661, -0.961938, 0.232456, -0.143661, -0.961938, -0.232456, -0.681641, -0.693779, 0.232457, -0.449185, -0.862668, -0.232457, -0.870465, -0.433883, 0.232456, -0.959253, -0.160620, -0.232455, -0.959253, 0.160620, -0.232455, -0.870465, 0.433883, 0.232456, -0.681641, 0.693779, 0.232457, -0.449185, 0.862668, -0.232457, 0.143661, 0.961938, 0.232456, -0.143661, 0.961938, -0.232456, 0.449185, 0.862668, 0.232457, 0.681641, 0.693779, -0.232457, 0.501373, -0.702043, 0.505727, 0.822618, -0.259890, 0.505724, 0.007026, -0.862665, 0.505728, -0.512753, -0.693775, 0.505727, -0.818272, -0.273262, 0.505726, -0.818272, 0.273262, 0.505726, -0.512753, 0.693775, 0.505727, 0.007026, 0.862665, 0.505728, 0.822618, 0.259890, 0.505724, 0.501373, 0.702043, 0.505727, 0.738174, 0.000000, 0.674610, 0.273266, 0.000000, 0.961939, 0.228103, -0.702042, 0.674615, 0.084442, -0.259889, 0.961939, -0.597194, -0.433882, 0.674615, -0.221076, -0.160619, 0.961939, -0.221076, 0.160619, 0.961939, -0.597194, 0.433882, 0.674615, 0.084442, 0.259889, 0.961939, 0.228103, 0.702042, 0.674615, 0.361804, -0.587779, -0.723612, 0.138197, -0.425320, -0.894430, 0.052790, -0.688185, -0.723612, 0.670817, -0.162457, -0.723611, 0.447210, 0.000000, -0.894429, 0.670817, 0.162457, -0.723611, -0.447211, -0.525727, -0.723612, -0.361800, -0.262863, -0.894429, -0.638195, -0.262864, -0.723609, -0.638195, 0.262864, -0.723609, -0.361800, 0.262863, -0.894429, -0.447211, 0.525727, -0.723612, 0.052790, 0.688185, -0.723612, 0.138197, 0.425320, -0.894430, 0.361804, 0.587779, -0.723612, 0.947213, -0.162458, -0.276396, 0.947213, 0.162458, -0.276396, 1.000000, 0.000000, 0.000000, 0.138199, -0.951055, -0.276397, 0.447216, -0.850648, -0.276397, 0.309017, -0.951056, 0.000000, -0.861804, -0.425322, -0.276396, -0.670820, -0.688190, -0.276396, -0.809018, -0.587783, 0.000000, -0.670820, 0.688190, -0.276396, -0.861804, 0.425322, -0.276396, -0.809018, 0.587783, 0.000000, 0.447216, 0.850648, -0.276397, 0.138199, 0.951055, -0.276397, 0.309017, 0.951056, 0.000000, 0.861804, -0.425322, 0.276396, 0.809018, -0.587783, 0.000000, 0.670820, -0.688190, 0.276396, -0.138199, -0.951055, 0.276397, -0.309017, -0.951056, 0.000000, -0.447216, -0.850648, 0.276397, -0.947213, -0.162458, 0.276396, -1.000000, 0.000000, 0.000000, -0.947213, 0.162458, 0.276396, -0.447216, 0.850648, 0.276397, -0.309017, 0.951056, 0.000000, -0.138199, 0.951055, 0.276397, 0.670820, 0.688190, 0.276396, 0.809018, 0.587783, 0.000000, 0.861804, 0.425322, 0.276396, 0.447211, -0.525727, 0.723612, 0.638195, -0.262864, 0.723609, 0.361800, -0.262863, 0.894429, -0.361804, -0.587779, 0.723612, -0.052790, -0.688185, 0.723612, -0.138197, -0.425319, 0.894430, -0.670817, 0.162457, 0.723611, -0.670817, -0.162457, 0.723611, -0.447210, 0.000000, 0.894429, -0.052790, 0.688185, 0.723612, -0.361804, 0.587779, 0.723612, -0.138197, 0.425320, 0.894430, 0.638195, 0.262864, 0.723609, 0.447211, 0.525727, 0.723612, 0.361800, 0.262863, 0.894429, 0.326319, -0.237082, -0.915045, 0.111605, -0.081085, -0.990439, 0.516194, -0.375032, -0.769996, 0.666776, -0.484435, -0.566333, -0.254681, -0.783840, -0.566333, -0.197165, -0.606821, -0.769997, -0.042628, -0.131199, -0.990439, -0.124640, -0.383610, -0.915045, 0.129157, -0.843907, -0.520711, -0.143074, -0.864927, -0.481074, 0.391555, -0.758647, -0.520711, 0.624147, -0.615637, -0.481073, 0.326319, 0.237082, -0.915045, 0.111605, 0.081085, -0.990439, 0.516194, 0.375032, -0.769996, 0.666776, 0.484435, -0.566333, 0.842515, 0.137950, -0.520709, 0.778382, 0.403349, -0.481073, 0.842515, -0.137950, -0.520709, 0.778382, -0.403349, -0.481073, -0.824180, 0.000000, -0.566328, -0.638052, 0.000000, -0.769993, -0.137952, 0.000000, -0.990439, -0.403354, 0.000000, -0.915044, -0.392635, -0.783840, -0.481073, -0.600523, -0.606822, -0.520710, -0.866809, -0.131200, -0.481070, -0.762696, -0.383611, -0.520709, -0.042628, 0.131199, -0.990439, -0.124640, 0.383610, -0.915045, -0.254681, 0.783840, -0.566333, -0.197165, 0.606821, -0.769997, -0.866809, 0.131200, -0.481070, -0.762696, 0.383611, -0.520709, -0.392635, 0.783840, -0.481073, -0.600523, 0.606822, -0.520710, 0.129157, 0.843907, -0.520711, -0.143074, 0.864927, -0.481074, 0.391555, 0.758647, -0.520711, 0.624147, 0.615637, -0.481073, 0.935787, 0.081085, 0.343116, 0.964376, 0.237083, 0.117350, 0.804731, 0.484436, -0.343118, 0.919554, 0.375034, -0.117350, 0.935787, -0.081085, 0.343116, 0.964376, -0.237083, 0.117350, 0.919554, -0.375034, -0.117350, 0.804731, -0.484436, -0.343118, 0.366289, -0.864929, 0.343118, 0.523490, -0.843911, 0.117350, 0.640841, -0.758651, -0.117350, 0.709407, -0.615639, -0.343118, 0.212052, -0.915043, 0.343118, 0.072524, -0.990439, 0.117350, -0.072524, -0.990439, -0.117350, -0.212052, -0.915043, -0.343118, -0.640841, -0.758651, 0.117350, -0.709407, -0.615639, 0.343118, -0.523490, -0.843911, -0.117350, -0.366289, -0.864929, -0.343118, -0.919554, -0.375034, 0.117350, -0.804731, -0.484436, 0.343118, -0.964376, -0.237083, -0.117350, -0.935787, -0.081085, -0.343116, -0.964376, 0.237083, -0.117350, -0.935787, 0.081085, -0.343116, -0.919554, 0.375034, 0.117350, -0.804731, 0.484436, 0.343118, -0.709407, 0.615639, 0.343118, -0.640841, 0.758651, 0.117350, -0.366289, 0.864929, -0.343118, -0.523490, 0.843911, -0.117350, 0.212052, 0.915043, 0.343118, 0.072524, 0.990439, 0.117350, -0.212052, 0.915043, -0.343118, -0.072524, 0.990439, -0.117350, 0.366289, 0.864929, 0.343118, 0.523490, 0.843911, 0.117350, 0.640841, 0.758651, -0.117350, 0.709407, 0.615639, -0.343118, 0.392635, -0.783840, 0.481073, 0.600523, -0.606822, 0.520710, 0.866809, -0.131200, 0.481070, 0.762696, -0.383611, 0.520709, 0.143074, -0.864927, 0.481074, -0.129157, -0.843907, 0.520711, -0.624147, -0.615637, 0.481073, -0.391555, -0.758647, 0.520711, -0.842515, -0.137950, 0.520709, -0.778382, -0.403349, 0.481073, -0.842515, 0.137950, 0.520709, -0.778382, 0.403349, 0.481073, -0.391555, 0.758647, 0.520711, -0.624147, 0.615637, 0.481073, -0.129157, 0.843907, 0.520711, 0.143074, 0.864927, 0.481074, 0.762696, 0.383611, 0.520709, 0.866809, 0.131200, 0.481070, 0.600523, 0.606822, 0.520710, 0.392635, 0.783840, 0.481073, 0.638052, 0.000000, 0.769993, 0.824180, 0.000000, 0.566328, 0.403354, 0.000000, 0.915044, 0.137952, 0.000000, 0.990439, 0.197165, -0.606821, 0.769997, 0.254681, -0.783840, 0.566333, 0.124640, -0.383610, 0.915045, 0.042628, -0.131199, 0.990439, -0.516194, -0.375032, 0.769996, -0.666776, -0.484435, 0.566333, -0.326319, -0.237082, 0.915045, -0.111605, -0.081085, 0.990439, -0.326319, 0.237082, 0.915045, -0.111605, 0.081085, 0.990439, -0.516194, 0.375032, 0.769996, -0.666776, 0.484435, 0.566333, 0.124640, 0.383610, 0.915045, 0.042628, 0.131199, 0.990439, 0.197165, 0.606821, 0.769997, 0.254681, 0.783840, 0.566333, 0.316229, -0.707101, -0.632461, 0.398469, -0.453985, -0.796944, 0.285272, -0.371742, -0.883418, -0.012280, -0.468424, -0.883418, 0.159797, -0.757930, -0.632461, -0.055516, -0.601496, -0.796945, 0.770215, -0.082241, -0.632460, 0.554902, -0.238673, -0.796944, 0.441704, 0.156432, -0.883417, 0.441704, -0.156432, -0.883417, 0.554902, 0.238673, -0.796944, 0.770215, 0.082241, -0.632460, -0.308633, -0.519254, -0.796945, -0.574776, -0.519255, -0.632461, -0.449297, -0.133070, -0.883417, -0.265395, -0.386184, -0.883418, -0.589216, -0.133070, -0.796942, -0.671458, -0.386185, -0.632459, -0.589216, 0.133070, -0.796942, -0.671458, 0.386185, -0.632459, -0.449297, 0.133070, -0.883417, -0.265395, 0.386184, -0.883418, -0.308633, 0.519254, -0.796945, -0.574776, 0.519255, -0.632461, 0.159797, 0.757930, -0.632461, -0.055516, 0.601496, -0.796945, 0.285272, 0.371742, -0.883418, -0.012280, 0.468424, -0.883418, 0.398469, 0.453985, -0.796944, 0.316229, 0.707101, -0.632461, 0.910136, -0.082241, -0.406065, 0.960967, -0.238674, -0.139921, 0.910136, 0.082241, -0.406065, 0.960967, 0.238674, -0.139921, 0.987689, -0.156432, 0.000000, 0.987689, 0.156432, 0.000000, 0.203033, -0.891003, -0.406067, 0.069961, -0.987688, -0.139921, 0.359468, -0.840174, -0.406067, 0.523951, -0.840177, -0.139921, 0.453991, -0.891006, 0.000000, 0.156435, -0.987688, 0.000000, -0.917730, -0.371744, -0.139921, -0.784657, -0.468427, -0.406066, -0.637147, -0.757935, -0.139921, -0.687975, -0.601499, -0.406066, -0.707108, -0.707106, 0.000000, -0.891008, -0.453987, 0.000000, -0.637147, 0.757935, -0.139921, -0.687975, 0.601499, -0.406066, -0.917730, 0.371744, -0.139921, -0.784657, 0.468427, -0.406066, -0.891008, 0.453987, 0.000000, -0.707108, 0.707106, 0.000000, 0.359468, 0.840174, -0.406067, 0.523951, 0.840177, -0.139921, 0.203033, 0.891003, -0.406067, 0.069961, 0.987688, -0.139921, 0.453991, 0.891006, 0.000000, 0.156435, 0.987688, 0.000000, 0.917730, -0.371744, 0.139921, 0.784657, -0.468427, 0.406066, 0.707108, -0.707106, 0.000000, 0.891008, -0.453987, 0.000000, 0.637147, -0.757935, 0.139921, 0.687975, -0.601499, 0.406066, -0.069961, -0.987688, 0.139921, -0.203033, -0.891003, 0.406067, -0.453991, -0.891006, 0.000000, -0.156435, -0.987688, 0.000000, -0.523951, -0.840177, 0.139921, -0.359468, -0.840174, 0.406067, -0.960967, -0.238674, 0.139921, -0.910136, -0.082241, 0.406065, -0.987689, -0.156432, 0.000000, -0.987689, 0.156432, 0.000000, -0.910136, 0.082241, 0.406065, -0.960967, 0.238674, 0.139921, -0.359468, 0.840174, 0.406067, -0.523951, 0.840177, 0.139921, -0.453991, 0.891006, 0.000000, -0.156435, 0.987688, 0.000000, -0.203033, 0.891003, 0.406067, -0.069961, 0.987688, 0.139921, 0.687975, 0.601499, 0.406066, 0.637147, 0.757935, 0.139921, 0.707108, 0.707106, 0.000000, 0.891008, 0.453987, 0.000000, 0.784657, 0.468427, 0.406066, 0.917730, 0.371744, 0.139921, 0.308633, -0.519254, 0.796945, 0.574776, -0.519255, 0.632461, 0.589216, -0.133070, 0.796942, 0.671458, -0.386185, 0.632459, 0.265395, -0.386184, 0.883418, 0.449297, -0.133070, 0.883417, -0.398469, -0.453984, 0.796945, -0.316229, -0.707101, 0.632461, 0.055516, -0.601496, 0.796945, -0.159797, -0.757930, 0.632461, 0.012280, -0.468424, 0.883418, -0.285272, -0.371742, 0.883418, -0.554902, 0.238673, 0.796944, -0.770215, 0.082241, 0.632460, -0.554901, -0.238672, 0.796944, -0.770215, -0.082241, 0.632460, -0.441704, -0.156432, 0.883418, -0.441704, 0.156432, 0.883418, 0.055516, 0.601496, 0.796945, -0.159797, 0.757930, 0.632461, -0.398469, 0.453985, 0.796944, -0.316229, 0.707101, 0.632461, -0.285272, 0.371742, 0.883418, 0.012280, 0.468424, 0.883418, 0.589216, 0.133070, 0.796942, 0.671458, 0.386185, 0.632459, 0.308633, 0.519254, 0.796945, 0.574776, 0.519255, 0.632461, 0.265395, 0.386184, 0.883418, 0.449297, 0.133070, 0.883417, 0.441802, -0.647406, -0.621028, 0.562274, -0.571246, -0.597935, 0.484459, -0.516115, -0.706346, 0.253366, -0.513369, -0.819913, 0.096780, -0.564248, -0.819913, 0.210088, -0.646572, -0.733354, -0.119111, -0.792645, -0.597935, 0.023119, -0.783447, -0.621029, -0.088563, -0.702305, -0.706346, 0.027156, -0.346149, -0.937787, 0.181495, -0.296000, -0.937787, 0.069216, -0.213020, -0.974593, 0.752247, -0.220113, -0.621027, 0.717043, -0.358223, -0.597934, 0.640564, -0.301254, -0.706345, 0.566540, -0.082322, -0.819912, 0.566540, 0.082322, -0.819912, 0.679848, 0.000000, -0.733353, 0.717043, 0.358223, -0.597934, 0.752247, 0.220113, -0.621027, 0.640564, 0.301254, -0.706345, 0.337599, 0.081140, -0.937786, 0.337599, -0.081140, -0.937786, 0.223984, 0.000000, -0.974593, -0.479198, -0.620236, -0.621028, -0.369536, -0.711278, -0.597935, -0.341150, -0.620235, -0.706346, -0.409951, -0.399604, -0.819913, -0.506729, -0.266402, -0.819912, -0.550009, -0.399604, -0.733353, -0.790662, -0.131655, -0.597931, -0.737962, -0.264081, -0.621026, -0.695304, -0.132792, -0.706342, -0.320818, -0.132791, -0.937786, -0.225429, -0.264080, -0.937786, -0.181207, -0.131654, -0.974593, -0.737962, 0.264081, -0.621026, -0.790662, 0.131655, -0.597931, -0.695304, 0.132792, -0.706342, -0.506729, 0.266402, -0.819912, -0.409951, 0.399604, -0.819913, -0.550009, 0.399604, -0.733353, -0.369536, 0.711278, -0.597935, -0.479198, 0.620236, -0.621028, -0.341150, 0.620235, -0.706346, -0.225429, 0.264080, -0.937786, -0.320818, 0.132791, -0.937786, -0.181207, 0.131654, -0.974593, 0.023119, 0.783447, -0.621029, -0.119111, 0.792645, -0.597935, -0.088563, 0.702305, -0.706346, 0.096780, 0.564248, -0.819913, 0.253366, 0.513369, -0.819913, 0.210088, 0.646572, -0.733354, 0.562274, 0.571246, -0.597935, 0.441802, 0.647406, -0.621028, 0.484459, 0.516115, -0.706346, 0.181495, 0.296000, -0.937787, 0.027156, 0.346149, -0.937787, 0.069216, 0.213020, -0.974593, 0.918241, -0.301255, -0.257058, 0.855476, -0.358224, -0.373947, 0.891875, -0.220114, -0.395107, 0.959966, 0.000000, -0.280117, 0.986715, 0.082322, -0.140059, 0.986715, -0.082322, -0.140059, 0.971871, 0.000000, 0.235513, 0.989761, -0.081141, 0.117430, 0.989761, 0.081141, 0.117430, 0.918241, 0.301255, -0.257058, 0.891875, 0.220114, -0.395107, 0.855476, 0.358224, -0.373947, -0.002760, -0.966392, -0.257059, -0.076335, -0.924303, -0.373948, 0.066265, -0.916242, -0.395108, 0.296648, -0.912981, -0.280118, 0.383207, -0.912982, -0.140059, 0.226619, -0.963861, -0.140059, 0.300323, -0.924305, 0.235515, 0.228681, -0.966393, 0.117431, 0.383023, -0.916244, 0.117431, 0.570268, -0.780202, -0.257059, 0.484950, -0.780201, -0.395108, 0.605053, -0.702904, -0.373947, -0.919948, -0.296002, -0.257058, -0.902655, -0.213021, -0.373945, -0.850924, -0.346151, -0.395106, -0.776630, -0.564252, -0.280118, -0.749882, -0.646576, -0.140059, -0.846659, -0.513373, -0.140059, -0.786262, -0.571248, 0.235515, -0.848429, -0.516118, 0.117431, -0.753041, -0.647410, 0.117431, -0.565796, -0.783451, -0.257059, -0.592160, -0.702308, -0.395107, -0.481531, -0.792648, -0.373947, -0.565796, 0.783451, -0.257059, -0.481531, 0.792648, -0.373947, -0.592160, 0.702308, -0.395107, -0.776630, 0.564252, -0.280118, -0.846659, 0.513373, -0.140059, -0.749882, 0.646576, -0.140059, -0.786262, 0.571248, 0.235515, -0.753041, 0.647410, 0.117431, -0.848429, 0.516118, 0.117431, -0.919948, 0.296002, -0.257058, -0.850924, 0.346151, -0.395106, -0.902655, 0.213021, -0.373945, 0.570268, 0.780202, -0.257059, 0.605053, 0.702904, -0.373947, 0.484950, 0.780201, -0.395108, 0.296648, 0.912981, -0.280118, 0.226619, 0.963861, -0.140059, 0.383207, 0.912982, -0.140059, 0.300323, 0.924305, 0.235515, 0.383023, 0.916244, 0.117431, 0.228681, 0.966393, 0.117431, -0.002760, 0.966392, -0.257059, 0.066265, 0.916242, -0.395108, -0.076335, 0.924303, -0.373948, 0.850924, -0.346151, 0.395106, 0.902655, -0.213021, 0.373945, 0.919948, -0.296002, 0.257058, 0.846659, -0.513373, 0.140059, 0.749882, -0.646576, 0.140059, 0.776630, -0.564252, 0.280118, 0.481531, -0.792648, 0.373947, 0.592160, -0.702308, 0.395107, 0.565796, -0.783451, 0.257059, 0.753041, -0.647410, -0.117431, 0.848429, -0.516118, -0.117431, 0.786262, -0.571248, -0.235515, -0.066265, -0.916242, 0.395108, 0.076335, -0.924303, 0.373948, 0.002760, -0.966392, 0.257059, -0.226619, -0.963861, 0.140059, -0.383207, -0.912982, 0.140059, -0.296648, -0.912981, 0.280118, -0.605053, -0.702904, 0.373947, -0.484950, -0.780201, 0.395108, -0.570268, -0.780202, 0.257059, -0.383023, -0.916244, -0.117431, -0.228681, -0.966393, -0.117431, -0.300323, -0.924305, -0.235515, -0.891875, -0.220114, 0.395107, -0.855476, -0.358224, 0.373947, -0.918241, -0.301255, 0.257058, -0.986715, -0.082322, 0.140059, -0.986715, 0.082322, 0.140059, -0.959966, 0.000000, 0.280117, -0.855476, 0.358224, 0.373947, -0.891875, 0.220114, 0.395107, -0.918241, 0.301255, 0.257058, -0.989761, 0.081141, -0.117430, -0.989761, -0.081141, -0.117430, -0.971871, 0.000000, -0.235513, -0.484950, 0.780201, 0.395108, -0.605053, 0.702904, 0.373947, -0.570268, 0.780202, 0.257059, -0.383207, 0.912982, 0.140059, -0.226619, 0.963861, 0.140059, -0.296648, 0.912981, 0.280118, 0.076335, 0.924303, 0.373948, -0.066265, 0.916242, 0.395108, 0.002760, 0.966392, 0.257059, -0.228681, 0.966393, -0.117431, -0.383023, 0.916244, -0.117431, -0.300323, 0.924305, -0.235515, 0.592160, 0.702308, 0.395107, 0.481531, 0.792648, 0.373947, 0.565796, 0.783451, 0.257059, 0.749882, 0.646576, 0.140059, 0.846659, 0.513373, 0.140059, 0.776630, 0.564252, 0.280118, 0.902655, 0.213021, 0.373945, 0.850924, 0.346151, 0.395106, 0.919948, 0.296002, 0.257058, 0.848429, 0.516118, -0.117431, 0.753041, 0.647410, -0.117431, 0.786262, 0.571248, -0.235515, 0.341150, -0.620235, 0.706346, 0.369536, -0.711278, 0.597935, 0.479198, -0.620236, 0.621028, 0.550009, -0.399604, 0.733353, 0.506729, -0.266402, 0.819912, 0.409951, -0.399604, 0.819913, 0.181207, -0.131654, 0.974593, 0.225429, -0.264080, 0.937786, 0.320818, -0.132791, 0.937786, 0.695304, -0.132792, 0.706342, 0.737962, -0.264081, 0.621026, 0.790662, -0.131655, 0.597931, -0.484459, -0.516115, 0.706346, -0.562274, -0.571246, 0.597935, -0.441802, -0.647406, 0.621028, -0.210088, -0.646572, 0.733354, -0.096779, -0.564248, 0.819913, -0.253366, -0.513369, 0.819913, -0.069216, -0.213020, 0.974593, -0.181495, -0.296000, 0.937787, -0.027156, -0.346149, 0.937787, 0.088563, -0.702305, 0.706346, -0.023119, -0.783447, 0.621029, 0.119111, -0.792645, 0.597935, -0.640564, 0.301254, 0.706345, -0.717043, 0.358223, 0.597934, -0.752247, 0.220113, 0.621027, -0.679848, 0.000000, 0.733353, -0.566540, -0.082322, 0.819912, -0.566540, 0.082322, 0.819912, -0.223984, 0.000000, 0.974593, -0.337599, 0.081140, 0.937786, -0.337599, -0.081140, 0.937786, -0.640564, -0.301254, 0.706345, -0.752247, -0.220113, 0.621027, -0.717043, -0.358223, 0.597934, 0.088563, 0.702305, 0.706346, 0.119111, 0.792645, 0.597935, -0.023119, 0.783447, 0.621029, -0.210088, 0.646572, 0.733354, -0.253366, 0.513369, 0.819913, -0.096780, 0.564248, 0.819913, -0.069216, 0.213020, 0.974593, -0.027156, 0.346149, 0.937787, -0.181495, 0.296000, 0.937787, -0.484459, 0.516115, 0.706346, -0.441802, 0.647406, 0.621028, -0.562274, 0.571246, 0.597935, 0.695304, 0.132792, 0.706342, 0.790662, 0.131655, 0.597931, 0.737962, 0.264081, 0.621026, 0.550009, 0.399604, 0.733353, 0.409951, 0.399604, 0.819913, 0.506729, 0.266402, 0.819912, 0.181207, 0.131654, 0.974593, 0.320818, 0.132791, 0.937786, 0.225429, 0.264080, 0.937786, 0.341150, 0.620235, 0.706346, 0.479198, 0.620236, 0.621028, 0.369536, 0.711278, 0.597935, 1.000000, 0.000000, 0.000000, 0.987689, 0.156432, 0.000000, 0.951058, 0.309013, 0.000000, 0.987689, -0.156432, 0.000000, 0.951058, -0.309013, 0.000000, 0.309017, -0.951056, 0.000000, 0.453991, -0.891006, 0.000000, 0.587786, -0.809017, 0.000000, 0.156435, -0.987688, 0.000000, 0.000000, -1.000000, 0.000000, -0.809018, -0.587783, 0.000000, -0.707108, -0.707106, 0.000000, -0.587786, -0.809017, 0.000000, -0.891008, -0.453987, 0.000000, -0.951058, -0.309013, 0.000000, -0.809018, 0.587783, 0.000000, -0.891008, 0.453987, 0.000000, -0.951058, 0.309013, 0.000000, -0.707108, 0.707106, 0.000000, -0.587786, 0.809017, 0.000000, 0.309017, 0.951056, 0.000000, 0.156435, 0.987688, 0.000000, 0.000000, 1.000000, 0.000000, 0.453991, 0.891006, 0.000000, 0.587786, 0.809017, 0.000000, 0.707108, -0.707106, 0.000000, 0.809018, -0.587783, 0.000000, 0.891008, -0.453987, 0.000000, -0.453991, -0.891006, 0.000000, -0.309017, -0.951056, 0.000000, -0.156435, -0.987688, 0.000000, -0.987689, 0.156432, 0.000000, -1.000000, 0.000000, 0.000000, -0.987689, -0.156432, 0.000000, -0.156435, 0.987688, 0.000000, -0.309017, 0.951056, 0.000000, -0.453991, 0.891006, 0.000000, 0.891008, 0.453987, 0.000000, 0.809018, 0.587783, 0.000000, 0.707108, 0.707106, 0.000000};
-GLuint ballVertexCount = 642;
-GLfloat ballNormals[] = {0.000000, 0.000000, -1.000000, 0.723594, -0.525712, -0.447218, -0.276376, -0.850642, -0.447218, -0.894406, 0.000000, -0.447188, -0.276376, 0.850642, -0.447218, 0.723594, 0.525712, -0.447218, 0.276376, -0.850642, 0.447218, -0.723594, -0.525712, 0.447218, -0.723594, 0.525712, 0.447218, 0.276376, 0.850642, 0.447218, 0.894406, 0.000000, 0.447188, 0.000000, 0.000000, 1.000000, 0.425306, -0.309000, -0.850642, -0.162450, -0.499985, -0.850642, 0.262856, -0.808985, -0.525712, 0.425306, 0.309000, -0.850642, 0.850642, 0.000000, -0.525712, -0.525712, 0.000000, -0.850642, -0.688162, -0.499985, -0.525712, -0.162450, 0.499985, -0.850642, -0.688162, 0.499985, -0.525712, 0.262856, 0.808985, -0.525712, 0.951048, 0.309000, 0.000000, 0.951048, -0.309000, 0.000000, 0.587756, -0.809015, 0.000000, 0.000000, -1.000000, 0.000000, -0.587756, -0.809015, 0.000000, -0.951048, -0.309000, 0.000000, -0.951048, 0.309000, 0.000000, -0.587756, 0.809015, 0.000000, 0.000000, 1.000000, 0.000000, 0.587756, 0.809015, 0.000000, 0.688162, -0.499985, 0.525712, -0.262856, -0.808985, 0.525712, -0.850642, 0.000000, 0.525712, -0.262856, 0.808985, 0.525712, 0.688162, 0.499985, 0.525712, 0.525712, 0.000000, 0.850642, 0.162450, -0.499985, 0.850642, -0.425306, -0.309000, 0.850642, -0.425306, 0.309000, 0.850642, 0.162450, 0.499985, 0.850642, 0.215949, -0.156896, -0.963683, 0.600757, -0.436445, -0.669729, -0.229438, -0.706229, -0.669729, -0.082461, -0.253853, -0.963683, -0.013489, -0.863124, -0.504746, 0.518265, -0.690359, -0.504746, 0.215949, 0.156896, -0.963683, 0.600757, 0.436445, -0.669729, 0.816706, 0.279550, -0.504746, 0.816706, -0.279550, -0.504746, -0.742576, 0.000000, -0.669729, -0.266945, 0.000000, -0.963683, -0.496414, -0.706229, -0.504746, -0.825068, -0.253883, -0.504746, -0.082461, 0.253853, -0.963683, -0.229438, 0.706229, -0.669729, -0.825068, 0.253883, -0.504746, -0.496414, 0.706229, -0.504746, -0.013489, 0.863124, -0.504746, 0.518265, 0.690359, -0.504746, 0.958525, 0.156896, 0.237800, 0.867702, 0.436445, -0.237800, 0.958525, -0.156896, 0.237800, 0.867702, -0.436445, -0.237800, 0.445418, -0.863124, 0.237800, 0.683248, -0.690359, -0.237800, 0.146947, -0.960112, 0.237800, -0.146947, -0.960112, -0.237800, -0.683248, -0.690359, 0.237800, -0.445418, -0.863124, -0.237800, -0.867702, -0.436445, 0.237800, -0.958525, -0.156896, -0.237800, -0.958525, 0.156896, -0.237800, -0.867702, 0.436445, 0.237800, -0.683248, 0.690359, 0.237800, -0.445418, 0.863124, -0.237800, 0.146947, 0.960112, 0.237800, -0.146947, 0.960112, -0.237800, 0.445418, 0.863124, 0.237800, 0.683248, 0.690359, -0.237800, 0.496414, -0.706229, 0.504746, 0.825068, -0.253883, 0.504746, 0.013489, -0.863124, 0.504746, -0.518265, -0.690359, 0.504746, -0.816706, -0.279550, 0.504746, -0.816706, 0.279550, 0.504746, -0.518265, 0.690359, 0.504746, 0.013489, 0.863124, 0.504746, 0.825068, 0.253883, 0.504746, 0.496414, 0.706229, 0.504746, 0.742576, 0.000000, 0.669729, 0.266945, 0.000000, 0.963683, 0.229438, -0.706229, 0.669729, 0.082461, -0.253853, 0.963683, -0.600757, -0.436445, 0.669729, -0.215949, -0.156896, 0.963683, -0.215949, 0.156896, 0.963683, -0.600757, 0.436445, 0.669729, 0.082461, 0.253853, 0.963683, 0.229438, 0.706229, 0.669729, 0.355937, -0.587756, -0.726493, 0.139988, -0.430830, -0.891476, 0.057497, -0.684744, -0.726493, 0.668996, -0.156896, -0.726493, 0.453017, 0.000000, -0.891476, 0.668996, 0.156896, -0.726493, -0.448988, -0.520157, -0.726493, -0.366497, -0.266274, -0.891476, -0.633442, -0.266274, -0.726493, -0.633442, 0.266274, -0.726493, -0.366497, 0.266274, -0.891476, -0.448988, 0.520157, -0.726493, 0.057497, 0.684744, -0.726493, 0.139988, 0.430830, -0.891476, 0.355937, 0.587756, -0.726493, 0.948973, -0.156896, -0.273446, 0.948973, 0.156896, -0.273446, 0.999969, 0.000000, -0.006500, 0.144017, -0.951018, -0.273476, 0.442488, -0.854030, -0.273446, 0.309000, -0.951018, -0.006500, -0.859981, -0.430830, -0.273446, -0.675497, -0.684744, -0.273446, -0.808985, -0.587756, -0.006500, -0.675497, 0.684744, -0.273446, -0.859981, 0.430830, -0.273446, -0.808985, 0.587756, -0.006500, 0.442488, 0.854030, -0.273446, 0.144017, 0.951018, -0.273476, 0.309000, 0.951018, -0.006500, 0.859981, -0.430830, 0.273446, 0.808985, -0.587756, 0.006500, 0.675497, -0.684744, 0.273446, -0.144017, -0.951018, 0.273476, -0.309000, -0.951018, 0.006500, -0.442488, -0.854030, 0.273446, -0.948973, -0.156896, 0.273446, -0.999969, 0.000000, 0.006500, -0.948973, 0.156896, 0.273446, -0.442488, 0.854030, 0.273446, -0.309000, 0.951018, 0.006500, -0.144017, 0.951018, 0.273476, 0.675497, 0.684744, 0.273446, 0.808985, 0.587756, 0.006500, 0.859981, 0.430830, 0.273446, 0.448988, -0.520157, 0.726493, 0.633442, -0.266274, 0.726493, 0.366497, -0.266274, 0.891476, -0.355937, -0.587756, 0.726493, -0.057497, -0.684744, 0.726493, -0.139988, -0.430830, 0.891476, -0.668996, 0.156896, 0.726493, -0.668996, -0.156896, 0.726493, -0.453017, 0.000000, 0.891476, -0.057497, 0.684744, 0.726493, -0.355937, 0.587756, 0.726493, -0.139988, 0.430830, 0.891476, 0.633442, 0.266274, 0.726493, 0.448988, 0.520157, 0.726493, 0.366497, 0.266274, 0.891476, 0.322581, -0.234382, -0.917051, 0.104953, -0.076266, -0.991516, 0.519303, -0.377270, -0.766778, 0.670553, -0.487167, -0.559465, -0.256111, -0.788263, -0.559465, -0.198340, -0.610462, -0.766778, -0.040071, -0.123386, -0.991516, -0.123203, -0.379223, -0.917051, 0.124241, -0.844844, -0.520341, -0.151158, -0.864528, -0.479293, 0.396069, -0.756523, -0.520341, 0.630451, -0.610553, -0.479293, 0.322581, 0.234382, -0.917051, 0.104953, 0.076266, -0.991516, 0.519303, 0.377270, -0.766778, 0.670553, 0.487167, -0.559465, 0.841914, 0.142888, -0.520310, 0.775506, 0.410901, -0.479293, 0.841914, -0.142888, -0.520310, 0.775506, -0.410901, -0.479293, -0.828822, 0.000000, -0.559465, -0.641896, 0.000000, -0.766778, -0.129734, 0.000000, -0.991516, -0.398755, 0.000000, -0.917051, -0.385846, -0.788263, -0.479293, -0.597125, -0.610462, -0.520310, -0.868923, -0.123386, -0.479293, -0.765099, -0.379223, -0.520310, -0.040071, 0.123386, -0.991516, -0.123203, 0.379223, -0.917051, -0.256111, 0.788263, -0.559465, -0.198340, 0.610462, -0.766778, -0.868923, 0.123386, -0.479293, -0.765099, 0.379223, -0.520310, -0.385846, 0.788263, -0.479293, -0.597095, 0.610462, -0.520310, 0.124241, 0.844844, -0.520341, -0.151158, 0.864528, -0.479293, 0.396069, 0.756523, -0.520341, 0.630451, 0.610553, -0.479293, 0.933805, 0.076266, 0.349528, 0.964507, 0.234382, 0.121555, 0.800287, 0.487167, -0.349559, 0.918058, 0.377270, -0.121555, 0.933805, -0.076266, 0.349528, 0.964507, -0.234382, 0.121555, 0.918058, -0.377270, -0.121555, 0.800287, -0.487167, -0.349559, 0.361064, -0.864528, 0.349559, 0.520951, -0.844874, 0.121555, 0.642506, -0.756523, -0.121555, 0.710624, -0.610553, -0.349559, 0.216010, -0.911649, 0.349559, 0.075106, -0.989715, 0.121555, -0.075106, -0.989715, -0.121555, -0.216010, -0.911649, -0.349559, -0.642506, -0.756523, 0.121555, -0.710624, -0.610553, 0.349559, -0.520951, -0.844874, -0.121555, -0.361064, -0.864528, -0.349559, -0.918058, -0.377270, 0.121555, -0.800287, -0.487167, 0.349559, -0.964507, -0.234382, -0.121555, -0.933805, -0.076266, -0.349528, -0.964507, 0.234382, -0.121555, -0.933805, 0.076266, -0.349528, -0.918058, 0.377270, 0.121555, -0.800287, 0.487167, 0.349559, -0.710624, 0.610553, 0.349559, -0.642506, 0.756523, 0.121555, -0.361064, 0.864528, -0.349559, -0.520951, 0.844874, -0.121555, 0.216010, 0.911649, 0.349559, 0.075106, 0.989715, 0.121555, -0.216010, 0.911649, -0.349559, -0.075106, 0.989715, -0.121555, 0.361064, 0.864528, 0.349559, 0.520951, 0.844874, 0.121555, 0.642506, 0.756523, -0.121555, 0.710624, 0.610553, -0.349559, 0.385846, -0.788263, 0.479293, 0.597125, -0.610462, 0.520310, 0.868923, -0.123386, 0.479293, 0.765099, -0.379223, 0.520310, 0.151158, -0.864528, 0.479293, -0.124241, -0.844844, 0.520341, -0.630451, -0.610553, 0.479293, -0.396069, -0.756523, 0.520341, -0.841914, -0.142888, 0.520310, -0.775506, -0.410901, 0.479293, -0.841914, 0.142888, 0.520310, -0.775506, 0.410901, 0.479293, -0.396069, 0.756523, 0.520341, -0.630451, 0.610553, 0.479293, -0.124241, 0.844844, 0.520341, 0.151158, 0.864528, 0.479293, 0.765099, 0.379223, 0.520310, 0.868923, 0.123386, 0.479293, 0.597095, 0.610462, 0.520310, 0.385846, 0.788263, 0.479293, 0.641896, 0.000000, 0.766778, 0.828822, 0.000000, 0.559465, 0.398755, 0.000000, 0.917051, 0.129734, 0.000000, 0.991516, 0.198340, -0.610462, 0.766778, 0.256111, -0.788263, 0.559465, 0.123203, -0.379223, 0.917051, 0.040071, -0.123386, 0.991516, -0.519303, -0.377270, 0.766778, -0.670553, -0.487167, 0.559465, -0.322581, -0.234382, 0.917051, -0.104953, -0.076266, 0.991516, -0.322581, 0.234382, 0.917051, -0.104953, 0.076266, 0.991516, -0.519303, 0.377270, 0.766778, -0.670553, 0.487167, 0.559465, 0.123203, 0.379223, 0.917051, 0.040071, 0.123386, 0.991516, 0.198340, 0.610462, 0.766778, 0.256111, 0.788263, 0.559465, 0.309885, -0.708304, -0.634205, 0.393017, -0.452406, -0.800501, 0.288644, -0.376568, -0.880245, -0.012177, -0.474319, -0.880245, 0.165624, -0.755181, -0.634205, -0.052034, -0.597003, -0.800501, 0.769402, -0.075808, -0.634205, 0.551714, -0.233985, -0.800501, 0.447340, 0.158147, -0.880245, 0.447340, -0.158147, -0.880245, 0.551714, 0.233985, -0.800501, 0.769402, 0.075808, -0.634205, -0.308786, -0.513596, -0.800501, -0.577899, -0.513596, -0.634205, -0.454878, -0.134953, -0.880245, -0.268929, -0.390881, -0.880245, -0.583880, -0.134953, -0.800501, -0.667043, -0.390881, -0.634205, -0.583880, 0.134953, -0.800501, -0.667043, 0.390881, -0.634205, -0.454878, 0.134953, -0.880245, -0.268929, 0.390881, -0.880245, -0.308786, 0.513596, -0.800501, -0.577899, 0.513596, -0.634205, 0.165624, 0.755181, -0.634205, -0.052034, 0.597003, -0.800501, 0.288644, 0.376568, -0.880245, -0.012177, 0.474319, -0.880245, 0.393017, 0.452406, -0.800501, 0.309885, 0.708304, -0.634205, 0.911344, -0.075808, -0.404553, 0.962737, -0.233985, -0.135472, 0.911344, 0.075808, -0.404553, 0.962737, 0.233985, -0.135472, 0.987365, -0.158147, -0.006439, 0.987365, 0.158147, -0.006439, 0.209479, -0.890164, -0.404553, 0.074953, -0.987915, -0.135472, 0.353740, -0.843287, -0.404553, 0.520035, -0.843287, -0.135472, 0.455519, -0.890164, -0.006439, 0.154668, -0.987915, -0.006439, -0.916410, -0.376568, -0.135472, -0.781854, -0.474319, -0.404553, -0.641316, -0.755181, -0.135472, -0.692709, -0.597034, -0.404553, -0.705832, -0.708304, -0.006439, -0.891781, -0.452406, -0.006439, -0.641316, 0.755181, -0.135472, -0.692709, 0.597034, -0.404553, -0.916410, 0.376568, -0.135472, -0.781854, 0.474319, -0.404553, -0.891781, 0.452406, -0.006439, -0.705832, 0.708304, -0.006439, 0.353740, 0.843287, -0.404553, 0.520035, 0.843287, -0.135472, 0.209479, 0.890164, -0.404553, 0.074953, 0.987915, -0.135472, 0.455519, 0.890164, -0.006439, 0.154668, 0.987915, -0.006439, 0.916410, -0.376568, 0.135472, 0.781854, -0.474319, 0.404553, 0.705832, -0.708304, 0.006439, 0.891781, -0.452406, 0.006439, 0.641316, -0.755181, 0.135472, 0.692709, -0.597034, 0.404553, -0.074953, -0.987915, 0.135472, -0.209479, -0.890164, 0.404553, -0.455519, -0.890164, 0.006439, -0.154668, -0.987915, 0.006439, -0.520035, -0.843287, 0.135472, -0.353740, -0.843287, 0.404553, -0.962737, -0.233985, 0.135472, -0.911344, -0.075808, 0.404553, -0.987365, -0.158147, 0.006439, -0.987365, 0.158147, 0.006439, -0.911344, 0.075808, 0.404553, -0.962737, 0.233985, 0.135472, -0.353740, 0.843287, 0.404553, -0.520035, 0.843287, 0.135472, -0.455519, 0.890164, 0.006439, -0.154668, 0.987915, 0.006439, -0.209479, 0.890164, 0.404553, -0.074953, 0.987915, 0.135472, 0.692709, 0.597034, 0.404553, 0.641316, 0.755181, 0.135472, 0.705832, 0.708304, 0.006439, 0.891781, 0.452406, 0.006439, 0.781854, 0.474319, 0.404553, 0.916410, 0.376568, 0.135472, 0.308786, -0.513596, 0.800501, 0.577899, -0.513596, 0.634205, 0.583880, -0.134953, 0.800501, 0.667043, -0.390881, 0.634205, 0.268929, -0.390881, 0.880245, 0.454878, -0.134953, 0.880245, -0.393017, -0.452406, 0.800501, -0.309885, -0.708304, 0.634205, 0.052034, -0.597003, 0.800501, -0.165624, -0.755181, 0.634205, 0.012177, -0.474319, 0.880245, -0.288644, -0.376568, 0.880245, -0.551714, 0.233985, 0.800501, -0.769402, 0.075808, 0.634205, -0.551714, -0.233985, 0.800501, -0.769402, -0.075808, 0.634205, -0.447340, -0.158147, 0.880245, -0.447340, 0.158147, 0.880245, 0.052034, 0.597003, 0.800501, -0.165624, 0.755181, 0.634205, -0.393017, 0.452406, 0.800501, -0.309885, 0.708304, 0.634205, -0.288644, 0.376568, 0.880245, 0.012177, 0.474319, 0.880245, 0.583880, 0.134953, 0.800501, 0.667043, 0.390881, 0.634205, 0.308786, 0.513596, 0.800501, 0.577899, 0.513596, 0.634205, 0.268929, 0.390881, 0.880245, 0.454878, 0.134953, 0.880245, 0.442824, -0.646443, -0.621265, 0.560900, -0.571459, -0.598956, 0.484878, -0.517045, -0.705344, 0.251991, -0.514756, -0.819453, 0.098697, -0.564562, -0.819453, 0.209632, -0.645161, -0.734703, -0.117862, -0.792016, -0.598956, 0.021699, -0.783288, -0.621265, -0.088321, -0.703299, -0.705344, 0.028016, -0.345073, -0.938139, 0.180151, -0.295663, -0.938139, 0.069735, -0.214606, -0.974181, 0.751640, -0.221381, -0.621265, 0.716849, -0.356853, -0.598956, 0.641591, -0.301340, -0.705344, 0.567431, -0.080569, -0.819453, 0.567431, 0.080569, -0.819453, 0.678365, 0.000000, -0.734703, 0.716849, 0.356853, -0.598956, 0.751640, 0.221381, -0.621265, 0.641591, 0.301340, -0.705344, 0.336863, 0.079958, -0.938139, 0.336863, -0.079958, -0.938139, 0.225654, 0.000000, -0.974181, -0.477950, -0.620930, -0.621265, -0.370159, -0.710044, -0.598956, -0.341899, -0.620930, -0.705344, -0.411695, -0.398724, -0.819453, -0.506424, -0.268319, -0.819453, -0.548814, -0.398724, -0.734703, -0.789697, -0.132633, -0.598956, -0.738243, -0.262673, -0.621265, -0.696188, -0.133305, -0.705344, -0.319529, -0.133305, -0.938139, -0.225501, -0.262673, -0.938139, -0.182562, -0.132633, -0.974181, -0.738243, 0.262673, -0.621265, -0.789697, 0.132633, -0.598956, -0.696188, 0.133305, -0.705344, -0.506424, 0.268319, -0.819453, -0.411695, 0.398724, -0.819453, -0.548814, 0.398724, -0.734703, -0.370159, 0.710044, -0.598956, -0.477950, 0.620930, -0.621265, -0.341899, 0.620930, -0.705344, -0.225501, 0.262673, -0.938139, -0.319529, 0.133305, -0.938139, -0.182562, 0.132633, -0.974181, 0.021699, 0.783288, -0.621265, -0.117862, 0.792016, -0.598956, -0.088321, 0.703299, -0.705344, 0.098697, 0.564562, -0.819453, 0.251991, 0.514756, -0.819453, 0.209632, 0.645161, -0.734703, 0.560900, 0.571459, -0.598956, 0.442824, 0.646443, -0.621265, 0.484878, 0.517045, -0.705344, 0.180151, 0.295663, -0.938139, 0.028016, 0.345073, -0.938139, 0.069735, 0.214606, -0.974181, 0.917814, -0.301340, -0.258400, 0.856319, -0.356853, -0.373302, 0.891812, -0.221381, -0.394452, 0.960509, 0.000000, -0.278176, 0.986694, 0.080569, -0.141057, 0.986694, -0.080569, -0.141057, 0.972259, 0.000000, 0.233802, 0.989746, -0.079958, 0.118229, 0.989746, 0.079958, 0.118229, 0.917814, 0.301340, -0.258400, 0.891812, 0.221381, -0.394452, 0.856319, 0.356853, -0.373302, -0.002991, -0.966002, -0.258400, -0.074740, -0.924680, -0.373302, 0.065004, -0.916593, -0.394452, 0.296793, -0.913511, -0.278176, 0.381542, -0.913511, -0.141057, 0.228248, -0.963317, -0.141057, 0.300424, -0.924680, 0.233802, 0.229774, -0.966002, 0.118229, 0.381878, -0.916593, 0.118229, 0.570238, -0.779748, -0.258400, 0.486129, -0.779748, -0.394452, 0.603992, -0.704123, -0.373302, -0.919645, -0.295663, -0.258400, -0.902524, -0.214606, -0.373302, -0.851619, -0.345073, -0.394452, -0.777062, -0.564562, -0.278176, -0.750877, -0.645161, -0.141057, -0.845637, -0.514756, -0.141057, -0.786584, -0.571459, 0.233802, -0.847713, -0.517045, 0.118229, -0.753716, -0.646443, 0.118229, -0.565386, -0.783288, -0.258400, -0.591357, -0.703299, -0.394452, -0.483016, -0.792016, -0.373302, -0.565386, 0.783288, -0.258400, -0.483016, 0.792016, -0.373302, -0.591357, 0.703299, -0.394452, -0.777062, 0.564562, -0.278176, -0.845637, 0.514756, -0.141057, -0.750877, 0.645161, -0.141057, -0.786584, 0.571459, 0.233802, -0.753716, 0.646443, 0.118229, -0.847713, 0.517045, 0.118229, -0.919645, 0.295663, -0.258400, -0.851619, 0.345073, -0.394452, -0.902524, 0.214606, -0.373302, 0.570238, 0.779748, -0.258400, 0.603992, 0.704123, -0.373302, 0.486129, 0.779748, -0.394452, 0.296793, 0.913511, -0.278176, 0.228248, 0.963317, -0.141057, 0.381542, 0.913511, -0.141057, 0.300424, 0.924680, 0.233802, 0.381878, 0.916593, 0.118229, 0.229774, 0.966002, 0.118229, -0.002991, 0.966002, -0.258400, 0.065004, 0.916593, -0.394452, -0.074740, 0.924680, -0.373302, 0.851619, -0.345073, 0.394452, 0.902524, -0.214606, 0.373302, 0.919645, -0.295663, 0.258400, 0.845637, -0.514756, 0.141057, 0.750877, -0.645161, 0.141057, 0.777062, -0.564562, 0.278176, 0.483016, -0.792016, 0.373302, 0.591357, -0.703299, 0.394452, 0.565386, -0.783288, 0.258400, 0.753716, -0.646443, -0.118229, 0.847713, -0.517045, -0.118229, 0.786584, -0.571459, -0.233802, -0.065004, -0.916593, 0.394452, 0.074740, -0.924680, 0.373302, 0.002991, -0.966002, 0.258400, -0.228248, -0.963317, 0.141057, -0.381542, -0.913511, 0.141057, -0.296793, -0.913511, 0.278176, -0.603992, -0.704123, 0.373302, -0.486129, -0.779748, 0.394452, -0.570238, -0.779748, 0.258400, -0.381878, -0.916593, -0.118229, -0.229774, -0.966002, -0.118229, -0.300424, -0.924680, -0.233802, -0.891812, -0.221381, 0.394452, -0.856319, -0.356853, 0.373302, -0.917814, -0.301340, 0.258400, -0.986694, -0.080569, 0.141057, -0.986694, 0.080569, 0.141057, -0.960509, 0.000000, 0.278176, -0.856319, 0.356853, 0.373302, -0.891812, 0.221381, 0.394452, -0.917814, 0.301340, 0.258400, -0.989746, 0.079958, -0.118229, -0.989746, -0.079958, -0.118229, -0.972259, 0.000000, -0.233802, -0.486129, 0.779748, 0.394452, -0.603992, 0.704123, 0.373302, -0.570238, 0.779748, 0.258400, -0.381542, 0.913511, 0.141057, -0.228248, 0.963317, 0.141057, -0.296793, 0.913511, 0.278176, 0.074740, 0.924680, 0.373302, -0.065004, 0.916593, 0.394452, 0.002991, 0.966002, 0.258400, -0.229774, 0.966002, -0.118229, -0.381878, 0.916593, -0.118229, -0.300424, 0.924680, -0.233802, 0.591357, 0.703299, 0.394452, 0.483016, 0.792016, 0.373302, 0.565386, 0.783288, 0.258400, 0.750877, 0.645161, 0.141057, 0.845637, 0.514756, 0.141057, 0.777062, 0.564562, 0.278176, 0.902524, 0.214606, 0.373302, 0.851619, 0.345073, 0.394452, 0.919645, 0.295663, 0.258400, 0.847713, 0.517045, -0.118229, 0.753716, 0.646443, -0.118229, 0.786584, 0.571459, -0.233802, 0.341899, -0.620930, 0.705344, 0.370159, -0.710044, 0.598956, 0.477950, -0.620930, 0.621265, 0.548814, -0.398724, 0.734703, 0.506424, -0.268319, 0.819453, 0.411695, -0.398724, 0.819453, 0.182562, -0.132633, 0.974181, 0.225501, -0.262673, 0.938139, 0.319529, -0.133305, 0.938139, 0.696188, -0.133305, 0.705344, 0.738243, -0.262673, 0.621265, 0.789697, -0.132633, 0.598956, -0.484878, -0.517045, 0.705344, -0.560900, -0.571459, 0.598956, -0.442824, -0.646443, 0.621265, -0.209632, -0.645161, 0.734703, -0.098697, -0.564562, 0.819453, -0.251991, -0.514756, 0.819453, -0.069735, -0.214606, 0.974181, -0.180151, -0.295663, 0.938139, -0.028016, -0.345073, 0.938139, 0.088321, -0.703299, 0.705344, -0.021699, -0.783288, 0.621265, 0.117862, -0.792016, 0.598956, -0.641591, 0.301340, 0.705344, -0.716849, 0.356853, 0.598956, -0.751640, 0.221381, 0.621265, -0.678365, 0.000000, 0.734703, -0.567431, -0.080569, 0.819453, -0.567431, 0.080569, 0.819453, -0.225654, 0.000000, 0.974181, -0.336863, 0.079958, 0.938139, -0.336863, -0.079958, 0.938139, -0.641591, -0.301340, 0.705344, -0.751640, -0.221381, 0.621265, -0.716849, -0.356853, 0.598956, 0.088321, 0.703299, 0.705344, 0.117862, 0.792016, 0.598956, -0.021699, 0.783288, 0.621265, -0.209632, 0.645161, 0.734703, -0.251991, 0.514756, 0.819453, -0.098697, 0.564562, 0.819453, -0.069735, 0.214606, 0.974181, -0.028016, 0.345073, 0.938139, -0.180151, 0.295663, 0.938139, -0.484878, 0.517045, 0.705344, -0.442824, 0.646443, 0.621265, -0.560900, 0.571459, 0.598956, 0.696188, 0.133305, 0.705344, 0.789697, 0.132633, 0.598956, 0.738243, 0.262673, 0.621265, 0.548814, 0.398724, 0.734703, 0.411695, 0.398724, 0.819453, 0.506424, 0.268319, 0.819453, 0.182562, 0.132633, 0.974181, 0.319529, 0.133305, 0.938139, 0.225501, 0.262673, 0.938139, 0.341899, 0.620930, 0.705344, 0.477950, 0.620930, 0.621265, 0.370159, 0.710044, 0.598956, 0.999969, 0.000000, -0.006500, 0.987365, 0.158147, -0.006439, 0.951048, 0.309000, 0.000000, 0.987365, -0.158147, -0.006439, 0.951048, -0.309000, 0.000000, 0.309000, -0.951018, -0.006500, 0.455519, -0.890164, -0.006439, 0.587756, -0.809015, 0.000000, 0.154668, -0.987915, -0.006439, 0.000000, -1.000000, 0.000000, -0.808985, -0.587756, -0.006500, -0.705832, -0.708304, -0.006439, -0.587756, -0.809015, 0.000000, -0.891781, -0.452406, -0.006439, -0.951048, -0.309000, 0.000000, -0.808985, 0.587756, -0.006500, -0.891781, 0.452406, -0.006439, -0.951048, 0.309000, 0.000000, -0.705832, 0.708304, -0.006439, -0.587756, 0.809015, 0.000000, 0.309000, 0.951018, -0.006500, 0.154668, 0.987915, -0.006439, 0.000000, 1.000000, 0.000000, 0.455519, 0.890164, -0.006439, 0.587756, 0.809015, 0.000000, 0.705832, -0.708304, 0.006439, 0.808985, -0.587756, 0.006500, 0.891781, -0.452406, 0.006439, -0.455519, -0.890164, 0.006439, -0.309000, -0.951018, 0.006500, -0.154668, -0.987915, 0.006439, -0.987365, 0.158147, 0.006439, -0.999969, 0.000000, 0.006500, -0.987365, -0.158147, 0.006439, -0.154668, 0.987915, 0.006439, -0.309000, 0.951018, 0.006500, -0.455519, 0.890164, 0.006439, 0.891781, 0.452406, 0.006439, 0.808985, 0.587756, 0.006500, 0.705832, 0.708304, 0.006439};
-GLfloat ballTexture[] = {0.750218, 0.499411, 0.624379, 0.319463, 0.796906, 0.204453, 0.904902, 0.497067, 0.799137, 0.792914, 0.625764, 0.683162, 0.299122, 0.206817, 0.125614, 0.315826, 0.123847, 0.679510, 0.296227, 0.795270, 0.404557, 0.503166, 0.249874, 0.500118, 0.692377, 0.416699, 0.771677, 0.363833, 0.706061, 0.234465, 0.693012, 0.583872, 0.610584, 0.501536, 0.821320, 0.498333, 0.862561, 0.333556, 0.772703, 0.634322, 0.863804, 0.661839, 0.708079, 0.765662, 0.512372, 0.658280, 0.511182, 0.347806, 0.601174, 0.096069, 0.748462, -0.002107, 0.895962, 0.091306, 0.988147, 0.341104, 0.989316, 0.650492, 0.899035, 0.903043, 0.752266, 1.000907, 0.604263, 0.907218, 0.363646, 0.338196, 0.208024, 0.233669, 0.110244, 0.497393, 0.205427, 0.764851, 0.362026, 0.666479, 0.320975, 0.501515, 0.272509, 0.365304, 0.192760, 0.415406, 0.191943, 0.582575, 0.271181, 0.635788, 0.721872, 0.458877, 0.660440, 0.371029, 0.783526, 0.288976, 0.760734, 0.432968, 0.750316, 0.212447, 0.664051, 0.269953, 0.722183, 0.540802, 0.661427, 0.630506, 0.614480, 0.592406, 0.613786, 0.410556, 0.860578, 0.497738, 0.785063, 0.498883, 0.832706, 0.264617, 0.886704, 0.410925, 0.761237, 0.565527, 0.785118, 0.708809, 0.887358, 0.583749, 0.834475, 0.731674, 0.752493, 0.786333, 0.665807, 0.731457, 0.444517, 0.569183, 0.573983, 0.678542, 0.445164, 0.438743, 0.572635, 0.325662, 0.342870, 0.151201, 0.610575, 0.219533, 0.281031, 0.109659, 0.777974, 0.107947, 0.112677, 0.215428, 0.840159, 0.147326, 0.073823, 0.320232, 0.944939, 0.431238, 0.945432, 0.561676, 0.072117, 0.673097, 0.109940, 0.779366, 0.842816, 0.848721, 0.277186, 0.891677, 0.780939, 0.889978, 0.339410, 0.852592, 0.612723, 0.783494, 0.334395, 0.268223, 0.387113, 0.416399, 0.252466, 0.213191, 0.165711, 0.267696, 0.114234, 0.406539, 0.113352, 0.588382, 0.163462, 0.729184, 0.249651, 0.787064, 0.386259, 0.589224, 0.332093, 0.735277, 0.360232, 0.502290, 0.284718, 0.500802, 0.285008, 0.290867, 0.260966, 0.434050, 0.161223, 0.368635, 0.221884, 0.458603, 0.221483, 0.540527, 0.159960, 0.628103, 0.260316, 0.566606, 0.282945, 0.710694, 0.697027, 0.329466, 0.731533, 0.387300, 0.741788, 0.299627, 0.652609, 0.453712, 0.691132, 0.500309, 0.652968, 0.548073, 0.814595, 0.345725, 0.797756, 0.429227, 0.842615, 0.421643, 0.843194, 0.574368, 0.798283, 0.568145, 0.815752, 0.651126, 0.743306, 0.699426, 0.732386, 0.612076, 0.698324, 0.670950, 0.564031, 0.438440, 0.564519, 0.566044, 0.499315, 0.503238, 0.721685, 0.126419, 0.661151, 0.166770, 0.670878, 0.023328, 0.918762, 0.329888, 0.880873, 0.227222, 0.952082, 0.201405, 0.882919, 0.767603, 0.920026, 0.663805, 0.954313, 0.791261, 0.663691, 0.834709, 0.724520, 0.873215, 0.674504, 0.977827, 0.419874, 0.336489, 0.454313, 0.209180, 0.382884, 0.232511, 0.224584, 0.126174, 0.174674, 0.021327, 0.163705, 0.164422, 0.064245, 0.432697, -0.001019, 0.495247, 0.063629, 0.560295, 0.160450, 0.832337, 0.170015, 0.975791, 0.220927, 0.872950, 0.380214, 0.772893, 0.451389, 0.799045, 0.418222, 0.670409, 0.315580, 0.348692, 0.342935, 0.425578, 0.298016, 0.431598, 0.198166, 0.328347, 0.243182, 0.300065, 0.232166, 0.387372, 0.152217, 0.545392, 0.152676, 0.451034, 0.190789, 0.498961, 0.241223, 0.699856, 0.196498, 0.669821, 0.231065, 0.612143, 0.342183, 0.578302, 0.314076, 0.654090, 0.297333, 0.570514, 0.707342, 0.438099, 0.736119, 0.479250, 0.676807, 0.394434, 0.643048, 0.346159, 0.789979, 0.248210, 0.777454, 0.327338, 0.755449, 0.466363, 0.766125, 0.398910, 0.727905, 0.221777, 0.773315, 0.206607, 0.684780, 0.250524, 0.643899, 0.292878, 0.707813, 0.562019, 0.736273, 0.519999, 0.677614, 0.606607, 0.644227, 0.655902, 0.611646, 0.546977, 0.619154, 0.637820, 0.611299, 0.456067, 0.618114, 0.365003, 0.881956, 0.497414, 0.840459, 0.498043, 0.767550, 0.499148, 0.802924, 0.498612, 0.815578, 0.233368, 0.848349, 0.298040, 0.896588, 0.452863, 0.875343, 0.371182, 0.755699, 0.532298, 0.766886, 0.599417, 0.791879, 0.749373, 0.778756, 0.670636, 0.896924, 0.541517, 0.876300, 0.623831, 0.817587, 0.763437, 0.849863, 0.697781, 0.730015, 0.777685, 0.775533, 0.791476, 0.686679, 0.750252, 0.645483, 0.709149, 0.424184, 0.533761, 0.465646, 0.610597, 0.600882, 0.682353, 0.544644, 0.670902, 0.424483, 0.473353, 0.466700, 0.398173, 0.543357, 0.334197, 0.599504, 0.321030, 0.319739, 0.178935, 0.369097, 0.123806, 0.605143, 0.161362, 0.617074, 0.271881, 0.291100, 0.159698, 0.268390, 0.056151, 0.764871, 0.054891, 0.788476, 0.157623, 0.107748, 0.157075, 0.118722, 0.267996, 0.866142, 0.119025, 0.817275, 0.175860, 0.044475, 0.327754, 0.100729, 0.316531, 0.966116, 0.389924, 0.924564, 0.466563, 0.966919, 0.602345, 0.924793, 0.526971, 0.042852, 0.664443, 0.098977, 0.677839, 0.116493, 0.727055, 0.104447, 0.837502, 0.819720, 0.820885, 0.869009, 0.876232, 0.287745, 0.842056, 0.264025, 0.944663, 0.791063, 0.839992, 0.768241, 0.943422, 0.316561, 0.823955, 0.365356, 0.881013, 0.607735, 0.841818, 0.618823, 0.730958, 0.317541, 0.236380, 0.349745, 0.302188, 0.396630, 0.458677, 0.376099, 0.376264, 0.275514, 0.208150, 0.229976, 0.221741, 0.145362, 0.289919, 0.186606, 0.248988, 0.111353, 0.451957, 0.118956, 0.361143, 0.110912, 0.542863, 0.117632, 0.633949, 0.184166, 0.748700, 0.143337, 0.706175, 0.227253, 0.777635, 0.272641, 0.793009, 0.374852, 0.628914, 0.396191, 0.547331, 0.347774, 0.701928, 0.314931, 0.766444, 0.340114, 0.501893, 0.381610, 0.502712, 0.302579, 0.501153, 0.267206, 0.500458, 0.278602, 0.329014, 0.291815, 0.250330, 0.266652, 0.400184, 0.255391, 0.467256, 0.177385, 0.392604, 0.144049, 0.343165, 0.207537, 0.437323, 0.235952, 0.479468, 0.206931, 0.561241, 0.235752, 0.520217, 0.176350, 0.604771, 0.142543, 0.652896, 0.265668, 0.600687, 0.255068, 0.533189, 0.276916, 0.672307, 0.289351, 0.751485, 0.700896, 0.283237, 0.694234, 0.373773, 0.711933, 0.401181, 0.751377, 0.374885, 0.724824, 0.267286, 0.757313, 0.331721, 0.631988, 0.475987, 0.672668, 0.434098, 0.691676, 0.541879, 0.691360, 0.458727, 0.673174, 0.567074, 0.632180, 0.526429, 0.792663, 0.354103, 0.837773, 0.338801, 0.809792, 0.463136, 0.785099, 0.396236, 0.832151, 0.461090, 0.852752, 0.379384, 0.832432, 0.535243, 0.853649, 0.616314, 0.810060, 0.533875, 0.785878, 0.601516, 0.793760, 0.643413, 0.838980, 0.657346, 0.726590, 0.732277, 0.758585, 0.666865, 0.712684, 0.598793, 0.752322, 0.623887, 0.695196, 0.626735, 0.702544, 0.717055, 0.587964, 0.472578, 0.538518, 0.397576, 0.588188, 0.531180, 0.539322, 0.607682, 0.502157, 0.424523, 0.502761, 0.581854, 0.712844, 0.182490, 0.733237, 0.065265, 0.685044, 0.201022, 0.633564, 0.131703, 0.634552, 0.054170, 0.709191, 0.004420, 0.951409, 0.332964, 0.889370, 0.330398, 0.889025, 0.163920, 0.871969, 0.283248, 0.926195, 0.141846, 0.972909, 0.268431, 0.891549, 0.830650, 0.873592, 0.711855, 0.952645, 0.659742, 0.890633, 0.664185, 0.974630, 0.723614, 0.928880, 0.851594, 0.687320, 0.799737, 0.636376, 0.870607, 0.715255, 0.817422, 0.736533, 0.934009, 0.637952, 0.948093, 0.712953, 0.995570, 0.452492, 0.340705, 0.390480, 0.335973, 0.428947, 0.148722, 0.474553, 0.276929, 0.391587, 0.169497, 0.373492, 0.288221, 0.236667, 0.065425, 0.215257, 0.181935, 0.138084, 0.050909, 0.213150, 0.003748, 0.136425, 0.128402, 0.187299, 0.199500, 0.039089, 0.390957, 0.087879, 0.467657, 0.002501, 0.416644, 0.001747, 0.573967, 0.087595, 0.526257, 0.038077, 0.601053, 0.184376, 0.798196, 0.132830, 0.867277, 0.133733, 0.944795, 0.208298, 0.994868, 0.212151, 0.816848, 0.232408, 0.934146, 0.371375, 0.716828, 0.388290, 0.836230, 0.425432, 0.858478, 0.472295, 0.732121, 0.388830, 0.669762, 0.450872, 0.667487, 0.293578, 0.356306, 0.338816, 0.342576, 0.332129, 0.464655, 0.353439, 0.383678, 0.285648, 0.398170, 0.309755, 0.465922, 0.194990, 0.372551, 0.202436, 0.282257, 0.258426, 0.332697, 0.226501, 0.267138, 0.252115, 0.375649, 0.212448, 0.400570, 0.172255, 0.565091, 0.131621, 0.523031, 0.172903, 0.432119, 0.131866, 0.472590, 0.191378, 0.457394, 0.190972, 0.540543, 0.256782, 0.667833, 0.224224, 0.732118, 0.193754, 0.625506, 0.200316, 0.716062, 0.211481, 0.598177, 0.250894, 0.624645, 0.331764, 0.538808, 0.352270, 0.620607, 0.292155, 0.645612, 0.337246, 0.661120, 0.284639, 0.603447, 0.309406, 0.536660, 0.681217, 0.300460, 0.661437, 0.321744, 0.678565, 0.349044, 0.714836, 0.358720, 0.736316, 0.344400, 0.719168, 0.313109, 0.767944, 0.250743, 0.745735, 0.257450, 0.762431, 0.293136, 0.746371, 0.410059, 0.726490, 0.423313, 0.741243, 0.445560, 0.633772, 0.433173, 0.637444, 0.388857, 0.655901, 0.412442, 0.672209, 0.477955, 0.672382, 0.523237, 0.652031, 0.500904, 0.638299, 0.613381, 0.634290, 0.569183, 0.656573, 0.589238, 0.706699, 0.521029, 0.706539, 0.479118, 0.721837, 0.499843, 0.823503, 0.306691, 0.807271, 0.275644, 0.799581, 0.316659, 0.806187, 0.388638, 0.819634, 0.425070, 0.829214, 0.382785, 0.873942, 0.456286, 0.863890, 0.416118, 0.852080, 0.458900, 0.791519, 0.464483, 0.779073, 0.430763, 0.773052, 0.465699, 0.864508, 0.579248, 0.874254, 0.538780, 0.852375, 0.536829, 0.820189, 0.571638, 0.807021, 0.608473, 0.830089, 0.613627, 0.808960, 0.721418, 0.824955, 0.689884, 0.800961, 0.680643, 0.779590, 0.567176, 0.791779, 0.533082, 0.773305, 0.532427, 0.747572, 0.741477, 0.769828, 0.747508, 0.763994, 0.705289, 0.737495, 0.654825, 0.715909, 0.641160, 0.720587, 0.686632, 0.662799, 0.679754, 0.682737, 0.700433, 0.679717, 0.651936, 0.727071, 0.576221, 0.747050, 0.588870, 0.741653, 0.553529, 0.566756, 0.382060, 0.593786, 0.371154, 0.589792, 0.422787, 0.562308, 0.502273, 0.533377, 0.538960, 0.533100, 0.466475, 0.446894, 0.504004, 0.471977, 0.468168, 0.471616, 0.540828, 0.567674, 0.622333, 0.590395, 0.580909, 0.594782, 0.632412, 0.749338, 0.114185, 0.762874, 0.162231, 0.737087, 0.170584, 0.690796, 0.142861, 0.664411, 0.099161, 0.698798, 0.076240, 0.312604, 0.126535, 0.303312, 0.067742, 0.337759, 0.090884, 0.635357, 0.190163, 0.662077, 0.220586, 0.638940, 0.244846, 0.933124, 0.378702, 0.914462, 0.419293, 0.902522, 0.372828, 0.901401, 0.276219, 0.914027, 0.212534, 0.935550, 0.270854, 0.091599, 0.265383, 0.060770, 0.264905, 0.082413, 0.206523, 0.861781, 0.185389, 0.855570, 0.245609, 0.836886, 0.209097, 0.864146, 0.810009, 0.839076, 0.787058, 0.857480, 0.749985, 0.903073, 0.717992, 0.937258, 0.722323, 0.916180, 0.781285, 0.089356, 0.728613, 0.079603, 0.787093, 0.058534, 0.727899, 0.934016, 0.614562, 0.903462, 0.621362, 0.915049, 0.574542, 0.637724, 0.812104, 0.640891, 0.757323, 0.664208, 0.780875, 0.693512, 0.857713, 0.702017, 0.924079, 0.667463, 0.902206, 0.308913, 0.876053, 0.333705, 0.912683, 0.299045, 0.934454, 0.752261, 0.884609, 0.739584, 0.828590, 0.765430, 0.836160, 0.403261, 0.378858, 0.414794, 0.425735, 0.433809, 0.385800, 0.437176, 0.278046, 0.416164, 0.218980, 0.402983, 0.282220, 0.339059, 0.212854, 0.357423, 0.250014, 0.364158, 0.190015, 0.580240, 0.211676, 0.559106, 0.270795, 0.589934, 0.270208, 0.239602, 0.170871, 0.265460, 0.163415, 0.252342, 0.114902, 0.202134, 0.075204, 0.167550, 0.096931, 0.193555, 0.141544, 0.140820, 0.241721, 0.164165, 0.218265, 0.137711, 0.186920, 0.834525, 0.087202, 0.799885, 0.065265, 0.809687, 0.123720, 0.090137, 0.417937, 0.094577, 0.366450, 0.067457, 0.376420, 0.033076, 0.459657, 0.032727, 0.532139, 0.061970, 0.496459, 0.093312, 0.627697, 0.089371, 0.576053, 0.066296, 0.616681, 0.972278, 0.532379, 0.972004, 0.459720, 0.947239, 0.496426, 0.161434, 0.778535, 0.138327, 0.754179, 0.134686, 0.808836, 0.163634, 0.899947, 0.197988, 0.923016, 0.190063, 0.856372, 0.262151, 0.837331, 0.236377, 0.828862, 0.248562, 0.885308, 0.803170, 0.931989, 0.837638, 0.909007, 0.812527, 0.873247, 0.354934, 0.754389, 0.336209, 0.790811, 0.361074, 0.814634, 0.413349, 0.787736, 0.434939, 0.729521, 0.400798, 0.723995, 0.414026, 0.580985, 0.402032, 0.627394, 0.432640, 0.621663, 0.560874, 0.733811, 0.582455, 0.792273, 0.591701, 0.733458, 0.300820, 0.319106, 0.308866, 0.278363, 0.324827, 0.309972, 0.329875, 0.386257, 0.319927, 0.428203, 0.306799, 0.391308, 0.272998, 0.467205, 0.279322, 0.432483, 0.291472, 0.466632, 0.352074, 0.463160, 0.364256, 0.420795, 0.373956, 0.461309, 0.179537, 0.347282, 0.162647, 0.319390, 0.182609, 0.298795, 0.220447, 0.312761, 0.237321, 0.344644, 0.215719, 0.358215, 0.241368, 0.445962, 0.226811, 0.423205, 0.246804, 0.410644, 0.263879, 0.294294, 0.247495, 0.258030, 0.269760, 0.252096, 0.155465, 0.586674, 0.136985, 0.610179, 0.133359, 0.565850, 0.151690, 0.498199, 0.172064, 0.475953, 0.171843, 0.521234, 0.221493, 0.499562, 0.206173, 0.520219, 0.206378, 0.478309, 0.156326, 0.409884, 0.134020, 0.429846, 0.138076, 0.385663, 0.261856, 0.706438, 0.267321, 0.748852, 0.245122, 0.742046, 0.218619, 0.686274, 0.214338, 0.640648, 0.235801, 0.655061, 0.240839, 0.553928, 0.245928, 0.589451, 0.226062, 0.576110, 0.178059, 0.650164, 0.180658, 0.698755, 0.160903, 0.677388, 0.351690, 0.541089, 0.373549, 0.543803, 0.363451, 0.583925, 0.328737, 0.617098, 0.305718, 0.611140, 0.319205, 0.574771, 0.272670, 0.533932, 0.291135, 0.535230, 0.278652, 0.568894, 0.299030, 0.683086, 0.322939, 0.693163, 0.306672, 0.724133, 0.500447, 0.505068, 0.497041, 0.583218, 0.487619, 0.659522, 0.497818, 0.426795, 0.489155, 0.350127, 0.329661, 0.024982, 0.365779, 0.055617, 0.399157, 0.097130, 0.291620, 0.005793, 0.252476, -0.001416, 0.048571, 0.201578, 0.074293, 0.142329, 0.104345, 0.091649, 0.027700, 0.268018, 0.012187, 0.340250, 0.045728, 0.790727, 0.025507, 0.723509, 0.010695, 0.650708, 0.070865, 0.850942, 0.100409, 0.902763, 0.324960, 0.978236, 0.286747, 0.995912, 0.247553, 1.001574, 0.361365, 0.949044, 0.395141, 0.908870, 0.571567, 0.147777, 0.546362, 0.207902, 0.526069, 0.275051, 0.862230, 0.050968, 0.825856, 0.021599, 0.787658, 0.003739, 0.998069, 0.573871, 1.000791, 0.495617, 0.997478, 0.417452, 0.791410, 0.993875, 0.829467, 0.974862, 0.865614, 0.944396, 0.527812, 0.730564, 0.548613, 0.797079, 0.574270, 0.856423};
-GLushort ballIndices[] = {402, 282, 102, 282, 402, 172, 47, 172, 402, 172, 14, 282, 402, 403, 47, 403, 402, 404, 102, 404, 402, 404, 43, 403, 164, 283, 12, 283, 164, 404, 43, 404, 164, 404, 102, 283, 165, 403, 43, 403, 165, 173, 1, 173, 165, 173, 47, 403, 405, 283, 102, 283, 405, 284, 103, 284, 405, 284, 12, 283, 405, 406, 103, 406, 405, 407, 102, 407, 405, 407, 104, 406, 286, 282, 14, 282, 286, 407, 104, 407, 286, 407, 102, 282, 287, 406, 104, 406, 287, 285, 13, 285, 287, 285, 103, 406, 408, 166, 44, 166, 408, 171, 46, 171, 408, 171, 2, 166, 408, 409, 46, 409, 408, 410, 44, 410, 408, 410, 104, 409, 287, 167, 13, 167, 287, 410, 104, 410, 287, 410, 44, 167, 286, 409, 104, 409, 286, 170, 14, 170, 286, 170, 46, 409, 411, 169, 45, 169, 411, 285, 103, 285, 411, 285, 13, 169, 411, 412, 103, 412, 411, 413, 45, 413, 411, 413, 42, 412, 168, 0, 163, 168, 163, 413, 42, 413, 163, 413, 45, 168, 162, 412, 42, 412, 162, 284, 12, 284, 162, 284, 103, 412, 414, 105, 288, 288, 180, 414, 51, 414, 180, 180, 288, 16, 414, 51, 415, 415, 416, 414, 105, 414, 416, 416, 415, 43, 164, 12, 289, 289, 416, 164, 43, 164, 416, 416, 289, 105, 165, 43, 415, 415, 181, 165, 1, 165, 181, 181, 415, 51, 417, 105, 289, 289, 291, 417, 106, 417, 291, 291, 289, 12, 417, 106, 418, 418, 419, 417, 105, 417, 419, 419, 418, 107, 293, 16, 288, 288, 419, 293, 107, 293, 419, 419, 288, 105, 292, 107, 418, 418, 290, 292, 15, 292, 290, 290, 418, 106, 420, 49, 177, 177, 179, 420, 50, 420, 179, 179, 177, 5, 420, 50, 421, 421, 422, 420, 49, 420, 422, 422, 421, 107, 292, 15, 176, 176, 422, 292, 107, 292, 422, 422, 176, 49, 293, 107, 421, 421, 178, 293, 16, 293, 178, 178, 421, 50, 423, 48, 174, 174, 290, 423, 106, 423, 290, 290, 174, 15, 423, 106, 424, 424, 425, 423, 48, 423, 425, 425, 424, 42, 163, 0, 175, 175, 425, 163, 42, 163, 425, 425, 175, 48, 162, 42, 424, 424, 291, 162, 12, 162, 291, 291, 424, 106, 426, 295, 108, 295, 426, 187, 54, 187, 426, 187, 18, 295, 426, 427, 54, 427, 426, 428, 108, 428, 426, 428, 44, 427, 167, 294, 13, 294, 167, 428, 44, 428, 167, 428, 108, 294, 166, 427, 44, 427, 166, 186, 2, 186, 166, 186, 54, 427, 429, 294, 108, 294, 429, 297, 109, 297, 429, 297, 13, 294, 429, 430, 109, 430, 429, 431, 108, 431, 429, 431, 110, 430, 299, 295, 18, 295, 299, 431, 110, 431, 299, 431, 108, 295, 298, 430, 110, 430, 298, 296, 17, 296, 298, 296, 109, 430, 432, 182, 52, 182, 432, 188, 55, 188, 432, 188, 3, 182, 432, 433, 55, 433, 432, 434, 52, 434, 432, 434, 110, 433, 298, 183, 17, 183, 298, 434, 110, 434, 298, 434, 52, 183, 299, 433, 110, 433, 299, 189, 18, 189, 299, 189, 55, 433, 435, 185, 53, 185, 435, 296, 109, 296, 435, 296, 17, 185, 435, 436, 109, 436, 435, 437, 53, 437, 435, 437, 45, 436, 184, 0, 168, 184, 168, 437, 45, 437, 168, 437, 53, 184, 169, 436, 45, 436, 169, 297, 13, 297, 169, 297, 109, 436, 438, 301, 111, 301, 438, 195, 58, 195, 438, 195, 20, 301, 438, 439, 58, 439, 438, 440, 111, 440, 438, 440, 52, 439, 183, 300, 17, 300, 183, 440, 52, 440, 183, 440, 111, 300, 182, 439, 52, 439, 182, 194, 3, 194, 182, 194, 58, 439, 441, 300, 111, 300, 441, 302, 112, 302, 441, 302, 17, 300, 441, 442, 112, 442, 441, 443, 111, 443, 441, 443, 113, 442, 305, 301, 20, 301, 305, 443, 113, 443, 305, 443, 111, 301, 304, 442, 113, 442, 304, 303, 19, 303, 304, 303, 112, 442, 444, 192, 57, 192, 444, 196, 59, 196, 444, 196, 4, 192, 444, 445, 59, 445, 444, 446, 57, 446, 444, 446, 113, 445, 304, 193, 19, 193, 304, 446, 113, 446, 304, 446, 57, 193, 305, 445, 113, 445, 305, 197, 20, 197, 305, 197, 59, 445, 447, 191, 56, 191, 447, 303, 112, 303, 447, 303, 19, 191, 447, 448, 112, 448, 447, 449, 56, 449, 447, 449, 53, 448, 190, 0, 184, 190, 184, 449, 53, 449, 184, 449, 56, 190, 185, 448, 53, 448, 185, 302, 17, 302, 185, 302, 112, 448, 450, 306, 114, 306, 450, 198, 60, 198, 450, 198, 21, 306, 450, 451, 60, 451, 450, 452, 114, 452, 450, 452, 57, 451, 193, 307, 19, 307, 193, 452, 57, 452, 193, 452, 114, 307, 192, 451, 57, 451, 192, 199, 4, 199, 192, 199, 60, 451, 453, 307, 114, 307, 453, 309, 115, 309, 453, 309, 19, 307, 453, 454, 115, 454, 453, 455, 114, 455, 453, 455, 116, 454, 311, 306, 21, 306, 311, 455, 116, 455, 311, 455, 114, 306, 310, 454, 116, 454, 310, 308, 15, 308, 310, 308, 115, 454, 456, 177, 49, 177, 456, 201, 61, 201, 456, 201, 5, 177, 456, 457, 61, 457, 456, 458, 49, 458, 456, 458, 116, 457, 310, 176, 15, 176, 310, 458, 116, 458, 310, 458, 49, 176, 311, 457, 116, 457, 311, 200, 21, 200, 311, 200, 61, 457, 459, 174, 48, 174, 459, 308, 115, 308, 459, 308, 15, 174, 459, 460, 115, 460, 459, 461, 48, 461, 459, 461, 56, 460, 175, 0, 190, 175, 190, 461, 56, 461, 190, 461, 48, 175, 191, 460, 56, 460, 191, 309, 19, 309, 191, 309, 115, 460, 462, 117, 313, 313, 208, 462, 65, 462, 208, 208, 313, 23, 462, 65, 463, 463, 464, 462, 117, 462, 464, 464, 463, 51, 180, 16, 312, 312, 464, 180, 51, 180, 464, 464, 312, 117, 181, 51, 463, 463, 209, 181, 1, 181, 209, 209, 463, 65, 465, 117, 312, 312, 314, 465, 118, 465, 314, 314, 312, 16, 465, 118, 466, 466, 467, 465, 117, 465, 467, 467, 466, 119, 316, 23, 313, 313, 467, 316, 119, 316, 467, 467, 313, 117, 317, 119, 466, 466, 315, 317, 22, 317, 315, 315, 466, 118, 468, 62, 202, 202, 206, 468, 64, 468, 206, 206, 202, 10, 468, 64, 469, 469, 470, 468, 62, 468, 470, 470, 469, 642, 643, 644, 203, 203, 470, 643, 642, 643, 470, 470, 203, 62, 645, 642, 469, 469, 207, 645, 646, 645, 207, 207, 469, 64, 471, 63, 205, 205, 315, 471, 118, 471, 315, 315, 205, 22, 471, 118, 472, 472, 473, 471, 63, 471, 473, 473, 472, 50, 179, 5, 204, 204, 473, 179, 50, 179, 473, 473, 204, 63, 178, 50, 472, 472, 314, 178, 16, 178, 314, 314, 472, 118, 474, 120, 319, 319, 216, 474, 69, 474, 216, 216, 319, 25, 474, 69, 475, 475, 476, 474, 120, 474, 476, 476, 475, 46, 170, 14, 318, 318, 476, 170, 46, 170, 476, 476, 318, 120, 171, 46, 475, 475, 217, 171, 2, 171, 217, 217, 475, 69, 477, 120, 318, 318, 320, 477, 121, 477, 320, 320, 318, 14, 477, 121, 478, 478, 479, 477, 120, 477, 479, 479, 478, 122, 323, 25, 319, 319, 479, 323, 122, 323, 479, 479, 319, 120, 322, 122, 478, 478, 321, 322, 24, 322, 321, 321, 478, 121, 480, 66, 210, 210, 214, 480, 68, 480, 214, 214, 210, 6, 480, 68, 481, 481, 482, 480, 66, 480, 482, 482, 481, 647, 648, 649, 211, 211, 482, 648, 647, 648, 482, 482, 211, 66, 650, 647, 481, 481, 215, 650, 651, 650, 215, 215, 481, 68, 483, 67, 212, 212, 321, 483, 121, 483, 321, 321, 212, 24, 483, 121, 484, 484, 485, 483, 67, 483, 485, 485, 484, 47, 173, 1, 213, 213, 485, 173, 47, 173, 485, 485, 213, 67, 172, 47, 484, 484, 320, 172, 14, 172, 320, 320, 484, 121, 486, 123, 324, 324, 224, 486, 73, 486, 224, 224, 324, 27, 486, 73, 487, 487, 488, 486, 123, 486, 488, 488, 487, 55, 189, 18, 325, 325, 488, 189, 55, 189, 488, 488, 325, 123, 188, 55, 487, 487, 225, 188, 3, 188, 225, 225, 487, 73, 489, 123, 325, 325, 327, 489, 124, 489, 327, 327, 325, 18, 489, 124, 490, 490, 491, 489, 123, 489, 491, 491, 490, 125, 329, 27, 324, 324, 491, 329, 125, 329, 491, 491, 324, 123, 328, 125, 490, 490, 326, 328, 26, 328, 326, 326, 490, 124, 492, 70, 219, 219, 223, 492, 72, 492, 223, 223, 219, 7, 492, 72, 493, 493, 494, 492, 70, 492, 494, 494, 493, 652, 653, 654, 218, 218, 494, 653, 652, 653, 494, 494, 218, 70, 655, 652, 493, 493, 222, 655, 656, 655, 222, 222, 493, 72, 495, 71, 220, 220, 326, 495, 124, 495, 326, 326, 220, 26, 495, 124, 496, 496, 497, 495, 71, 495, 497, 497, 496, 54, 186, 2, 221, 221, 497, 186, 54, 186, 497, 497, 221, 71, 187, 54, 496, 496, 327, 187, 18, 187, 327, 327, 496, 124, 498, 126, 330, 330, 233, 498, 77, 498, 233, 233, 330, 29, 498, 77, 499, 499, 500, 498, 126, 498, 500, 500, 499, 59, 197, 20, 331, 331, 500, 197, 59, 197, 500, 500, 331, 126, 196, 59, 499, 499, 232, 196, 4, 196, 232, 232, 499, 77, 501, 126, 331, 331, 333, 501, 127, 501, 333, 333, 331, 20, 501, 127, 502, 502, 503, 501, 126, 501, 503, 503, 502, 128, 335, 29, 330, 330, 503, 335, 128, 335, 503, 503, 330, 126, 334, 128, 502, 502, 332, 334, 28, 334, 332, 332, 502, 127, 504, 75, 229, 229, 230, 504, 76, 504, 230, 230, 229, 8, 504, 76, 505, 505, 506, 504, 75, 504, 506, 506, 505, 657, 658, 659, 228, 228, 506, 658, 657, 658, 506, 506, 228, 75, 660, 657, 505, 505, 231, 660, 661, 660, 231, 231, 505, 76, 507, 74, 226, 226, 332, 507, 127, 507, 332, 332, 226, 28, 507, 127, 508, 508, 509, 507, 74, 507, 509, 509, 508, 58, 194, 3, 227, 227, 509, 194, 58, 194, 509, 509, 227, 74, 195, 58, 508, 508, 333, 195, 20, 195, 333, 333, 508, 127, 510, 129, 337, 337, 240, 510, 81, 510, 240, 240, 337, 31, 510, 81, 511, 511, 512, 510, 129, 510, 512, 512, 511, 61, 200, 21, 336, 336, 512, 200, 61, 200, 512, 512, 336, 129, 201, 61, 511, 511, 241, 201, 5, 201, 241, 241, 511, 81, 513, 129, 336, 336, 338, 513, 130, 513, 338, 338, 336, 21, 513, 130, 514, 514, 515, 513, 129, 513, 515, 515, 514, 131, 340, 31, 337, 337, 515, 340, 131, 340, 515, 515, 337, 129, 341, 131, 514, 514, 339, 341, 30, 341, 339, 339, 514, 130, 516, 78, 234, 234, 238, 516, 80, 516, 238, 238, 234, 9, 516, 80, 517, 517, 518, 516, 78, 516, 518, 518, 517, 662, 663, 664, 235, 235, 518, 663, 662, 663, 518, 518, 235, 78, 665, 662, 517, 517, 239, 665, 666, 665, 239, 239, 517, 80, 519, 79, 237, 237, 339, 519, 130, 519, 339, 339, 237, 30, 519, 130, 520, 520, 521, 519, 79, 519, 521, 521, 520, 60, 199, 4, 236, 236, 521, 199, 60, 199, 521, 521, 236, 79, 198, 60, 520, 520, 338, 198, 21, 198, 338, 338, 520, 130, 522, 343, 132, 343, 522, 245, 83, 245, 522, 245, 32, 343, 522, 523, 83, 523, 522, 524, 132, 524, 522, 524, 64, 523, 207, 342, 646, 342, 207, 524, 64, 524, 207, 524, 132, 342, 206, 523, 64, 523, 206, 244, 10, 244, 206, 244, 83, 523, 525, 342, 132, 342, 525, 345, 133, 345, 525, 345, 646, 342, 525, 526, 133, 526, 525, 527, 132, 527, 525, 527, 134, 526, 347, 343, 32, 343, 347, 527, 134, 527, 347, 527, 132, 343, 346, 526, 134, 526, 346, 344, 649, 344, 346, 344, 133, 526, 528, 210, 66, 210, 528, 242, 82, 242, 528, 242, 6, 210, 528, 529, 82, 529, 528, 530, 66, 530, 528, 530, 134, 529, 346, 211, 649, 211, 346, 530, 134, 530, 346, 530, 66, 211, 347, 529, 134, 529, 347, 243, 32, 243, 347, 243, 82, 529, 531, 212, 67, 212, 531, 667, 668, 667, 531, 667, 24, 212, 531, 532, 668, 532, 531, 533, 67, 533, 531, 533, 65, 532, 209, 213, 1, 213, 209, 533, 65, 533, 209, 533, 67, 213, 208, 532, 65, 532, 208, 669, 23, 669, 208, 669, 668, 532, 534, 349, 135, 349, 534, 247, 84, 247, 534, 247, 33, 349, 534, 535, 84, 535, 534, 536, 135, 536, 534, 536, 68, 535, 215, 348, 651, 348, 215, 536, 68, 536, 215, 536, 135, 348, 214, 535, 68, 535, 214, 246, 6, 246, 214, 246, 84, 535, 537, 348, 135, 348, 537, 351, 136, 351, 537, 351, 651, 348, 537, 538, 136, 538, 537, 539, 135, 539, 537, 539, 137, 538, 353, 349, 33, 349, 353, 539, 137, 539, 353, 539, 135, 349, 352, 538, 137, 538, 352, 350, 654, 350, 352, 350, 136, 538, 540, 219, 70, 219, 540, 248, 85, 248, 540, 248, 7, 219, 540, 541, 85, 541, 540, 542, 70, 542, 540, 542, 137, 541, 352, 218, 654, 218, 352, 542, 137, 542, 352, 542, 70, 218, 353, 541, 137, 541, 353, 249, 33, 249, 353, 249, 85, 541, 543, 220, 71, 220, 543, 670, 671, 670, 543, 670, 26, 220, 543, 544, 671, 544, 543, 545, 71, 545, 543, 545, 69, 544, 217, 221, 2, 221, 217, 545, 69, 545, 217, 545, 71, 221, 216, 544, 69, 544, 216, 672, 25, 672, 216, 672, 671, 544, 546, 355, 138, 355, 546, 250, 86, 250, 546, 250, 34, 355, 546, 547, 86, 547, 546, 548, 138, 548, 546, 548, 72, 547, 222, 354, 656, 354, 222, 548, 72, 548, 222, 548, 138, 354, 223, 547, 72, 547, 223, 251, 7, 251, 223, 251, 86, 547, 549, 354, 138, 354, 549, 356, 139, 356, 549, 356, 656, 354, 549, 550, 139, 550, 549, 551, 138, 551, 549, 551, 140, 550, 358, 355, 34, 355, 358, 551, 140, 551, 358, 551, 138, 355, 359, 550, 140, 550, 359, 357, 659, 357, 359, 357, 139, 550, 552, 229, 75, 229, 552, 253, 87, 253, 552, 253, 8, 229, 552, 553, 87, 553, 552, 554, 75, 554, 552, 554, 140, 553, 359, 228, 659, 228, 359, 554, 140, 554, 359, 554, 75, 228, 358, 553, 140, 553, 358, 252, 34, 252, 358, 252, 87, 553, 555, 226, 74, 226, 555, 673, 674, 673, 555, 673, 28, 226, 555, 556, 674, 556, 555, 557, 74, 557, 555, 557, 73, 556, 225, 227, 3, 227, 225, 557, 73, 557, 225, 557, 74, 227, 224, 556, 73, 556, 224, 675, 27, 675, 224, 675, 674, 556, 558, 360, 141, 360, 558, 254, 88, 254, 558, 254, 35, 360, 558, 559, 88, 559, 558, 560, 141, 560, 558, 560, 76, 559, 231, 361, 661, 361, 231, 560, 76, 560, 231, 560, 141, 361, 230, 559, 76, 559, 230, 255, 8, 255, 230, 255, 88, 559, 561, 361, 141, 361, 561, 362, 142, 362, 561, 362, 661, 361, 561, 562, 142, 562, 561, 563, 141, 563, 561, 563, 143, 562, 364, 360, 35, 360, 364, 563, 143, 563, 364, 563, 141, 360, 365, 562, 143, 562, 365, 363, 664, 363, 365, 363, 142, 562, 564, 234, 78, 234, 564, 257, 89, 257, 564, 257, 9, 234, 564, 565, 89, 565, 564, 566, 78, 566, 564, 566, 143, 565, 365, 235, 664, 235, 365, 566, 143, 566, 365, 566, 78, 235, 364, 565, 143, 565, 364, 256, 35, 256, 364, 256, 89, 565, 567, 237, 79, 237, 567, 676, 677, 676, 567, 676, 30, 237, 567, 568, 677, 568, 567, 569, 79, 569, 567, 569, 77, 568, 232, 236, 4, 236, 232, 569, 77, 569, 232, 569, 79, 236, 233, 568, 77, 568, 233, 678, 29, 678, 233, 678, 677, 568, 570, 366, 144, 366, 570, 260, 91, 260, 570, 260, 36, 366, 570, 571, 91, 571, 570, 572, 144, 572, 570, 572, 80, 571, 239, 367, 666, 367, 239, 572, 80, 572, 239, 572, 144, 367, 238, 571, 80, 571, 238, 261, 9, 261, 238, 261, 91, 571, 573, 367, 144, 367, 573, 368, 145, 368, 573, 368, 666, 367, 573, 574, 145, 574, 573, 575, 144, 575, 573, 575, 146, 574, 370, 366, 36, 366, 370, 575, 146, 575, 370, 575, 144, 366, 371, 574, 146, 574, 371, 369, 644, 369, 371, 369, 145, 574, 576, 202, 62, 202, 576, 259, 90, 259, 576, 259, 10, 202, 576, 577, 90, 577, 576, 578, 62, 578, 576, 578, 146, 577, 371, 203, 644, 203, 371, 578, 146, 578, 371, 578, 62, 203, 370, 577, 146, 577, 370, 258, 36, 258, 370, 258, 90, 577, 579, 205, 63, 205, 579, 679, 680, 679, 579, 679, 22, 205, 579, 580, 680, 580, 579, 581, 63, 581, 579, 581, 81, 580, 241, 204, 5, 204, 241, 581, 81, 581, 241, 581, 63, 204, 240, 580, 81, 580, 240, 681, 31, 681, 240, 681, 680, 580, 582, 147, 372, 372, 266, 582, 94, 582, 266, 266, 372, 38, 582, 94, 583, 583, 584, 582, 147, 582, 584, 584, 583, 82, 243, 32, 373, 373, 584, 243, 82, 243, 584, 584, 373, 147, 242, 82, 583, 583, 267, 242, 6, 242, 267, 267, 583, 94, 585, 147, 373, 373, 375, 585, 148, 585, 375, 375, 373, 32, 585, 148, 586, 586, 587, 585, 147, 585, 587, 587, 586, 149, 376, 38, 372, 372, 587, 376, 149, 376, 587, 587, 372, 147, 377, 149, 586, 586, 374, 377, 37, 377, 374, 374, 586, 148, 588, 93, 265, 265, 269, 588, 95, 588, 269, 269, 265, 11, 588, 95, 589, 589, 590, 588, 93, 588, 590, 590, 589, 149, 377, 37, 264, 264, 590, 377, 149, 377, 590, 590, 264, 93, 376, 149, 589, 589, 268, 376, 38, 376, 268, 268, 589, 95, 591, 92, 262, 262, 374, 591, 148, 591, 374, 374, 262, 37, 591, 148, 592, 592, 593, 591, 92, 591, 593, 593, 592, 83, 244, 10, 263, 263, 593, 244, 83, 244, 593, 593, 263, 92, 245, 83, 592, 592, 375, 245, 32, 245, 375, 375, 592, 148, 594, 150, 378, 378, 270, 594, 96, 594, 270, 270, 378, 39, 594, 96, 595, 595, 596, 594, 150, 594, 596, 596, 595, 85, 249, 33, 379, 379, 596, 249, 85, 249, 596, 596, 379, 150, 248, 85, 595, 595, 271, 248, 7, 248, 271, 271, 595, 96, 597, 150, 379, 379, 381, 597, 151, 597, 381, 381, 379, 33, 597, 151, 598, 598, 599, 597, 150, 597, 599, 599, 598, 152, 383, 39, 378, 378, 599, 383, 152, 383, 599, 599, 378, 150, 382, 152, 598, 598, 380, 382, 38, 382, 380, 380, 598, 151, 600, 95, 269, 269, 273, 600, 97, 600, 273, 273, 269, 11, 600, 97, 601, 601, 602, 600, 95, 600, 602, 602, 601, 152, 382, 38, 268, 268, 602, 382, 152, 382, 602, 602, 268, 95, 383, 152, 601, 601, 272, 383, 39, 383, 272, 272, 601, 97, 603, 94, 266, 266, 380, 603, 151, 603, 380, 380, 266, 38, 603, 151, 604, 604, 605, 603, 94, 603, 605, 605, 604, 84, 246, 6, 267, 267, 605, 246, 84, 246, 605, 605, 267, 94, 247, 84, 604, 604, 381, 247, 33, 247, 381, 381, 604, 151, 606, 153, 384, 384, 276, 606, 99, 606, 276, 276, 384, 40, 606, 99, 607, 607, 608, 606, 153, 606, 608, 608, 607, 87, 252, 34, 385, 385, 608, 252, 87, 252, 608, 608, 385, 153, 253, 87, 607, 607, 277, 253, 8, 253, 277, 277, 607, 99, 609, 153, 385, 385, 387, 609, 154, 609, 387, 387, 385, 34, 609, 154, 610, 610, 611, 609, 153, 609, 611, 611, 610, 155, 389, 40, 384, 384, 611, 389, 155, 389, 611, 611, 384, 153, 388, 155, 610, 610, 386, 388, 39, 388, 386, 386, 610, 154, 612, 97, 273, 273, 275, 612, 98, 612, 275, 275, 273, 11, 612, 98, 613, 613, 614, 612, 97, 612, 614, 614, 613, 155, 388, 39, 272, 272, 614, 388, 155, 388, 614, 614, 272, 97, 389, 155, 613, 613, 274, 389, 40, 389, 274, 274, 613, 98, 615, 96, 270, 270, 386, 615, 154, 615, 386, 386, 270, 39, 615, 154, 616, 616, 617, 615, 96, 615, 617, 617, 616, 86, 251, 7, 271, 271, 617, 251, 86, 251, 617, 617, 271, 96, 250, 86, 616, 616, 387, 250, 34, 250, 387, 387, 616, 154, 618, 156, 390, 390, 280, 618, 101, 618, 280, 280, 390, 41, 618, 101, 619, 619, 620, 618, 156, 618, 620, 620, 619, 89, 256, 35, 391, 391, 620, 256, 89, 256, 620, 620, 391, 156, 257, 89, 619, 619, 281, 257, 9, 257, 281, 281, 619, 101, 621, 156, 391, 391, 393, 621, 157, 621, 393, 393, 391, 35, 621, 157, 622, 622, 623, 621, 156, 621, 623, 623, 622, 158, 395, 41, 390, 390, 623, 395, 158, 395, 623, 623, 390, 156, 394, 158, 622, 622, 392, 394, 40, 394, 392, 392, 622, 157, 624, 98, 275, 275, 279, 624, 100, 624, 279, 279, 275, 11, 624, 100, 625, 625, 626, 624, 98, 624, 626, 626, 625, 158, 394, 40, 274, 274, 626, 394, 158, 394, 626, 626, 274, 98, 395, 158, 625, 625, 278, 395, 41, 395, 278, 278, 625, 100, 627, 99, 276, 276, 392, 627, 157, 627, 392, 392, 276, 40, 627, 157, 628, 628, 629, 627, 99, 627, 629, 629, 628, 88, 255, 8, 277, 277, 629, 255, 88, 255, 629, 629, 277, 99, 254, 88, 628, 628, 393, 254, 35, 254, 393, 393, 628, 157, 630, 159, 396, 396, 262, 630, 92, 630, 262, 262, 396, 37, 630, 92, 631, 631, 632, 630, 159, 630, 632, 632, 631, 90, 258, 36, 397, 397, 632, 258, 90, 258, 632, 632, 397, 159, 259, 90, 631, 631, 263, 259, 10, 259, 263, 263, 631, 92, 633, 159, 397, 397, 399, 633, 160, 633, 399, 399, 397, 36, 633, 160, 634, 634, 635, 633, 159, 633, 635, 635, 634, 161, 401, 37, 396, 396, 635, 401, 161, 401, 635, 635, 396, 159, 400, 161, 634, 634, 398, 400, 41, 400, 398, 398, 634, 160, 636, 100, 279, 279, 265, 636, 93, 636, 265, 265, 279, 11, 636, 93, 637, 637, 638, 636, 100, 636, 638, 638, 637, 161, 400, 41, 278, 278, 638, 400, 161, 400, 638, 638, 278, 100, 401, 161, 637, 637, 264, 401, 37, 401, 264, 264, 637, 93, 639, 101, 280, 280, 398, 639, 160, 639, 398, 398, 280, 41, 639, 160, 640, 640, 641, 639, 101, 639, 641, 641, 640, 91, 261, 9, 281, 281, 641, 261, 91, 261, 641, 641, 281, 101, 260, 91, 640, 640, 399, 260, 36, 260, 399, 399, 640, 160};
-GLuint ballIndexCount = 3840;
-GLuint ballNumVertices = 682;
-GLuint ballNumNormals = 682;
-GLuint ballNumTexCoords = 682;
-
-